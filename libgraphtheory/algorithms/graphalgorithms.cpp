@@ -0,0 +1,553 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "graphalgorithms.h"
+#include "graphsnapshot.h"
+
+#include <QPair>
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+using namespace GraphTheory;
+
+namespace {
+// 64 x 64 entries of doubles fill 32 KiB, such that three blocks fit into a typical L2 cache
+const int blockSize = 64;
+
+/**
+ * Relax all entries of matrix block (@p rowBlock, @p columnBlock) via the intermediate nodes of
+ * block @p pivotBlock. The innermost loop runs over contiguous memory to allow vectorization.
+ */
+void relaxBlock(qreal *matrix, int n, int rowBlock, int columnBlock, int pivotBlock)
+{
+    const qreal infinity = std::numeric_limits<qreal>::infinity();
+    const int rowEnd = qMin(n, (rowBlock + 1) * blockSize);
+    const int columnBegin = columnBlock * blockSize;
+    const int columnEnd = qMin(n, (columnBlock + 1) * blockSize);
+    const int pivotEnd = qMin(n, (pivotBlock + 1) * blockSize);
+    for (int k = pivotBlock * blockSize; k < pivotEnd; ++k) {
+        const qreal *pivotRow = matrix + qint64(k) * n;
+        for (int i = rowBlock * blockSize; i < rowEnd; ++i) {
+            qreal *row = matrix + qint64(i) * n;
+            const qreal distance = row[k];
+            if (distance == infinity) {
+                continue;
+            }
+            for (int j = columnBegin; j < columnEnd; ++j) {
+                const qreal candidate = distance + pivotRow[j];
+                row[j] = candidate < row[j] ? candidate : row[j];
+            }
+        }
+    }
+}
+}
+
+QVector<int> GraphAlgorithms::breadthFirstSearch(GraphSnapshotPtr graph, int start)
+{
+    QVector<int> order;
+    if (start < 0 || start >= graph->nodeCount()) {
+        return order;
+    }
+    const QVector<int> &offsets = graph->outOffsets();
+    const QVector<int> &targets = graph->targets();
+    QVector<bool> visited(graph->nodeCount(), false);
+
+    // the result vector itself serves as queue
+    order.reserve(graph->nodeCount());
+    order.append(start);
+    visited[start] = true;
+    for (int head = 0; head < order.count(); ++head) {
+        const int node = order.at(head);
+        for (int arc = offsets.at(node); arc < offsets.at(node + 1); ++arc) {
+            const int target = targets.at(arc);
+            if (!visited.at(target)) {
+                visited[target] = true;
+                order.append(target);
+            }
+        }
+    }
+    return order;
+}
+
+QVector<int> GraphAlgorithms::depthFirstSearch(GraphSnapshotPtr graph, int start)
+{
+    QVector<int> order;
+    if (start < 0 || start >= graph->nodeCount()) {
+        return order;
+    }
+    const QVector<int> &offsets = graph->outOffsets();
+    const QVector<int> &targets = graph->targets();
+    QVector<bool> visited(graph->nodeCount(), false);
+
+    // explicit stack of (node, next arc) pairs avoids recursion depth limits on long paths
+    QVector<QPair<int, int>> stack;
+    order.reserve(graph->nodeCount());
+    order.append(start);
+    visited[start] = true;
+    stack.append(qMakePair(start, offsets.at(start)));
+    while (!stack.isEmpty()) {
+        QPair<int, int> &top = stack.last();
+        if (top.second == offsets.at(top.first + 1)) {
+            stack.removeLast();
+            continue;
+        }
+        const int target = targets.at(top.second);
+        ++top.second;
+        if (!visited.at(target)) {
+            visited[target] = true;
+            order.append(target);
+            stack.append(qMakePair(target, offsets.at(target)));
+        }
+    }
+    return order;
+}
+
+QVector<qreal> GraphAlgorithms::shortestPathDistances(GraphSnapshotPtr graph, int source,
+                                                      const QVector<int> &targets, QVector<bool> *settled)
+{
+    const int n = graph->nodeCount();
+    if (source < 0 || source >= n) {
+        if (settled) {
+            settled->fill(true, n);
+        }
+        return QVector<qreal>(n, std::numeric_limits<qreal>::infinity());
+    }
+    bool negative = false;
+    foreach (qreal weight, graph->weights()) {
+        if (weight < 0) {
+            negative = true;
+            break;
+        }
+    }
+    if (negative) {
+        if (settled) {
+            settled->fill(true, n);
+        }
+        return bellmanFord(graph, source);
+    }
+    QVector<bool> dijkstraSettled;
+    const QVector<qreal> distances = dijkstra(graph, graph->weights(), source, targets, dijkstraSettled);
+    if (settled) {
+        *settled = dijkstraSettled;
+    }
+    return distances;
+}
+
+QVector<qreal> GraphAlgorithms::dijkstra(GraphSnapshotPtr graph, const QVector<qreal> &weights, int source,
+                                         const QVector<int> &targets, QVector<bool> &settled)
+{
+    const int n = graph->nodeCount();
+    QVector<qreal> distances(n, std::numeric_limits<qreal>::infinity());
+    settled.fill(false, n);
+    const QVector<int> &offsets = graph->outOffsets();
+    const QVector<int> &arcTargets = graph->targets();
+    const bool weighted = !weights.isEmpty();
+
+    // number of requested nodes that are not yet settled, duplicates are counted once
+    QVector<bool> requested(n, false);
+    int pending = 0;
+    foreach (int target, targets) {
+        if (target >= 0 && target < n && !requested.at(target)) {
+            requested[target] = true;
+            ++pending;
+        }
+    }
+
+    // binary heap with lazy deletion of outdated entries
+    typedef QPair<qreal, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    distances[source] = 0;
+    queue.push(qMakePair(qreal(0), source));
+    while (!queue.empty()) {
+        const Entry entry = queue.top();
+        queue.pop();
+        const int node = entry.second;
+        if (settled.at(node)) {
+            continue;
+        }
+        settled[node] = true;
+        if (requested.at(node) && --pending == 0) {
+            return distances;
+        }
+        for (int arc = offsets.at(node); arc < offsets.at(node + 1); ++arc) {
+            const qreal distance = entry.first + (weighted ? weights.at(arc) : 1);
+            const int target = arcTargets.at(arc);
+            if (distance < distances.at(target)) {
+                distances[target] = distance;
+                queue.push(qMakePair(distance, target));
+            }
+        }
+    }
+    // queue ran empty: all remaining nodes are unreachable and thus final, too
+    settled.fill(true);
+    return distances;
+}
+
+QVector<qreal> GraphAlgorithms::bellmanFord(GraphSnapshotPtr graph, int source)
+{
+    const int n = graph->nodeCount();
+    const qreal infinity = std::numeric_limits<qreal>::infinity();
+    QVector<qreal> distances(n, infinity);
+    const QVector<int> &offsets = graph->outOffsets();
+    const QVector<int> &targets = graph->targets();
+    const QVector<qreal> &weights = graph->weights();
+    if (source >= 0) {
+        distances[source] = 0;
+    } else {
+        // virtual source with zero length arcs to all nodes
+        distances.fill(0);
+    }
+
+    // relax all arcs until nothing changes, at most n - 1 rounds are needed without negative cycles
+    bool changed = true;
+    for (int round = 0; changed && round < n; ++round) {
+        changed = false;
+        for (int node = 0; node < n; ++node) {
+            if (distances.at(node) == infinity) {
+                continue;
+            }
+            for (int arc = offsets.at(node); arc < offsets.at(node + 1); ++arc) {
+                const qreal distance = distances.at(node) + weights.at(arc);
+                if (distance < distances.at(targets.at(arc))) {
+                    distances[targets.at(arc)] = distance;
+                    changed = true;
+                }
+            }
+        }
+    }
+    if (!changed) {
+        return distances;
+    }
+
+    // still relaxable arcs lie on or behind a negative cycle, mark everything reachable from them
+    QVector<int> queue;
+    for (int node = 0; node < n; ++node) {
+        if (distances.at(node) == infinity || distances.at(node) == -infinity) {
+            continue;
+        }
+        for (int arc = offsets.at(node); arc < offsets.at(node + 1); ++arc) {
+            const int target = targets.at(arc);
+            if (distances.at(target) != -infinity && distances.at(node) + weights.at(arc) < distances.at(target)) {
+                distances[target] = -infinity;
+                queue.append(target);
+            }
+        }
+    }
+    for (int head = 0; head < queue.count(); ++head) {
+        const int node = queue.at(head);
+        for (int arc = offsets.at(node); arc < offsets.at(node + 1); ++arc) {
+            const int target = targets.at(arc);
+            if (distances.at(target) != -infinity) {
+                distances[target] = -infinity;
+                queue.append(target);
+            }
+        }
+    }
+    return distances;
+}
+
+int GraphAlgorithms::maxDistanceMatrixNodes()
+{
+    // QVector allocates its header and elements in one block, whose size is an int
+    const qint64 maxEntries = (qint64(std::numeric_limits<int>::max()) - 64) / qint64(sizeof(qreal));
+    qint64 n = qint64(std::sqrt(qreal(maxEntries)));
+    while (n * n > maxEntries) {
+        --n;
+    }
+    return int(n);
+}
+
+QVector<qreal> GraphAlgorithms::distanceMatrix(GraphSnapshotPtr graph)
+{
+    const int n = graph->nodeCount();
+    QVector<qreal> matrix;
+    if (n == 0 || n > maxDistanceMatrixNodes()) {
+        return matrix;
+    }
+
+    // Johnson's algorithm costs about n * m * log(n) heap operations, Floyd-Warshall n^3 cheap
+    // vectorized operations; only prefer the former if the graph is clearly sparse
+    const qreal logN = std::log2(qreal(n) + 1);
+    if (qreal(graph->arcCount()) * logN * 4 < qreal(n) * n && johnson(graph, matrix)) {
+        return matrix;
+    }
+    floydWarshall(graph, matrix);
+    return matrix;
+}
+
+void GraphAlgorithms::floydWarshall(GraphSnapshotPtr graph, QVector<qreal> &matrix)
+{
+    const int n = graph->nodeCount();
+    const qreal infinity = std::numeric_limits<qreal>::infinity();
+    const QVector<int> &offsets = graph->outOffsets();
+    const QVector<int> &targets = graph->targets();
+    const QVector<qreal> &weights = graph->weights();
+    const bool weighted = !weights.isEmpty();
+
+    Q_ASSERT(n <= maxDistanceMatrixNodes());
+    matrix.fill(infinity, int(qint64(n) * n));
+    qreal *data = matrix.data();
+    for (int i = 0; i < n; ++i) {
+        data[qint64(i) * n + i] = 0;
+        for (int arc = offsets.at(i); arc < offsets.at(i + 1); ++arc) {
+            qreal &entry = data[qint64(i) * n + targets.at(arc)];
+            entry = qMin(entry, weighted ? weights.at(arc) : qreal(1));
+        }
+    }
+
+    // blocked Floyd-Warshall: for every pivot block, first the pivot block itself, then the blocks
+    // in its row and column, and finally all other blocks are relaxed; blocks within the last two
+    // phases are independent of each other and are processed in parallel
+    const int blocks = (n + blockSize - 1) / blockSize;
+    QVector<QPair<int, int>> crossBlocks;
+    QVector<QPair<int, int>> otherBlocks;
+    crossBlocks.reserve(2 * blocks);
+    otherBlocks.reserve(blocks * blocks);
+    for (int pivot = 0; pivot < blocks; ++pivot) {
+        relaxBlock(data, n, pivot, pivot, pivot);
+        crossBlocks.clear();
+        otherBlocks.clear();
+        for (int b = 0; b < blocks; ++b) {
+            if (b != pivot) {
+                crossBlocks.append(qMakePair(pivot, b));
+                crossBlocks.append(qMakePair(b, pivot));
+            }
+        }
+        for (int row = 0; row < blocks; ++row) {
+            for (int column = 0; column < blocks; ++column) {
+                if (row != pivot && column != pivot) {
+                    otherBlocks.append(qMakePair(row, column));
+                }
+            }
+        }
+        auto relax = [data, n, pivot](const QPair<int, int> &block) {
+            relaxBlock(data, n, block.first, block.second, pivot);
+        };
+        QtConcurrent::blockingMap(crossBlocks, relax);
+        QtConcurrent::blockingMap(otherBlocks, relax);
+    }
+
+    // pairs connected via a node on a negative cycle have no shortest path
+    for (int k = 0; k < n; ++k) {
+        if (data[qint64(k) * n + k] >= 0) {
+            continue;
+        }
+        for (int i = 0; i < n; ++i) {
+            if (data[qint64(i) * n + k] == infinity) {
+                continue;
+            }
+            for (int j = 0; j < n; ++j) {
+                if (data[qint64(k) * n + j] != infinity) {
+                    data[qint64(i) * n + j] = -infinity;
+                }
+            }
+        }
+    }
+}
+
+bool GraphAlgorithms::johnson(GraphSnapshotPtr graph, QVector<qreal> &matrix)
+{
+    const int n = graph->nodeCount();
+    const qreal infinity = std::numeric_limits<qreal>::infinity();
+    const QVector<int> &offsets = graph->outOffsets();
+    const QVector<int> &targets = graph->targets();
+    QVector<qreal> weights = graph->weights();
+
+    // node potentials make all arc lengths non-negative without changing shortest paths
+    QVector<qreal> potentials(n, 0);
+    bool negative = false;
+    foreach (qreal weight, weights) {
+        if (weight < 0) {
+            negative = true;
+            break;
+        }
+    }
+    if (negative) {
+        potentials = bellmanFord(graph, -1);
+        if (potentials.contains(-infinity)) {
+            return false;
+        }
+        for (int node = 0; node < n; ++node) {
+            for (int arc = offsets.at(node); arc < offsets.at(node + 1); ++arc) {
+                weights[arc] += potentials.at(node) - potentials.at(targets.at(arc));
+            }
+        }
+    }
+
+    Q_ASSERT(n <= maxDistanceMatrixNodes());
+    matrix.fill(infinity, int(qint64(n) * n));
+    qreal *data = matrix.data();
+    QVector<int> sources(n);
+    for (int i = 0; i < n; ++i) {
+        sources[i] = i;
+    }
+    QtConcurrent::blockingMap(sources, [&](int source) {
+        QVector<bool> settled;
+        const QVector<qreal> distances = dijkstra(graph, weights, source, QVector<int>(), settled);
+        qreal *row = data + qint64(source) * n;
+        for (int target = 0; target < n; ++target) {
+            if (distances.at(target) != infinity) {
+                row[target] = distances.at(target) - potentials.at(source) + potentials.at(target);
+            }
+        }
+    });
+    return true;
+}
+
+QVector<int> GraphAlgorithms::connectedComponents(GraphSnapshotPtr graph, int *count)
+{
+    const int n = graph->nodeCount();
+    const QVector<int> &outOffsets = graph->outOffsets();
+    const QVector<int> &targets = graph->targets();
+    const QVector<int> &inOffsets = graph->inOffsets();
+    const QVector<int> &sources = graph->sources();
+
+    QVector<int> components(n, -1);
+    QVector<int> queue;
+    queue.reserve(n);
+    int component = 0;
+    for (int start = 0; start < n; ++start) {
+        if (components.at(start) >= 0) {
+            continue;
+        }
+        queue.clear();
+        queue.append(start);
+        components[start] = component;
+        for (int head = 0; head < queue.count(); ++head) {
+            const int node = queue.at(head);
+            for (int arc = outOffsets.at(node); arc < outOffsets.at(node + 1); ++arc) {
+                const int neighbor = targets.at(arc);
+                if (components.at(neighbor) < 0) {
+                    components[neighbor] = component;
+                    queue.append(neighbor);
+                }
+            }
+            for (int arc = inOffsets.at(node); arc < inOffsets.at(node + 1); ++arc) {
+                const int neighbor = sources.at(arc);
+                if (components.at(neighbor) < 0) {
+                    components[neighbor] = component;
+                    queue.append(neighbor);
+                }
+            }
+        }
+        ++component;
+    }
+    if (count) {
+        *count = component;
+    }
+    return components;
+}
+
+QVector<int> GraphAlgorithms::minimumSpanningForest(GraphSnapshotPtr graph, qreal *weight)
+{
+    const int n = graph->nodeCount();
+    const int m = graph->arcCount();
+    const QVector<int> &offsets = graph->outOffsets();
+    const QVector<int> &targets = graph->targets();
+    const QVector<qreal> &weights = graph->weights();
+    const bool weighted = !weights.isEmpty();
+
+    QVector<int> sources(m);
+    QVector<int> order(m);
+    for (int node = 0; node < n; ++node) {
+        for (int arc = offsets.at(node); arc < offsets.at(node + 1); ++arc) {
+            sources[arc] = node;
+        }
+    }
+    for (int arc = 0; arc < m; ++arc) {
+        order[arc] = arc;
+    }
+    if (weighted) {
+        std::stable_sort(order.begin(), order.end(), [&weights](int a, int b) {
+            return weights.at(a) < weights.at(b);
+        });
+    }
+
+    // union-find with union by size and path halving
+    QVector<int> parent(n);
+    QVector<int> size(n, 1);
+    for (int node = 0; node < n; ++node) {
+        parent[node] = node;
+    }
+    auto find = [&parent](int node) {
+        while (parent.at(node) != node) {
+            parent[node] = parent.at(parent.at(node));
+            node = parent.at(node);
+        }
+        return node;
+    };
+
+    QVector<int> forest;
+    qreal total = 0;
+    foreach (int arc, order) {
+        int a = find(sources.at(arc));
+        int b = find(targets.at(arc));
+        if (a == b) {
+            continue;
+        }
+        if (size.at(a) < size.at(b)) {
+            qSwap(a, b);
+        }
+        parent[b] = a;
+        size[a] += size.at(b);
+        forest.append(arc);
+        total += weighted ? weights.at(arc) : 1;
+        if (forest.count() == n - 1) {
+            break;
+        }
+    }
+    if (weight) {
+        *weight = total;
+    }
+    return forest;
+}
+
+bool GraphAlgorithms::topologicalSort(GraphSnapshotPtr graph, QVector<int> &order)
+{
+    const int n = graph->nodeCount();
+    const QVector<int> &outOffsets = graph->outOffsets();
+    const QVector<int> &targets = graph->targets();
+    const QVector<int> &inOffsets = graph->inOffsets();
+
+    QVector<int> inDegree(n);
+    order.clear();
+    order.reserve(n);
+    for (int node = 0; node < n; ++node) {
+        inDegree[node] = inOffsets.at(node + 1) - inOffsets.at(node);
+        if (inDegree.at(node) == 0) {
+            order.append(node);
+        }
+    }
+    for (int head = 0; head < order.count(); ++head) {
+        const int node = order.at(head);
+        for (int arc = outOffsets.at(node); arc < outOffsets.at(node + 1); ++arc) {
+            const int target = targets.at(arc);
+            if (--inDegree[target] == 0) {
+                order.append(target);
+            }
+        }
+    }
+    return order.count() == n;
+}
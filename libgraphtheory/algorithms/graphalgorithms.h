@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GRAPHALGORITHMS_H
+#define GRAPHALGORITHMS_H
+
+#include "graphtheory_export.h"
+#include "typenames.h"
+
+#include <QVector>
+
+namespace GraphTheory
+{
+
+/** \brief this class provides native implementations of common graph algorithms
+ *
+ * All algorithms operate on a GraphSnapshot and identify nodes by their dense snapshot index,
+ * i.e., by their position in GraphDocument::nodes() at the time the snapshot was created.
+ * Arcs are followed in their direction; to consider a graph as undirected, use bidirectional
+ * edge types.
+ */
+class GRAPHTHEORY_EXPORT GraphAlgorithms
+{
+public:
+    /** \brief breadth-first search
+     *
+     * \param graph the graph structure
+     * \param start index of the start node
+     * \return indices of all nodes reachable from @p start in the order they were discovered
+     */
+    static QVector<int> breadthFirstSearch(GraphSnapshotPtr graph, int start);
+
+    /** \brief depth-first search
+     *
+     * Outgoing arcs of a node are explored in the order given by the snapshot.
+     * \param graph the graph structure
+     * \param start index of the start node
+     * \return indices of all nodes reachable from @p start in pre-order
+     */
+    static QVector<int> depthFirstSearch(GraphSnapshotPtr graph, int start);
+
+    /** \brief single source shortest paths
+     *
+     * Arc lengths are given by the snapshot weights, or are 1 if the snapshot has no weight
+     * property. If all arc lengths are non-negative, Dijkstra's algorithm is used, which stops as
+     * soon as all @p targets are settled. Otherwise the Bellman-Ford algorithm is used; nodes
+     * that can be reached via a cycle of negative length get distance minus infinity.
+     * \param graph the graph structure
+     * \param source index of the source node
+     * \param targets indices of the nodes whose distance is requested, all nodes if empty
+     * \param settled if given, set to a vector that tells for every node whether its distance
+     *                is final; this holds at least for all @p targets
+     * \return distance from @p source to every node, unreachable nodes have infinite distance
+     */
+    static QVector<qreal> shortestPathDistances(GraphSnapshotPtr graph, int source,
+                                                const QVector<int> &targets = QVector<int>(),
+                                                QVector<bool> *settled = nullptr);
+
+    /** \brief all pairs shortest paths
+     *
+     * Arc lengths are given as for shortestPathDistances(). For sparse graphs, Johnson's algorithm
+     * is used, i.e., Dijkstra's algorithm is run from every node after the arc lengths were made
+     * non-negative by node potentials. For dense graphs and graphs with cycles of negative length,
+     * a cache-blocked Floyd-Warshall algorithm is used. Both run in parallel on the global thread
+     * pool. Distances of node pairs that are connected via a cycle of negative length are minus
+     * infinity.
+     * \param graph the graph structure
+     * \return row-major matrix with nodeCount() * nodeCount() entries, where entry i * nodeCount() + j
+     *         is the distance from node i to node j; empty if the graph has more than
+     *         maxDistanceMatrixNodes() nodes
+     */
+    static QVector<qreal> distanceMatrix(GraphSnapshotPtr graph);
+
+    /**
+     * \return largest number of nodes for which distanceMatrix() can be computed, which is
+     *         limited by the maximal size of a QVector
+     */
+    static int maxDistanceMatrixNodes();
+
+    /** \brief connected components
+     *
+     * Arc directions are ignored, i.e., the weakly connected components are computed.
+     * Components are numbered by the order of their smallest node index.
+     * \param graph the graph structure
+     * \param count if given, set to the number of components
+     * \return component number for every node
+     */
+    static QVector<int> connectedComponents(GraphSnapshotPtr graph, int *count = nullptr);
+
+    /** \brief minimum spanning forest by Kruskal's algorithm
+     *
+     * Arc directions are ignored and arc lengths are given as for shortestPathDistances(). If the
+     * graph is not connected, a minimum spanning tree for every connected component is computed.
+     * \param graph the graph structure
+     * \param weight if given, set to the total length of the forest
+     * \return indices of the arcs that form the forest, at most one per edge
+     */
+    static QVector<int> minimumSpanningForest(GraphSnapshotPtr graph, qreal *weight = nullptr);
+
+    /** \brief topological sorting by Kahn's algorithm
+     *
+     * \param graph the graph structure
+     * \param order set to the node indices in topological order
+     * \return true if the graph is acyclic, otherwise false and @p order is undefined
+     */
+    static bool topologicalSort(GraphSnapshotPtr graph, QVector<int> &order);
+
+private:
+    /** Dijkstra's algorithm with arc lengths @p weights, or 1 if empty **/
+    static QVector<qreal> dijkstra(GraphSnapshotPtr graph, const QVector<qreal> &weights, int source,
+                                   const QVector<int> &targets, QVector<bool> &settled);
+    /** Bellman-Ford algorithm, a negative @p source denotes a virtual source connected to all nodes **/
+    static QVector<qreal> bellmanFord(GraphSnapshotPtr graph, int source);
+    static void floydWarshall(GraphSnapshotPtr graph, QVector<qreal> &matrix);
+    static bool johnson(GraphSnapshotPtr graph, QVector<qreal> &matrix);
+};
+}
+
+#endif
@@ -0,0 +1,373 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_algorithms.h"
+#include "libgraphtheory/algorithms/graphalgorithms.h"
+#include "libgraphtheory/kernel/kernel.h"
+#include "libgraphtheory/graphdocument.h"
+#include "libgraphtheory/graphsnapshot.h"
+#include "libgraphtheory/edgetype.h"
+#include "libgraphtheory/node.h"
+#include "libgraphtheory/edge.h"
+
+#include <QSignalSpy>
+#include <QTest>
+#include <limits>
+
+using namespace GraphTheory;
+
+void TestAlgorithms::initTestCase()
+{
+    QVERIFY(GraphDocument::objects() == 0);
+    QVERIFY(Node::objects() == 0);
+    QVERIFY(Edge::objects() == 0);
+}
+
+void TestAlgorithms::cleanupTestCase()
+{
+    QVERIFY(GraphDocument::objects() == 0);
+    QVERIFY(Node::objects() == 0);
+    QVERIFY(Edge::objects() == 0);
+}
+
+void TestAlgorithms::graphAlgorithms()
+{
+    // diamond a->b->d, a->c->d and isolated node e
+    GraphDocumentPtr document = GraphDocument::create();
+    document->edgeTypes().first()->setDirection(EdgeType::Unidirectional);
+    document->edgeTypes().first()->addDynamicProperty("length");
+    NodePtr a = Node::create(document);
+    NodePtr b = Node::create(document);
+    NodePtr c = Node::create(document);
+    NodePtr d = Node::create(document);
+    NodePtr e = Node::create(document);
+    Edge::create(a, b)->setDynamicProperty("length", 5);
+    Edge::create(a, c)->setDynamicProperty("length", 1);
+    Edge::create(b, d)->setDynamicProperty("length", 1);
+    Edge::create(c, d)->setDynamicProperty("length", 1);
+
+    GraphSnapshotPtr graph = document->snapshot();
+    QCOMPARE(GraphAlgorithms::breadthFirstSearch(graph, a->documentIndex()),
+             QVector<int>() << a->documentIndex() << b->documentIndex() << c->documentIndex() << d->documentIndex());
+    QCOMPARE(GraphAlgorithms::depthFirstSearch(graph, a->documentIndex()),
+             QVector<int>() << a->documentIndex() << b->documentIndex() << d->documentIndex() << c->documentIndex());
+    QCOMPARE(GraphAlgorithms::breadthFirstSearch(graph, e->documentIndex()).count(), 1);
+
+    // shortest paths prefer the lighter path over c
+    QVector<qreal> distances = GraphAlgorithms::shortestPathDistances(document->snapshot(EdgeTypePtr(), "length"), a->documentIndex());
+    QCOMPARE(distances.at(b->documentIndex()), qreal(5));
+    QCOMPARE(distances.at(d->documentIndex()), qreal(2));
+    QCOMPARE(distances.at(e->documentIndex()), std::numeric_limits<qreal>::infinity());
+
+    int count = 0;
+    QVector<int> components = GraphAlgorithms::connectedComponents(graph, &count);
+    QCOMPARE(count, 2);
+    QCOMPARE(components.at(a->documentIndex()), components.at(d->documentIndex()));
+    QVERIFY(components.at(a->documentIndex()) != components.at(e->documentIndex()));
+
+    QVector<int> order;
+    QVERIFY(GraphAlgorithms::topologicalSort(graph, order));
+    QCOMPARE(order.count(), 5);
+    QVERIFY(order.indexOf(a->documentIndex()) < order.indexOf(b->documentIndex()));
+    QVERIFY(order.indexOf(b->documentIndex()) < order.indexOf(d->documentIndex()));
+    Edge::create(d, a);
+    QVERIFY(!GraphAlgorithms::topologicalSort(document->snapshot(), order));
+
+    document->destroy();
+}
+
+void TestAlgorithms::shortestPaths()
+{
+    // path a->b->c->d
+    GraphDocumentPtr document = GraphDocument::create();
+    document->edgeTypes().first()->setDirection(EdgeType::Unidirectional);
+    document->edgeTypes().first()->addDynamicProperty("length");
+    NodePtr a = Node::create(document);
+    NodePtr b = Node::create(document);
+    NodePtr c = Node::create(document);
+    NodePtr d = Node::create(document);
+    Edge::create(a, b)->setDynamicProperty("length", 2);
+    EdgePtr edgeBC = Edge::create(b, c);
+    edgeBC->setDynamicProperty("length", 3);
+    EdgePtr edgeCD = Edge::create(c, d);
+    edgeCD->setDynamicProperty("length", 4);
+
+    // search stops once the target is settled
+    QVector<bool> settled;
+    GraphSnapshotPtr graph = document->snapshot(EdgeTypePtr(), "length");
+    QVector<qreal> distances = GraphAlgorithms::shortestPathDistances(graph, a->documentIndex(),
+        QVector<int>() << b->documentIndex(), &settled);
+    QCOMPARE(distances.at(b->documentIndex()), qreal(2));
+    QVERIFY(settled.at(b->documentIndex()));
+    QVERIFY(!settled.at(d->documentIndex()));
+
+    // negative lengths
+    edgeBC->setDynamicProperty("length", -1);
+    graph = document->snapshot(EdgeTypePtr(), "length");
+    distances = GraphAlgorithms::shortestPathDistances(graph, a->documentIndex(), QVector<int>(), &settled);
+    QCOMPARE(distances.at(c->documentIndex()), qreal(1));
+    QCOMPARE(distances.at(d->documentIndex()), qreal(5));
+    QVERIFY(!settled.contains(false));
+
+    // negative cycle c->b->c makes c and everything behind it unbounded
+    Edge::create(c, b)->setDynamicProperty("length", -1);
+    graph = document->snapshot(EdgeTypePtr(), "length");
+    distances = GraphAlgorithms::shortestPathDistances(graph, a->documentIndex());
+    QCOMPARE(distances.at(a->documentIndex()), qreal(0));
+    QCOMPARE(distances.at(c->documentIndex()), -std::numeric_limits<qreal>::infinity());
+    QCOMPARE(distances.at(d->documentIndex()), -std::numeric_limits<qreal>::infinity());
+
+    // script access reuses cached results until edge lengths change
+    edgeCD->setDynamicProperty("length", 7);
+    Kernel kernel;
+    QScriptValue result = kernel.execute(document, QString(
+        "var a = Document.node(%1);"
+        "var first = a.distance(\"length\", [Document.node(%2)])[0];"
+        "var second = a.distance(\"length\", [Document.node(%2)])[0];"
+        "Document.edges()[3].length = 1;" // removes negative cycle
+        "first + \":\" + second + \":\" + a.distance(\"length\", [Document.node(%2)])[0];")
+        .arg(a->id()).arg(b->id()));
+    QCOMPARE(result.toString(), QString("-Infinity:-Infinity:2"));
+
+    document->destroy();
+}
+
+void TestAlgorithms::distanceMatrix_data()
+{
+    QTest::addColumn<int>("nodes");
+    QTest::addColumn<int>("edges");
+    QTest::addColumn<bool>("negative");
+    // sparse graphs are handled by Johnson's algorithm, dense ones by Floyd-Warshall
+    QTest::newRow("sparse") << 200 << 400 << false;
+    QTest::newRow("sparse negative") << 200 << 400 << true;
+    QTest::newRow("dense") << 100 << 3000 << false;
+    QTest::newRow("dense negative") << 100 << 3000 << true;
+}
+
+void TestAlgorithms::distanceMatrix()
+{
+    QFETCH(int, nodes);
+    QFETCH(int, edges);
+    QFETCH(bool, negative);
+
+    // random graph with integral lengths; graphs with negative lengths are acyclic to avoid
+    // negative cycles
+    qsrand(42);
+    GraphDocumentPtr document = GraphDocument::create();
+    document->edgeTypes().first()->setDirection(EdgeType::Unidirectional);
+    document->edgeTypes().first()->addDynamicProperty("length");
+    for (int i = 0; i < nodes; ++i) {
+        Node::create(document);
+    }
+    const NodeList nodeList = document->nodes();
+    for (int i = 0; i < edges; ++i) {
+        int from = qrand() % nodes;
+        int to = qrand() % nodes;
+        int length = qrand() % 10 + 1;
+        if (negative) {
+            if (from == to) {
+                continue;
+            }
+            if (from > to) {
+                qSwap(from, to);
+            }
+            if (qrand() % 2 == 0) {
+                length = -length;
+            }
+        }
+        Edge::create(nodeList.at(from), nodeList.at(to))->setDynamicProperty("length", length);
+    }
+
+    GraphSnapshotPtr graph = document->snapshot(EdgeTypePtr(), "length");
+    const QVector<qreal> matrix = GraphAlgorithms::distanceMatrix(graph);
+    QCOMPARE(matrix.count(), nodes * nodes);
+    for (int source = 0; source < nodes; ++source) {
+        const QVector<qreal> distances = GraphAlgorithms::shortestPathDistances(graph, source);
+        for (int target = 0; target < nodes; ++target) {
+            QCOMPARE(matrix.at(source * nodes + target), distances.at(target));
+        }
+    }
+
+    // script access
+    Kernel kernel;
+    QScriptValue result = kernel.execute(document, "Document.distanceMatrix(\"length\")[1][2];");
+    QCOMPARE(result.toNumber(), matrix.at(nodes + 2));
+
+    document->destroy();
+}
+
+void TestAlgorithms::distanceMatrixLimit()
+{
+    const int maxNodes = GraphAlgorithms::maxDistanceMatrixNodes();
+    QVERIFY(maxNodes > 16000);
+    QVERIFY(qint64(maxNodes) * maxNodes * qint64(sizeof(qreal)) < qint64(std::numeric_limits<int>::max()));
+
+    // larger graphs are rejected instead of allocating the matrix
+    GraphDocumentPtr document = GraphDocument::create();
+    for (int i = 0; i <= maxNodes; ++i) {
+        Node::create(document);
+    }
+    QVERIFY(GraphAlgorithms::distanceMatrix(document->snapshot()).isEmpty());
+
+    Kernel kernel;
+    QSignalSpy spy(&kernel, SIGNAL(message(QString,GraphTheory::Kernel::MessageType)));
+    QScriptValue result = kernel.execute(document, "Document.distanceMatrix(\"length\").length;");
+    QCOMPARE(result.toInteger(), qreal(0));
+    bool reported = false;
+    for (const auto &arguments : spy) {
+        if (arguments.at(1).value<Kernel::MessageType>() == Kernel::ErrorMessage
+            && arguments.at(0).toString().contains("limited to")) {
+            reported = true;
+        }
+    }
+    QVERIFY(reported);
+
+    document->destroy();
+}
+
+void TestAlgorithms::spanningTree()
+{
+    // triangle a, b, c with heavy edge ab, separate component d-e and an edge of another type
+    GraphDocumentPtr document = GraphDocument::create();
+    EdgeTypePtr type = document->edgeTypes().first();
+    type->setDirection(EdgeType::Unidirectional);
+    type->addDynamicProperty("weight");
+    EdgeTypePtr otherType = EdgeType::create(document);
+    NodePtr a = Node::create(document);
+    NodePtr b = Node::create(document);
+    NodePtr c = Node::create(document);
+    NodePtr d = Node::create(document);
+    NodePtr e = Node::create(document);
+    EdgePtr edgeAB = Edge::create(a, b);
+    edgeAB->setDynamicProperty("weight", 10);
+    Edge::create(c, b)->setDynamicProperty("weight", 2);
+    Edge::create(a, c)->setDynamicProperty("weight", 3);
+    Edge::create(d, e)->setDynamicProperty("weight", 4);
+    Edge::create(b, d)->setType(otherType);
+
+    qreal weight = 0;
+    GraphSnapshotPtr graph = document->snapshot(type, "weight");
+    QVector<int> forest = GraphAlgorithms::minimumSpanningForest(graph, &weight);
+    QCOMPARE(forest.count(), 3);
+    QCOMPARE(weight, qreal(9));
+    foreach (int arc, forest) {
+        QVERIFY(graph->edge(arc) != edgeAB);
+    }
+
+    // all edges connect both components
+    forest = GraphAlgorithms::minimumSpanningForest(document->snapshot(EdgeTypePtr(), "weight"), &weight);
+    QCOMPARE(forest.count(), 4);
+    QCOMPARE(weight, qreal(10));
+
+    Kernel kernel;
+    QScriptValue result = kernel.execute(document, QString("Algorithms.spanningTree(\"weight\", %1).length;").arg(type->id()));
+    QCOMPARE(result.toInteger(), qreal(3));
+
+    document->destroy();
+}
+
+void TestAlgorithms::algorithmsModule()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->edgeTypes().first()->setDirection(EdgeType::Unidirectional);
+    NodePtr a = Node::create(document);
+    NodePtr b = Node::create(document);
+    NodePtr c = Node::create(document);
+    Node::create(document);
+    Edge::create(a, b);
+    Edge::create(b, c);
+
+    Kernel kernel;
+    QScriptValue result;
+    result = kernel.execute(document, QString("Algorithms.bfs(Document.node(%1)).length;").arg(a->id()));
+    QCOMPARE(result.toInteger(), qreal(3));
+    result = kernel.execute(document, QString("Algorithms.dfs(Document.node(%1))[2].id;").arg(a->id()));
+    QCOMPARE(result.toInteger(), qreal(c->id()));
+    result = kernel.execute(document, QString("Algorithms.distances(Document.node(%1), \"length\")[%2];")
+        .arg(a->id()).arg(c->documentIndex()));
+    QCOMPARE(result.toInteger(), qreal(2));
+    result = kernel.execute(document, "Algorithms.components().length;");
+    QCOMPARE(result.toInteger(), qreal(2));
+    result = kernel.execute(document, "Algorithms.topologicalSort().length;");
+    QCOMPARE(result.toInteger(), qreal(4));
+    Edge::create(c, a);
+    result = kernel.execute(document, "Algorithms.topologicalSort().length;");
+    QCOMPARE(result.toInteger(), qreal(0));
+
+    document->destroy();
+}
+
+void TestAlgorithms::benchmarkBreadthFirstSearch_data()
+{
+    QTest::addColumn<QString>("script");
+    QTest::newRow("native") << QString("Algorithms.bfs(Document.nodes()[0]).length;");
+    QTest::newRow("script") << QString(
+        "var start = Document.nodes()[0];"
+        "var visited = {};"
+        "var queue = [start];"
+        "var count = 0;"
+        "visited[start.id] = true;"
+        "while (queue.length > 0) {"
+        "    var node = queue.shift();"
+        "    ++count;"
+        "    var successors = node.successors();"
+        "    for (var i = 0; i < successors.length; ++i) {"
+        "        if (!visited[successors[i].id]) {"
+        "            visited[successors[i].id] = true;"
+        "            queue.push(successors[i]);"
+        "        }"
+        "    }"
+        "}"
+        "count;");
+}
+
+void TestAlgorithms::benchmarkBreadthFirstSearch()
+{
+    QFETCH(QString, script);
+
+    // grid graph with 40x40 nodes
+    const int size = 40;
+    GraphDocumentPtr document = GraphDocument::create();
+    NodeList nodes;
+    for (int i = 0; i < size * size; ++i) {
+        nodes.append(Node::create(document));
+    }
+    for (int row = 0; row < size; ++row) {
+        for (int column = 0; column < size; ++column) {
+            if (column + 1 < size) {
+                Edge::create(nodes.at(row * size + column), nodes.at(row * size + column + 1));
+            }
+            if (row + 1 < size) {
+                Edge::create(nodes.at(row * size + column), nodes.at((row + 1) * size + column));
+            }
+        }
+    }
+
+    Kernel kernel;
+    QScriptValue result;
+    QBENCHMARK {
+        result = kernel.execute(document, script);
+    }
+    QCOMPARE(result.toInteger(), qreal(size * size));
+
+    document->destroy();
+}
+
+QTEST_MAIN(TestAlgorithms)
@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_ALGORITHMS_H
+#define TEST_ALGORITHMS_H
+
+#include <QObject>
+
+class TestAlgorithms : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    /** test native traversal, shortest path, component and sorting algorithms **/
+    void graphAlgorithms();
+    /** test shortest path computation with early termination and negative edge lengths **/
+    void shortestPaths();
+    /** test all pairs shortest paths against single source shortest paths **/
+    void distanceMatrix_data();
+    void distanceMatrix();
+    void distanceMatrixLimit();
+    /** test minimum spanning forest computation **/
+    void spanningTree();
+    /** test script access to the Algorithms module **/
+    void algorithmsModule();
+    /** compare native breadth-first search with an equivalent script implementation **/
+    void benchmarkBreadthFirstSearch_data();
+    void benchmarkBreadthFirstSearch();
+};
+
+#endif
@@ -24,8 +24,10 @@
 #include "libgraphtheory/edgetype.h"
 #include "libgraphtheory/node.h"
 #include "libgraphtheory/edge.h"
+#include "libgraphtheory/graphsnapshot.h"
 
 #include <QTest>
+#include <QSignalSpy>
 
 void TestGraphOperations::initTestCase()
 {
@@ -199,6 +201,27 @@ void TestGraphOperations::testNodeDynamicProperties()
     node->type()->removeDynamicProperty("property");
     QCOMPARE(node->dynamicProperty("property").isValid(), false);
 
+    // test slot based access and slot update after removal of preceding property
+    NodeTypePtr type = node->type();
+    type->addDynamicProperty("a");
+    type->addDynamicProperty("b");
+    QCOMPARE(type->dynamicPropertyIndex("a"), 0);
+    QCOMPARE(type->dynamicPropertyIndex("b"), 1);
+    QCOMPARE(type->dynamicPropertyIndex("unknown"), -1);
+    node->setDynamicProperty(type->dynamicPropertyIndex("b"), 42.5);
+    QCOMPARE(node->dynamicProperty("b").toDouble(), 42.5);
+    type->removeDynamicProperty("a");
+    QCOMPARE(type->dynamicPropertyIndex("b"), 0);
+    QCOMPARE(node->dynamicProperty(0).toDouble(), 42.5);
+
+    // test values are moved to slots of new type by property name
+    NodeTypePtr otherType = NodeType::create(document);
+    otherType->addDynamicProperty("c");
+    otherType->addDynamicProperty("b");
+    node->setType(otherType);
+    QCOMPARE(node->dynamicProperty("b").toDouble(), 42.5);
+    QCOMPARE(node->dynamicProperty("c").isValid(), false);
+
     document->destroy();
 }
 
@@ -396,4 +419,247 @@ void TestGraphOperations::testDynamicPropertyRename()
     document->destroy();
 }
 
+void TestGraphOperations::testDocumentIndices()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    NodePtr nodeD = Node::create(document);
+    EdgePtr edgeAB = Edge::create(nodeA, nodeB);
+    EdgePtr edgeBC = Edge::create(nodeB, nodeC);
+    EdgePtr edgeCD = Edge::create(nodeC, nodeD);
+
+    for (int i = 0; i < document->nodes().length(); ++i) {
+        QCOMPARE(document->nodes().at(i)->documentIndex(), i);
+    }
+    for (int i = 0; i < document->edges().length(); ++i) {
+        QCOMPARE(document->edges().at(i)->documentIndex(), i);
+    }
+
+    // inserting already contained elements must not change anything
+    document->insert(nodeA);
+    document->insert(edgeAB);
+    QCOMPARE(document->nodes().length(), 4);
+    QCOMPARE(document->edges().length(), 3);
+
+    // removal from the middle moves last element into the gap
+    edgeAB->destroy();
+    QCOMPARE(edgeAB->documentIndex(), -1);
+    QCOMPARE(document->edges().length(), 2);
+    QCOMPARE(document->edges().at(0), edgeCD);
+    QCOMPARE(edgeCD->documentIndex(), 0);
+    QCOMPARE(edgeBC->documentIndex(), 1);
+
+    nodeB->destroy();
+    QCOMPARE(nodeB->documentIndex(), -1);
+    QCOMPARE(document->nodes().length(), 3);
+    QCOMPARE(document->nodes().at(1), nodeD);
+    QCOMPARE(document->edges().length(), 1);
+    for (int i = 0; i < document->nodes().length(); ++i) {
+        QCOMPARE(document->nodes().at(i)->documentIndex(), i);
+    }
+    QCOMPARE(document->edges().at(0)->documentIndex(), 0);
+
+    document->destroy();
+}
+
+void TestGraphOperations::testIdentifierLookup()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodeTypePtr nodeType = NodeType::create(document);
+    EdgeTypePtr edgeType = EdgeType::create(document);
+
+    QCOMPARE(document->node(nodeA->id()), nodeA);
+    QCOMPARE(document->node(nodeB->id()), nodeB);
+    QCOMPARE(document->nodeType(nodeType->id()), nodeType);
+    QCOMPARE(document->edgeType(edgeType->id()), edgeType);
+    QVERIFY(!document->node(-1));
+
+    // changed identifiers must be reflected by lookup
+    const int oldId = nodeA->id();
+    nodeA->setId(4242);
+    QCOMPARE(document->node(4242), nodeA);
+    QVERIFY(!document->node(oldId));
+    nodeType->setId(4243);
+    QCOMPARE(document->nodeType(4243), nodeType);
+    edgeType->setId(4244);
+    QCOMPARE(document->edgeType(4244), edgeType);
+
+    // removed elements must not be found anymore
+    nodeA->destroy();
+    QVERIFY(!document->node(4242));
+    edgeType->destroy();
+    QVERIFY(!document->edgeType(4244));
+
+    document->destroy();
+}
+
+void TestGraphOperations::testBulkUpdate()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    QSignalSpy nodeAddedSpy(document.data(), &GraphDocument::nodeAdded);
+    QSignalSpy edgeAddedSpy(document.data(), &GraphDocument::edgeAdded);
+    QSignalSpy nodesRemovedSpy(document.data(), &GraphDocument::nodesRemoved);
+    QSignalSpy beginSpy(document.data(), &GraphDocument::bulkUpdateAboutToBegin);
+    QSignalSpy finishedSpy(document.data(), &GraphDocument::bulkUpdateFinished);
+
+    {
+        GraphDocument::BulkUpdateGuard outer(document);
+        GraphDocument::BulkUpdateGuard inner(document);
+        QVERIFY(document->isBulkUpdate());
+        NodePtr from = Node::create(document);
+        NodePtr to = Node::create(document);
+        NodePtr removed = Node::create(document);
+        Edge::create(from, to);
+        removed->destroy();
+        QCOMPARE(beginSpy.count(), 1);
+        QCOMPARE(finishedSpy.count(), 0);
+    }
+    QVERIFY(!document->isBulkUpdate());
+    QCOMPARE(beginSpy.count(), 1);
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(nodeAddedSpy.count(), 0);
+    QCOMPARE(edgeAddedSpy.count(), 0);
+    QCOMPARE(nodesRemovedSpy.count(), 0);
+    QCOMPARE(document->nodes().count(), 2);
+    QCOMPARE(document->edges().count(), 1);
+
+    // outside of bulk updates per element signals are emitted again
+    Node::create(document);
+    QCOMPARE(nodeAddedSpy.count(), 1);
+
+    document->destroy();
+}
+
+void TestGraphOperations::testNodePositions()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    nodeA->setX(10);
+    nodeA->setY(20);
+    nodeC->setColor(Qt::red);
+    QCOMPARE(document->nodePositions().at(0), QPointF(10, 20));
+    QCOMPARE(document->nodeColors().at(2), QColor(Qt::red));
+
+    // bulk update of positions emits only a single signal
+    QSignalSpy nodeSpy(nodeB.data(), &Node::positionChanged);
+    QSignalSpy documentSpy(document.data(), &GraphDocument::nodePositionsChanged);
+    QVector<QPointF> positions;
+    positions << QPointF(1, 2) << QPointF(3, 4) << QPointF(5, 6);
+    document->setNodePositions(positions);
+    QCOMPARE(nodeSpy.count(), 0);
+    QCOMPARE(documentSpy.count(), 1);
+    QCOMPARE(nodeB->x(), qreal(3));
+    QCOMPARE(nodeB->y(), qreal(4));
+
+    // buffers follow node removal and nodes keep their values
+    nodeA->destroy();
+    QCOMPARE(nodeA->x(), qreal(1));
+    QCOMPARE(nodeA->y(), qreal(2));
+    QCOMPARE(document->nodePositions().count(), 2);
+    QCOMPARE(nodeC->x(), qreal(5));
+    QCOMPARE(nodeC->color(), QColor(Qt::red));
+    QCOMPARE(document->nodePositions().at(nodeC->documentIndex()), QPointF(5, 6));
+
+    document->destroy();
+}
+
+void TestGraphOperations::testPropertyColumns()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("dist");
+    NodeTypePtr otherType = NodeType::create(document);
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    nodeC->setType(otherType);
+
+    // a single value is assigned to all nodes with only one signal
+    QSignalSpy nodeSpy(nodeA.data(), &Node::dynamicPropertyChanged);
+    QSignalSpy documentSpy(document.data(), &GraphDocument::nodePropertiesChanged);
+    document->setNodeProperties(document->nodes(), "dist", QVector<QVariant>() << 5);
+    QCOMPARE(nodeSpy.count(), 0);
+    QCOMPARE(documentSpy.count(), 1);
+    QCOMPARE(documentSpy.first().at(0).toString(), QString("dist"));
+    QCOMPARE(nodeA->dynamicProperty("dist").toInt(), 5);
+    QCOMPARE(nodeB->dynamicProperty("dist").toInt(), 5);
+    QVERIFY(!nodeC->dynamicProperty("dist").isValid());
+
+    // one value per node
+    document->setNodeProperties(NodeList() << nodeB << nodeA, "dist", QVector<QVariant>() << 1 << 2);
+    QCOMPARE(nodeA->dynamicProperty("dist").toInt(), 2);
+    QCOMPARE(nodeB->dynamicProperty("dist").toInt(), 1);
+
+    // edge properties invalidate snapshots
+    document->edgeTypes().first()->addDynamicProperty("weight");
+    EdgePtr edge = Edge::create(nodeA, nodeB);
+    GraphSnapshotPtr snapshot = document->snapshot(EdgeTypePtr(), "weight");
+    QSignalSpy edgeDocumentSpy(document.data(), &GraphDocument::edgePropertiesChanged);
+    document->setEdgeProperties(document->edges(), "weight", QVector<QVariant>() << 3);
+    QCOMPARE(edgeDocumentSpy.count(), 1);
+    QCOMPARE(edge->dynamicProperty("weight").toInt(), 3);
+    QVERIFY(document->snapshot(EdgeTypePtr(), "weight") != snapshot);
+
+    document->destroy();
+}
+
+void TestGraphOperations::testSnapshot()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    EdgeTypePtr unidirectional = document->edgeTypes().first();
+    unidirectional->setDirection(EdgeType::Unidirectional);
+    unidirectional->addDynamicProperty("weight");
+    EdgeTypePtr bidirectional = EdgeType::create(document);
+    bidirectional->setDirection(EdgeType::Bidirectional);
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    NodePtr nodeC = Node::create(document);
+    EdgePtr edgeAB = Edge::create(nodeA, nodeB);
+    edgeAB->setDynamicProperty("weight", 2.5);
+    EdgePtr edgeCB = Edge::create(nodeC, nodeB);
+    edgeCB->setType(bidirectional);
+
+    // all edges, bidirectional edge yields arcs in both directions
+    GraphSnapshotPtr snapshot = document->snapshot(EdgeTypePtr(), "weight");
+    QCOMPARE(snapshot->nodeCount(), 3);
+    QCOMPARE(snapshot->arcCount(), 3);
+    const int a = nodeA->documentIndex();
+    const int b = nodeB->documentIndex();
+    const int c = nodeC->documentIndex();
+    QCOMPARE(snapshot->outOffsets().at(a + 1) - snapshot->outOffsets().at(a), 1);
+    QCOMPARE(snapshot->outOffsets().at(b + 1) - snapshot->outOffsets().at(b), 1);
+    QCOMPARE(snapshot->inOffsets().at(b + 1) - snapshot->inOffsets().at(b), 2);
+    const int arcAB = snapshot->outOffsets().at(a);
+    QCOMPARE(snapshot->targets().at(arcAB), b);
+    QCOMPARE(snapshot->edge(arcAB), edgeAB);
+    QCOMPARE(snapshot->weights().at(arcAB), qreal(2.5));
+    const int arcBC = snapshot->outOffsets().at(b);
+    QCOMPARE(snapshot->targets().at(arcBC), c);
+    QCOMPARE(snapshot->weights().at(arcBC), qreal(1)); // unset weight
+    const int inArc = snapshot->inOffsets().at(c);
+    QCOMPARE(snapshot->sources().at(inArc), b);
+    QCOMPARE(snapshot->inArcs().at(inArc), arcBC);
+
+    // edge type filter
+    GraphSnapshotPtr filtered = document->snapshot(bidirectional);
+    QCOMPARE(filtered->arcCount(), 2);
+    QVERIFY(filtered->weights().isEmpty());
+
+    // caching and invalidation
+    QCOMPARE(document->snapshot(EdgeTypePtr(), "weight"), snapshot);
+    edgeAB->setDynamicProperty("weight", 3);
+    GraphSnapshotPtr updated = document->snapshot(EdgeTypePtr(), "weight");
+    QVERIFY(updated != snapshot);
+    QCOMPARE(updated->weights().at(updated->outOffsets().at(a)), qreal(3));
+    edgeCB->destroy();
+    QCOMPARE(document->snapshot(EdgeTypePtr(), "weight")->arcCount(), 1);
+
+    document->destroy();
+}
+
 QTEST_MAIN(TestGraphOperations)
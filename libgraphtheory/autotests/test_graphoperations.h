@@ -52,6 +52,12 @@ private Q_SLOTS:
     void testEdgesOfDifferentType();
     void testEdgeDirectionChange();
     void testDynamicPropertyRename();
+    void testDocumentIndices();
+    void testIdentifierLookup();
+    void testBulkUpdate();
+    void testNodePositions();
+    void testPropertyColumns();
+    void testSnapshot();
 };
 
 #endif
@@ -26,7 +26,10 @@
 #include "libgraphtheory/node.h"
 #include "libgraphtheory/edge.h"
 
+#include <QElapsedTimer>
+#include <QSignalSpy>
 #include <QTest>
+#include <QThread>
 
 void TestKernel::initTestCase()
 {
@@ -634,6 +637,12 @@ void TestKernel::deleteNode()
     result = kernel.execute(document, script);
     QCOMPARE(document->nodes().count(), 0);
 
+    // script values of removed nodes must not be usable anymore
+    script = "var node = Document.createNode(0, 0); Document.remove(node); node.x;";
+    result = kernel.execute(document, script);
+    QCOMPARE(document->nodes().count(), 0);
+    QVERIFY(result.toString().contains("deleted QObject"));
+
     // cleanup
     document->destroy();
 }
@@ -686,8 +695,357 @@ void TestKernel::distance()
     result = kernel.execute(document, script);
     QCOMPARE(result.toInteger(), qreal(2));
 
+    // cached distances do not keep nodes alive that are removed between executions
+    const uint nodeCount = Node::objects();
+    nodeC->destroy();
+    nodeC.reset();
+    edgeBC.reset();
+    kernel.execute(document, "Document.nodes().length;");
+    QCOMPARE(Node::objects(), nodeCount - 1);
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::scriptObjectIdentity()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    Edge::create(nodeA, nodeB);
+
+    Kernel kernel;
+    QString script;
+    QScriptValue result;
+
+    script = QString("Document.nodes()[0] === Document.node(%1);").arg(nodeA->id());
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toBool(), true);
+
+    script = "Document.edges()[0].from() === Document.nodes()[0] && Document.nodes()[0].successors()[0] === Document.nodes()[1];";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toBool(), true);
+
+    // returned arrays are not shared
+    script = "var nodes = Document.nodes(); nodes.pop(); Document.nodes().length;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toInteger(), qreal(2));
+
+    // arrays are updated after changes of the document
+    script = "var node = Document.nodes()[0]; Document.createNode(0, 0); Document.nodes().length;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toInteger(), qreal(3));
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::propertyValues()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("dist");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    EdgePtr edge = Edge::create(nodeA, nodeB);
+    document->edgeTypes().first()->addDynamicProperty("weight");
+
+    Kernel kernel;
+    QString script;
+    QScriptValue result;
+
+    // assign one value to all nodes of a type
+    script = QString("Document.setPropertyValues(%1, \"dist\", Infinity);"
+        "Document.nodes()[0].dist;").arg(document->nodeTypes().first()->id());
+    result = kernel.execute(document, script);
+    QVERIFY(qIsInf(nodeA->dynamicProperty("dist").toDouble()));
+    QVERIFY(qIsInf(nodeB->dynamicProperty("dist").toDouble()));
+    QVERIFY(qIsInf(result.toNumber()));
+
+    // assign one value per element, mixed nodes and edges
+    script = "var nodes = Document.nodes();"
+        "Document.setPropertyValues([nodes[1], nodes[0]], \"dist\", [1, 2]);"
+        "Document.setPropertyValues(Document.edges(), \"weight\", [3]);"
+        "Document.propertyValues(Document.nodes(), \"dist\").join(\",\");";
+    result = kernel.execute(document, script);
+    QCOMPARE(nodeA->dynamicProperty("dist").toInt(), 2);
+    QCOMPARE(nodeB->dynamicProperty("dist").toInt(), 1);
+    QCOMPARE(edge->dynamicProperty("weight").toInt(), 3);
+    QCOMPARE(result.toString(), QString("2,1"));
+
+    // unregistered properties are kept at the script objects
+    script = "Document.setPropertyValues(Document.nodes(), \"visited\", true);"
+        "Document.nodes()[1].visited && Document.propertyValues(Document.nodes(), \"visited\")[0];";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toString(), QString("true"));
+
+    // wrong number of values
+    script = "Document.setPropertyValues(Document.nodes(), \"dist\", [7]); Document.nodes()[0].dist;";
+    result = kernel.execute(document, script);
+    QCOMPARE(nodeA->dynamicProperty("dist").toInt(), 2);
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::profiling()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    Node::create(document);
+    Node::create(document);
+
+    Kernel kernel;
+    QVERIFY(!kernel.isProfilingEnabled());
+    QString script = "var count = 0;\n"
+        "for (var i = 0; i < 10; ++i) {\n"
+        "    count += Document.nodes().length;\n"
+        "    Document.nodes()[0].weight = i;\n"
+        "}\n"
+        "count;";
+    // the script is compiled without profiling first, like when profiling is enabled after a slow run
+    kernel.execute(document, script);
+    kernel.setProfilingEnabled(true);
+
+    // profiling a script again reports the same data, though the script is not loaded again
+    for (int run = 0; run < 2; ++run) {
+        QSignalSpy messageSpy(&kernel, SIGNAL(message(QString,GraphTheory::Kernel::MessageType)));
+        QScriptValue result = kernel.execute(document, script);
+        QCOMPARE(result.toInteger(), qreal(20));
+
+        QStringList messages;
+        for (const auto &arguments : messageSpy) {
+            messages.append(arguments.at(0).toString());
+        }
+        QVERIFY(messages.filter(QRegExp("^line 3: .* ms, 10 executions$")).count() == 1);
+        QVERIFY(messages.filter(QRegExp("^Document.nodes\\(\\): .* ms, 20 calls$")).count() == 1);
+        QVERIFY(messages.filter(QRegExp("^Node.weight =: .* ms, 10 calls$")).count() == 1);
+    }
+
+    // cleanup
+    document->destroy();
+}
+
+void TestKernel::threadedExecution()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    Edge::create(nodeA, nodeB);
+
+    Kernel kernel;
+    QSignalSpy finishedSpy(&kernel, SIGNAL(executionFinished()));
+    QSignalSpy messageSpy(&kernel, SIGNAL(message(QString,GraphTheory::Kernel::MessageType)));
+    QString script = "var node = Document.createNode(10, 20);"
+        "Document.createEdge(Document.nodes()[1], node);"
+        "node.color = \"#ff0000\";"
+        "Document.nodes()[0].successors().length;";
+    kernel.start(document, script);
+    QVERIFY(kernel.isRunning());
+    QVERIFY(finishedSpy.wait());
+    QVERIFY(!kernel.isRunning());
+
+    QCOMPARE(document->nodes().count(), 3);
+    QCOMPARE(document->edges().count(), 2);
+    QCOMPARE(document->nodes().at(2)->x(), qreal(10));
+    QCOMPARE(document->nodes().at(2)->color(), QColor("#ff0000"));
+    QVERIFY(messageSpy.count() > 0);
+    QCOMPARE(messageSpy.last().at(0).toString(), QString("1"));
+
+    // stop an endless script
+    kernel.start(document, "while (true) {}");
+    QTest::qWait(50);
+    kernel.stop();
+    QVERIFY(finishedSpy.wait());
+    QVERIFY(!kernel.isRunning());
+
+    // scripts waiting for calls into the document's thread are stopped without its help
+    kernel.start(document, "while (true) { Document.nodes()[0].x; }");
+    QTest::qWait(50);
+    const int finished = finishedSpy.count();
+    kernel.stop();
+    QElapsedTimer timer;
+    timer.start();
+    while (kernel.isRunning() && timer.elapsed() < 5000) {
+        QThread::msleep(10);
+    }
+    QVERIFY(!kernel.isRunning());
+    QTRY_COMPARE(finishedSpy.count(), finished + 1);
+
     // cleanup
     document->destroy();
 }
 
+void TestKernel::repeatedExecution()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("registered");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+
+    Kernel kernel;
+    QString script;
+    QScriptValue result;
+
+    script = "stored = Document.nodes()[1]; stored.registered = 1; stored.unregistered = 2; stored.unregistered;";
+    result = kernel.execute(document, script);
+    QCOMPARE(result.toString(), QString("2"));
+
+    // script objects are reused by subsequent executions
+    result = kernel.execute(document, "stored === Document.nodes()[1];");
+    QCOMPARE(result.toString(), QString("true"));
+
+    // but properties that are not registered at the type are only kept for one execution
+    result = kernel.execute(document, "Document.nodes()[1].registered;");
+    QCOMPARE(result.toString(), QString("1"));
+    result = kernel.execute(document, "Document.nodes()[1].unregistered === undefined;");
+    QCOMPARE(result.toString(), QString("true"));
+
+    // changes of the document between executions are visible
+    nodeA->destroy();
+    Node::create(document);
+    Node::create(document);
+    result = kernel.execute(document, "Document.nodes().length;");
+    QCOMPARE(result.toInteger(), qreal(3));
+
+    // the kernel does not keep destroyed documents alive
+    document->destroy();
+    document.reset();
+    nodeA.reset();
+    nodeB.reset();
+    QCOMPARE(Node::objects(), uint(0));
+    QCOMPARE(GraphDocument::objects(), uint(0));
+}
+
+void TestKernel::syntaxCheck()
+{
+    Kernel kernel;
+    QSignalSpy spy(&kernel, SIGNAL(syntaxChecked(bool,int,QString)));
+
+    kernel.checkSyntax("var a = 1;\nvar b = a + 1;");
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.last().at(0).toBool(), true);
+
+    kernel.checkSyntax("var a = 1;\nvar b = ;");
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.last().at(0).toBool(), false);
+    QCOMPARE(spy.last().at(1).toInt(), 2);
+
+    // unclosed blocks are reported at the end of the script
+    kernel.checkSyntax("if (true) {\nvar a = 1;");
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.last().at(0).toBool(), false);
+    QCOMPARE(spy.last().at(1).toInt(), 2);
+
+    // only the result of the last request is reported
+    kernel.checkSyntax("var a = ;");
+    kernel.checkSyntax("var a = 1;");
+    QVERIFY(spy.wait());
+    QTest::qWait(50);
+    QCOMPARE(spy.count(), 4);
+    QCOMPARE(spy.last().at(0).toBool(), true);
+}
+
+void TestKernel::layout()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodeList nodes;
+    for (int i = 0; i < 10; ++i) {
+        nodes.append(Node::create(document));
+    }
+    for (int i = 1; i < 10; ++i) {
+        Edge::create(nodes.at(i - 1), nodes.at(i));
+    }
+
+    Kernel kernel;
+    QSignalSpy spy(&kernel, SIGNAL(message(QString,GraphTheory::Kernel::MessageType)));
+
+    // nodes at the same spot are spread out
+    kernel.execute(document, "Document.layout(\"multilevel\");");
+    QVERIFY(nodes.at(0)->x() != nodes.at(1)->x() || nodes.at(0)->y() != nodes.at(1)->y());
+    QCOMPARE(spy.count(), 0);
+
+    // nodes are moved onto a circle
+    const QPointF first(nodes.at(0)->x(), nodes.at(0)->y());
+    kernel.execute(document, "Document.layout(\"circle\");");
+    QVERIFY(QPointF(nodes.at(0)->x(), nodes.at(0)->y()) != first);
+
+    // the path is placed on one layer per node
+    kernel.execute(document, "Document.layout(\"layered\");");
+    for (int i = 1; i < 10; ++i) {
+        QVERIFY(nodes.at(i - 1)->y() < nodes.at(i)->y());
+    }
+
+    // unknown layout algorithms are reported
+    kernel.execute(document, "Document.layout(\"unknown\");");
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(spy.last().at(0).toString().contains("unknown layout algorithm"));
+
+    document->destroy();
+}
+
+void TestKernel::elementSignals()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    Edge::create(nodeA, nodeB);
+
+    Kernel kernel;
+    QSignalSpy bulkSpy(document.data(), &GraphDocument::bulkUpdateAboutToBegin);
+    QSignalSpy edgesRemovedSpy(document.data(), &GraphDocument::edgesAboutToBeRemoved);
+    QSignalSpy nodeAddedSpy(document.data(), &GraphDocument::nodeAboutToBeAdded);
+
+    // listeners learn about removed elements before they are deleted
+    kernel.execute(document, "Document.remove(Document.edges()[0]); Document.createNode(0, 0);");
+    QCOMPARE(edgesRemovedSpy.count(), 1);
+    QCOMPARE(nodeAddedSpy.count(), 1);
+    QCOMPARE(bulkSpy.count(), 0);
+
+    // read-only scripts do not reset any views
+    kernel.execute(document, "Document.nodes().length;");
+    QCOMPARE(bulkSpy.count(), 0);
+
+    document->destroy();
+}
+
+void TestKernel::changedPropertyValues()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    document->nodeTypes().first()->addDynamicProperty("value");
+    document->edgeTypes().first()->addDynamicProperty("value");
+    NodePtr nodeA = Node::create(document);
+    NodePtr nodeB = Node::create(document);
+    EdgePtr edge = Edge::create(nodeA, nodeB);
+    nodeA->setDynamicProperty("value", 1);
+    edge->setDynamicProperty("value", 1);
+
+    Kernel kernel;
+    QScriptValue result;
+    result = kernel.execute(document, "Document.nodes()[0].value + Document.edges()[0].value;");
+    QCOMPARE(result.toInteger(), qreal(2));
+
+    // values set by the user between executions
+    nodeA->setDynamicProperty("value", 2);
+    edge->setDynamicProperty("value", 3);
+    result = kernel.execute(document, "Document.nodes()[0].value + Document.edges()[0].value;");
+    QCOMPARE(result.toInteger(), qreal(5));
+
+    // values set for many elements at once
+    document->setNodeProperties(document->nodes(), "value", QVector<QVariant>() << 4);
+    result = kernel.execute(document, "Document.nodes()[0].value + Document.nodes()[1].value;");
+    QCOMPARE(result.toInteger(), qreal(8));
+
+    // values set while the script engine of the worker thread is idle
+    QSignalSpy finishedSpy(&kernel, SIGNAL(executionFinished()));
+    QSignalSpy messageSpy(&kernel, SIGNAL(message(QString,GraphTheory::Kernel::MessageType)));
+    kernel.start(document, "Document.nodes()[0].value;");
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(messageSpy.last().at(0).toString(), QString("4"));
+    nodeA->setDynamicProperty("value", 5);
+    kernel.start(document, "Document.nodes()[0].value;");
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(messageSpy.last().at(0).toString(), QString("5"));
+
+    document->destroy();
+}
+
 QTEST_MAIN(TestKernel)
@@ -79,6 +79,24 @@ private Q_SLOTS:
     void deleteEdge();
     /** test Node::distance function **/
     void distance();
+    /** test that script objects of graph elements are reused **/
+    void scriptObjectIdentity();
+    /** test Document.setPropertyValues and Document.propertyValues **/
+    void propertyValues();
+    /** test profiling of script executions **/
+    void profiling();
+    /** test script execution in worker thread **/
+    void threadedExecution();
+    /** test that script objects are kept between executions on the same document **/
+    void repeatedExecution();
+    /** test background syntax check **/
+    void syntaxCheck();
+    /** test Document.layout **/
+    void layout();
+    /** test that changes of scripts are announced per element **/
+    void elementSignals();
+    /** test that values changed between executions are seen by scripts **/
+    void changedPropertyValues();
 };
 
 #endif
@@ -41,6 +41,7 @@ void TestKernelScriptApi::xmlValidity()
 
     QXmlSchemaValidator validator(schema);
     QVERIFY(validator.validate(QUrl::fromLocalFile("kernelapi/console.xml")));
+    QVERIFY(validator.validate(QUrl::fromLocalFile("kernelapi/algorithms.xml")));
     QVERIFY(validator.validate(QUrl::fromLocalFile("kernelapi/document.xml")));
     QVERIFY(validator.validate(QUrl::fromLocalFile("kernelapi/node.xml")));
     QVERIFY(validator.validate(QUrl::fromLocalFile("kernelapi/edge.xml")));
@@ -0,0 +1,577 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_layout.h"
+#include "libgraphtheory/graphdocument.h"
+#include "libgraphtheory/node.h"
+#include "libgraphtheory/edge.h"
+#include "libgraphtheory/modifiers/forcedirectedlayout.h"
+#include "libgraphtheory/modifiers/multilevellayout.h"
+#include "libgraphtheory/modifiers/layeredlayout.h"
+#include "libgraphtheory/modifiers/incrementallayout.h"
+#include "libgraphtheory/modifiers/layoutjob.h"
+#include "libgraphtheory/modifiers/layoutobserver.h"
+#include "libgraphtheory/modifiers/topology.h"
+
+#include <QSignalSpy>
+#include <QTest>
+#include <QtMath>
+
+using namespace GraphTheory;
+
+namespace
+{
+// deterministic pseudo random start positions inside [0, size)^2
+QVector<QPointF> startPositions(int count, qreal size)
+{
+    QVector<QPointF> positions(count);
+    quint32 state = 42;
+    for (int i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        const qreal x = (state >> 8) % 100000 / 100000.0 * size;
+        state = state * 1664525u + 1013904223u;
+        const qreal y = (state >> 8) % 100000 / 100000.0 * size;
+        positions[i] = QPointF(x, y);
+    }
+    return positions;
+}
+
+QVector<QPair<int, int> > gridEdges(int width)
+{
+    QVector<QPair<int, int> > edges;
+    for (int row = 0; row < width; ++row) {
+        for (int column = 0; column < width; ++column) {
+            const int index = row * width + column;
+            if (column + 1 < width) {
+                edges.append(qMakePair(index, index + 1));
+            }
+            if (row + 1 < width) {
+                edges.append(qMakePair(index, index + width));
+            }
+        }
+    }
+    return edges;
+}
+
+// cancels layouts after a given number of iterations and counts all updates
+class CancelingObserver : public LayoutObserver
+{
+public:
+    explicit CancelingObserver(int iterations)
+        : m_iterations(iterations)
+        , m_checks(0)
+        , m_updates(0)
+    {
+    }
+
+    bool isCanceled() const Q_DECL_OVERRIDE
+    {
+        return ++m_checks > m_iterations;
+    }
+
+    bool isUpdateDue() const Q_DECL_OVERRIDE
+    {
+        return true;
+    }
+
+    void update(const QVector<QPointF> &positions) Q_DECL_OVERRIDE
+    {
+        m_positions = positions;
+        ++m_updates;
+    }
+
+    int m_iterations;
+    mutable int m_checks;
+    int m_updates;
+    QVector<QPointF> m_positions;
+};
+
+// creates a document with a square grid of width times width nodes at the given positions
+GraphDocumentPtr createGrid(int width, const QVector<QPointF> &positions)
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodeList nodes;
+    for (int i = 0; i < width * width; ++i) {
+        NodePtr node = Node::create(document);
+        node->setX(positions.at(i).x());
+        node->setY(positions.at(i).y());
+        nodes.append(node);
+    }
+    typedef QPair<int, int> IndexPair;
+    foreach (const IndexPair &edge, gridEdges(width)) {
+        Edge::create(nodes.at(edge.first), nodes.at(edge.second));
+    }
+    return document;
+}
+
+qreal distance(const QPointF &a, const QPointF &b)
+{
+    const QPointF delta = a - b;
+    return qSqrt(delta.x() * delta.x() + delta.y() * delta.y());
+}
+}
+
+void TestLayout::initTestCase()
+{
+    QVERIFY(GraphDocument::objects() == 0);
+    QVERIFY(Node::objects() == 0);
+    QVERIFY(Edge::objects() == 0);
+}
+
+void TestLayout::cleanupTestCase()
+{
+    QVERIFY(GraphDocument::objects() == 0);
+    QVERIFY(Node::objects() == 0);
+    QVERIFY(Edge::objects() == 0);
+}
+
+void TestLayout::testForceDirectedQuality()
+{
+    const int width = 20;
+    const int count = width * width;
+    QVector<QPointF> positions = startPositions(count, 1000);
+    const QVector<QPair<int, int> > edges = gridEdges(width);
+
+    ForceDirectedLayout layout;
+    const int iterations = layout.apply(positions, edges);
+    QVERIFY(iterations > 0);
+    QVERIFY(iterations <= layout.maxIterations());
+
+    // adjacent nodes are much closer than arbitrary pairs of nodes
+    qreal edgeLength = 0;
+    typedef QPair<int, int> IndexPair;
+    foreach (const IndexPair &edge, edges) {
+        edgeLength += distance(positions.at(edge.first), positions.at(edge.second));
+    }
+    edgeLength /= edges.count();
+    qreal pairDistance = 0;
+    qreal minimalDistance = distance(positions.at(0), positions.at(1));
+    for (int i = 0; i < count; ++i) {
+        for (int j = i + 1; j < count; ++j) {
+            const qreal d = distance(positions.at(i), positions.at(j));
+            pairDistance += d;
+            minimalDistance = qMin(minimalDistance, d);
+        }
+    }
+    pairDistance /= count * (count - 1) / 2;
+    QVERIFY(edgeLength * 3 < pairDistance);
+
+    // no nodes are placed on top of each other
+    QVERIFY(minimalDistance > 0.01 * edgeLength);
+}
+
+void TestLayout::testForceDirectedBoundingRect()
+{
+    QVector<QPointF> positions = startPositions(100, 1000);
+    const QRectF rect(-50, 20, 300, 200);
+
+    ForceDirectedLayout layout;
+    layout.setBoundingRect(rect);
+    layout.apply(positions, gridEdges(10));
+    foreach (const QPointF &position, positions) {
+        QVERIFY(position.x() >= rect.left() - 1e-6);
+        QVERIFY(position.x() <= rect.right() + 1e-6);
+        QVERIFY(position.y() >= rect.top() - 1e-6);
+        QVERIFY(position.y() <= rect.bottom() + 1e-6);
+    }
+
+    // coinciding start positions are spread out
+    QVector<QPointF> coinciding(10, QPointF(5, 5));
+    layout.apply(coinciding, QVector<QPair<int, int> >());
+    QVERIFY(coinciding.at(0) != coinciding.at(1));
+}
+
+void TestLayout::testForceDirectedDeterminism()
+{
+    const QVector<QPair<int, int> > edges = gridEdges(10);
+    QVector<QPointF> first = startPositions(100, 500);
+    QVector<QPointF> second = first;
+
+    ForceDirectedLayout layout;
+    layout.apply(first, edges);
+    layout.apply(second, edges);
+    QCOMPARE(first, second);
+}
+
+void TestLayout::testForceDirectedLargeGraph()
+{
+    // large enough to accumulate forces in parallel
+    const int width = 50;
+    const QVector<QPair<int, int> > edges = gridEdges(width);
+    QVector<QPointF> first = startPositions(width * width, 2000);
+    QVector<QPointF> second = first;
+
+    ForceDirectedLayout layout;
+    layout.setMaxIterations(30);
+    QCOMPARE(layout.apply(first, edges), 30);
+    layout.apply(second, edges);
+    QCOMPARE(first, second);
+    foreach (const QPointF &position, first) {
+        QVERIFY(qIsFinite(position.x()));
+        QVERIFY(qIsFinite(position.y()));
+    }
+}
+
+void TestLayout::testMinCutTreeAlignment()
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr outside = Node::create(document);
+    outside->setX(-500);
+    outside->setY(-500);
+    NodeList nodes;
+    const QVector<QPointF> positions = startPositions(25, 400);
+    for (int i = 0; i < positions.count(); ++i) {
+        NodePtr node = Node::create(document);
+        node->setX(positions.at(i).x());
+        node->setY(positions.at(i).y());
+        nodes.append(node);
+    }
+    typedef QPair<int, int> IndexPair;
+    foreach (const IndexPair &edge, gridEdges(5)) {
+        Edge::create(nodes.at(edge.first), nodes.at(edge.second));
+    }
+    Edge::create(outside, nodes.first());
+
+    QRectF box(positions.first(), QSizeF(0, 0));
+    foreach (const QPointF &position, positions) {
+        box.setLeft(qMin(box.left(), position.x()));
+        box.setRight(qMax(box.right(), position.x()));
+        box.setTop(qMin(box.top(), position.y()));
+        box.setBottom(qMax(box.bottom(), position.y()));
+    }
+    Topology topology;
+    topology.applyMinCutTreeAlignment(nodes);
+
+    // nodes outside of the set are not moved and the layout stays inside the old bounding box
+    QCOMPARE(outside->x(), qreal(-500));
+    QCOMPARE(outside->y(), qreal(-500));
+    foreach (NodePtr node, nodes) {
+        QVERIFY(node->x() >= box.left() - 1e-6);
+        QVERIFY(node->x() <= box.right() + 1e-6);
+        QVERIFY(node->y() >= box.top() - 1e-6);
+        QVERIFY(node->y() <= box.bottom() + 1e-6);
+    }
+
+    document->destroy();
+}
+
+void TestLayout::testMultilevel()
+{
+    const int width = 30;
+    const int count = width * width;
+    const QVector<QPair<int, int> > edges = gridEdges(width);
+    QVector<QPointF> positions = startPositions(count, 1000);
+
+    MultilevelLayout layout;
+    QVERIFY(layout.apply(positions, edges) > 1);
+
+    // adjacent nodes are much closer than arbitrary pairs of nodes
+    qreal edgeLength = 0;
+    typedef QPair<int, int> IndexPair;
+    foreach (const IndexPair &edge, edges) {
+        edgeLength += distance(positions.at(edge.first), positions.at(edge.second));
+    }
+    edgeLength /= edges.count();
+    qreal pairDistance = 0;
+    for (int i = 0; i < count; ++i) {
+        for (int j = i + 1; j < count; ++j) {
+            pairDistance += distance(positions.at(i), positions.at(j));
+        }
+    }
+    pairDistance /= count * (count - 1) / 2;
+    QVERIFY(edgeLength * 3 < pairDistance);
+
+    // deterministic and fitted into the bounding rectangle
+    const QRectF rect(0, 0, 400, 300);
+    QVector<QPointF> first = startPositions(count, 1000);
+    QVector<QPointF> second = first;
+    layout.setBoundingRect(rect);
+    layout.apply(first, edges);
+    layout.apply(second, edges);
+    QCOMPARE(first, second);
+    foreach (const QPointF &position, first) {
+        QVERIFY(position.x() >= rect.left() - 1e-6);
+        QVERIFY(position.x() <= rect.right() + 1e-6);
+        QVERIFY(position.y() >= rect.top() - 1e-6);
+        QVERIFY(position.y() <= rect.bottom() + 1e-6);
+    }
+}
+
+void TestLayout::testMultilevelCoarsening()
+{
+    // a matching hardly reduces a star, hence its center merges all leaves as independent set
+    QVector<QPair<int, int> > edges;
+    for (int i = 1; i <= 200; ++i) {
+        edges.append(qMakePair(0, i));
+    }
+    MultilevelLayout layout;
+    QCOMPARE(layout.coarsening(), MultilevelLayout::EdgeMatching);
+    QVector<QPointF> matching = startPositions(201, 500);
+    QCOMPARE(layout.apply(matching, edges), 2);
+
+    layout.setCoarsening(MultilevelLayout::IndependentSet);
+    QVector<QPointF> independentSet = startPositions(201, 500);
+    QCOMPARE(layout.apply(independentSet, edges), 2);
+    for (int i = 0; i < independentSet.count(); ++i) {
+        for (int j = i + 1; j < independentSet.count(); ++j) {
+            QVERIFY(independentSet.at(i) != independentSet.at(j));
+        }
+    }
+
+    // graphs below the coarsest size are laid out in a single level
+    layout.setCoarsestNodeCount(500);
+    QCOMPARE(layout.apply(independentSet, edges), 1);
+}
+
+void TestLayout::testLayered()
+{
+    // random DAG with long edges, where edges always point to nodes of higher index
+    const int count = 300;
+    QVector<QPair<int, int> > edges;
+    quint32 state = 7;
+    for (int i = 1; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        edges.append(qMakePair(int((state >> 8) % i), i));
+        state = state * 1664525u + 1013904223u;
+        edges.append(qMakePair(int((state >> 8) % i), i));
+    }
+    QVector<QPointF> positions = startPositions(count, 1000);
+    LayeredLayout layout;
+    QVERIFY(layout.apply(positions, edges) > 1);
+
+    // edges point downwards and nodes of a layer keep the node distance
+    typedef QPair<int, int> IndexPair;
+    foreach (const IndexPair &edge, edges) {
+        QVERIFY(positions.at(edge.first).y() + layout.layerDistance() - 1e-6 <= positions.at(edge.second).y());
+    }
+    for (int i = 0; i < count; ++i) {
+        for (int j = i + 1; j < count; ++j) {
+            if (qAbs(positions.at(i).y() - positions.at(j).y()) < 1e-6) {
+                QVERIFY(qAbs(positions.at(i).x() - positions.at(j).x()) >= layout.nodeDistance() - 1e-6);
+            }
+        }
+    }
+
+    // crossings of a twisted matching are resolved and aligned edges are vertical
+    edges.clear();
+    for (int i = 0; i < 5; ++i) {
+        edges.append(qMakePair(i, 9 - i));
+    }
+    positions = startPositions(10, 1000);
+    QCOMPARE(layout.apply(positions, edges), 2);
+    foreach (const IndexPair &edge, edges) {
+        QCOMPARE(positions.at(edge.first).x(), positions.at(edge.second).x());
+    }
+
+    // fitted into the bounding rectangle
+    const QRectF rect(0, 0, 400, 300);
+    layout.setBoundingRect(rect);
+    positions = startPositions(10, 1000);
+    layout.apply(positions, edges);
+    foreach (const QPointF &position, positions) {
+        QVERIFY(position.x() >= rect.left() - 1e-6);
+        QVERIFY(position.x() <= rect.right() + 1e-6);
+        QVERIFY(position.y() >= rect.top() - 1e-6);
+        QVERIFY(position.y() <= rect.bottom() + 1e-6);
+    }
+}
+
+void TestLayout::testLayeredCycles()
+{
+    // cycle with chord, self-loop and invalid edge: all nodes are placed on separate spots
+    QVector<QPair<int, int> > edges;
+    for (int i = 0; i < 6; ++i) {
+        edges.append(qMakePair(i, (i + 1) % 6));
+    }
+    edges.append(qMakePair(0, 3));
+    edges.append(qMakePair(2, 2));
+    edges.append(qMakePair(4, 10));
+    QVector<QPointF> positions = startPositions(6, 1000);
+    LayeredLayout layout;
+    QVERIFY(layout.apply(positions, edges) > 1);
+    for (int i = 0; i < positions.count(); ++i) {
+        for (int j = i + 1; j < positions.count(); ++j) {
+            QVERIFY(positions.at(i) != positions.at(j));
+        }
+    }
+
+    // default topology of imported directed graphs
+    GraphDocumentPtr document = GraphDocument::create();
+    NodeList nodes;
+    for (int i = 0; i < 4; ++i) {
+        nodes.append(Node::create(document));
+    }
+    Edge::create(nodes.at(0), nodes.at(1));
+    Edge::create(nodes.at(1), nodes.at(2));
+    Edge::create(nodes.at(0), nodes.at(3));
+    Topology topology;
+    topology.directedGraphDefaultTopology(document);
+    QVERIFY(nodes.at(0)->y() < nodes.at(1)->y());
+    QVERIFY(nodes.at(1)->y() < nodes.at(2)->y());
+    QVERIFY(nodes.at(0)->y() < nodes.at(3)->y());
+    document->destroy();
+}
+
+void TestLayout::testIncremental()
+{
+    // pinned 10x10 grid with a path of five new nodes attached to its center
+    const int width = 10;
+    QVector<QPointF> positions;
+    for (int i = 0; i < width * width; ++i) {
+        positions.append(QPointF(i % width * 50, i / width * 50));
+    }
+    QVector<QPair<int, int> > edges = gridEdges(width);
+    QVector<bool> pinned(width * width, true);
+    for (int i = 0; i < 5; ++i) {
+        positions.append(QPointF(0, 0));
+        pinned.append(false);
+        edges.append(qMakePair(i == 0 ? 55 : width * width + i - 1, width * width + i));
+    }
+    const QVector<QPointF> start = positions;
+
+    IncrementalLayout layout;
+    layout.apply(positions, edges, pinned);
+
+    // only new nodes move and they are placed close to their neighbors without overlapping
+    for (int i = 0; i < width * width; ++i) {
+        QCOMPARE(positions.at(i), start.at(i));
+    }
+    for (int i = width * width; i < positions.count(); ++i) {
+        QVERIFY(distance(positions.at(i), positions.at(55)) < 6 * layout.idealEdgeLength());
+        for (int j = 0; j < i; ++j) {
+            QVERIFY(distance(positions.at(i), positions.at(j)) > 0.1 * layout.idealEdgeLength());
+        }
+    }
+    typedef QPair<int, int> IndexPair;
+    foreach (const IndexPair &edge, edges.mid(edges.count() - 5)) {
+        QVERIFY(distance(positions.at(edge.first), positions.at(edge.second)) < 2 * layout.idealEdgeLength());
+    }
+
+    // without pinned nodes, the first node is the anchor
+    positions = QVector<QPointF>(3, QPointF(100, 100));
+    edges.clear();
+    edges << qMakePair(0, 1) << qMakePair(1, 2);
+    layout.apply(positions, edges, QVector<bool>(3, false));
+    QVERIFY(distance(positions.at(0), QPointF(100, 100)) < layout.idealEdgeLength());
+    QVERIFY(positions.at(1) != positions.at(2));
+}
+
+void TestLayout::testIncrementalAlignment()
+{
+    GraphDocumentPtr document = createGrid(20, startPositions(400, 1000));
+    const QVector<QPointF> start = document->nodePositions();
+    NodeList nodes;
+    for (int i = 0; i < 3; ++i) {
+        NodePtr node = Node::create(document);
+        Edge::create(i == 0 ? document->nodes().at(210) : nodes.last(), node);
+        nodes.append(node);
+    }
+    Edge::create(nodes.last(), nodes.first());
+
+    Topology topology;
+    topology.applyIncrementalAlignment(nodes);
+
+    // existing nodes keep their positions and the new nodes are spread around their neighbor
+    for (int i = 0; i < start.count(); ++i) {
+        QCOMPARE(document->nodes().at(i)->x(), start.at(i).x());
+        QCOMPARE(document->nodes().at(i)->y(), start.at(i).y());
+    }
+    foreach (NodePtr node, nodes) {
+        QVERIFY(distance(QPointF(node->x(), node->y()), start.at(210)) < 200);
+        QVERIFY(node->x() != 0 || node->y() != 0);
+    }
+    document->destroy();
+}
+
+void TestLayout::testObserver()
+{
+    const QVector<QPair<int, int> > edges = gridEdges(20);
+
+    // every iteration is reported and cancellation stops the layout
+    CancelingObserver forceDirectedObserver(5);
+    ForceDirectedLayout forceDirected;
+    forceDirected.setObserver(&forceDirectedObserver);
+    QVector<QPointF> positions = startPositions(400, 1000);
+    QCOMPARE(forceDirected.apply(positions, edges), 6);
+    QCOMPARE(forceDirectedObserver.m_updates, 5);
+    QCOMPARE(forceDirectedObserver.m_positions.count(), 400);
+
+    // coarse levels are reported for all nodes of the input graph
+    CancelingObserver multilevelObserver(5);
+    MultilevelLayout multilevel;
+    multilevel.setObserver(&multilevelObserver);
+    positions = startPositions(400, 1000);
+    multilevel.apply(positions, edges);
+    QCOMPARE(multilevelObserver.m_updates, 5);
+    QCOMPARE(multilevelObserver.m_positions.count(), 400);
+    QCOMPARE(positions.count(), 400);
+}
+
+void TestLayout::testLayoutJob()
+{
+    const QVector<QPointF> start = startPositions(100, 1000);
+    GraphDocumentPtr document = createGrid(10, start);
+    QSignalSpy positionSpy(document.data(), &GraphDocument::nodePositionsChanged);
+
+    LayoutJob job(LayoutJob::Multilevel, document->nodes());
+    QSignalSpy finishedSpy(&job, &LayoutJob::finished);
+    job.start();
+    QVERIFY(job.isRunning());
+    QVERIFY(finishedSpy.wait());
+    QVERIFY(!job.isRunning());
+    QVERIFY(!job.isCanceled());
+    QVERIFY(positionSpy.count() >= 1);
+    QVERIFY(document->nodePositions() != start);
+
+    // removed nodes are skipped when writing the result
+    LayoutJob secondJob(LayoutJob::ForceDirected, document->nodes());
+    secondJob.setUpdateInterval(0);
+    secondJob.start();
+    document->nodes().first()->destroy();
+    secondJob.waitForFinished();
+    QCOMPARE(document->nodePositions().count(), 99);
+
+    document->destroy();
+}
+
+void TestLayout::testLayoutJobCancel()
+{
+    const QVector<QPointF> start = startPositions(2500, 1000);
+    GraphDocumentPtr document = createGrid(50, start);
+
+    LayoutJob job(LayoutJob::ForceDirected, document->nodes());
+    QSignalSpy finishedSpy(&job, &LayoutJob::finished);
+    job.start();
+    job.cancel();
+    QVERIFY(finishedSpy.wait());
+    QVERIFY(job.isCanceled());
+    QCOMPARE(document->nodePositions(), start);
+
+    // jobs do not keep destroyed documents alive
+    LayoutJob secondJob(LayoutJob::ForceDirected, document->nodes());
+    secondJob.start();
+    document->destroy();
+    document.reset();
+    secondJob.waitForFinished();
+    QVERIFY(secondJob.isCanceled());
+    QCOMPARE(GraphDocument::objects(), uint(0));
+}
+
+QTEST_MAIN(TestLayout)
@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_spatialindex.h"
+#include "libgraphtheory/graphdocument.h"
+#include "libgraphtheory/node.h"
+#include "libgraphtheory/edge.h"
+#include "libgraphtheory/models/spatialindex.h"
+
+#include <QTest>
+
+using namespace GraphTheory;
+
+namespace
+{
+// creates a document with a row of @p count nodes at distance 100, connected by a path
+GraphDocumentPtr createRow(int count)
+{
+    GraphDocumentPtr document = GraphDocument::create();
+    NodePtr previous;
+    for (int i = 0; i < count; ++i) {
+        NodePtr node = Node::create(document);
+        node->setX(i * 100);
+        node->setY(0);
+        if (previous) {
+            Edge::create(previous, node);
+        }
+        previous = node;
+    }
+    return document;
+}
+}
+
+void TestSpatialIndex::initTestCase()
+{
+    QVERIFY(GraphDocument::objects() == 0);
+}
+
+void TestSpatialIndex::cleanupTestCase()
+{
+    QVERIFY(GraphDocument::objects() == 0);
+}
+
+void TestSpatialIndex::testNodeQueries()
+{
+    GraphDocumentPtr document = createRow(10);
+    SpatialIndex index;
+    index.setDocument(document);
+
+    QCOMPARE(index.nodesIn(QRectF(150, -10, 300, 20)), QList<int>() << 2 << 3 << 4);
+    QCOMPARE(index.nodesIn(QRectF(450, 10, -300, -20)), QList<int>() << 2 << 3 << 4);
+    QCOMPARE(index.nodesIn(QRectF(-1e6, -1e6, 2e6, 2e6)).count(), 10);
+    QVERIFY(index.nodesIn(QRectF(150, 10, 300, 20)).isEmpty());
+
+    QCOMPARE(index.nodeAt(QPointF(305, 5), 16), 3);
+    QCOMPARE(index.nodeAt(QPointF(340, 0), 16), -1);
+    QCOMPARE(index.nodeAt(QPointF(340, 0), 60), 3);
+
+    // moved nodes are found at their new position
+    document->nodes().at(3)->setX(1000);
+    document->nodes().at(3)->setY(1000);
+    QCOMPARE(index.nodeAt(QPointF(300, 0), 16), -1);
+    QCOMPARE(index.nodeAt(QPointF(1000, 1000), 16), 3);
+
+    document->destroy();
+}
+
+void TestSpatialIndex::testEdgeQueries()
+{
+    GraphDocumentPtr document = createRow(3);
+    NodePtr far = Node::create(document);
+    far->setX(5000);
+    far->setY(3000);
+    EdgePtr diagonal = Edge::create(document->nodes().first(), far);
+    SpatialIndex index;
+    index.setDocument(document);
+
+    // points on and close to the long diagonal edge
+    QCOMPARE(index.edgeAt(QPointF(2500, 1500), 2), diagonal->documentIndex());
+    QCOMPARE(index.edgeAt(QPointF(2500, 1505), 10), diagonal->documentIndex());
+    QCOMPARE(index.edgeAt(QPointF(2500, 1600), 10), -1);
+    QCOMPARE(index.edgeAt(QPointF(150, 3), 5), 1);
+    QCOMPARE(index.edgesIn(QRectF(2400, 1400, 200, 200)), QList<int>() << diagonal->documentIndex());
+    QCOMPARE(index.edgesIn(QRectF(40, -10, 120, 20)).count(), 2);
+
+    // edges follow the positions of their nodes
+    far->setY(0);
+    QCOMPARE(index.edgeAt(QPointF(2500, 1500), 2), -1);
+    QCOMPARE(index.edgeAt(QPointF(2500, 0), 2), diagonal->documentIndex());
+
+    document->destroy();
+}
+
+void TestSpatialIndex::testDocumentChanges()
+{
+    GraphDocumentPtr document = createRow(5);
+    SpatialIndex index;
+    index.setDocument(document);
+
+    // removal moves the last node into the gap
+    NodePtr last = document->nodes().last();
+    document->nodes().at(1)->destroy();
+    QCOMPARE(index.nodeAt(QPointF(100, 0), 16), -1);
+    QCOMPARE(index.nodeAt(QPointF(400, 0), 16), last->documentIndex());
+    QCOMPARE(index.nodesIn(QRectF(-10, -10, 1000, 20)).count(), 4);
+    QCOMPARE(index.edgeAt(QPointF(50, 0), 5), -1);
+    QCOMPARE(index.edgesIn(QRectF(-10, -10, 1000, 20)).count(), 2);
+
+    // added nodes and edges are indexed
+    NodePtr node = Node::create(document);
+    node->setX(100);
+    node->setY(100);
+    EdgePtr edge = Edge::create(node, last);
+    QCOMPARE(index.nodeAt(QPointF(100, 100), 16), node->documentIndex());
+    QCOMPARE(index.edgeAt(QPointF(250, 50), 5), edge->documentIndex());
+
+    // batched position changes
+    QVector<QPointF> positions = document->nodePositions();
+    positions[node->documentIndex()] = QPointF(-500, -500);
+    document->setNodePositions(positions);
+    QCOMPARE(index.nodeAt(QPointF(-500, -500), 16), node->documentIndex());
+    QCOMPARE(index.nodeAt(QPointF(100, 100), 16), -1);
+
+    document->destroy();
+    QVERIFY(index.nodesIn(QRectF(-1000, -1000, 2000, 2000)).isEmpty());
+}
+
+void TestSpatialIndex::testBulkUpdate()
+{
+    GraphDocumentPtr document = createRow(5);
+    SpatialIndex index;
+    index.setDocument(document);
+
+    // queries during a bulk update see the current document
+    {
+        GraphDocument::BulkUpdateGuard bulkUpdate(document);
+        QCOMPARE(index.nodesIn(QRectF(-10, -10, 1000, 20)).count(), 5);
+        document->nodes().at(1)->destroy();
+        NodePtr node = Node::create(document);
+        node->setX(100);
+        node->setY(100);
+        QCOMPARE(index.nodeAt(QPointF(100, 100), 16), node->documentIndex());
+        QCOMPARE(index.nodeAt(QPointF(100, 0), 16), -1);
+        QCOMPARE(index.nodesIn(QRectF(-10, -10, 1000, 20)).count(), 4);
+        node->destroy();
+    }
+    QCOMPARE(index.nodesIn(QRectF(-1000, -1000, 2000, 2000)).count(), 4);
+    QCOMPARE(index.nodeAt(QPointF(100, 100), 16), -1);
+
+    document->destroy();
+}
+
+QTEST_MAIN(TestSpatialIndex)
@@ -19,19 +19,22 @@
  */
 
 #include "edge.h"
+#include "graphdocument.h"
 #include "edgetypestyle.h"
 #include "logging_p.h"
+#include <QVector>
 #include <QVariant>
 
 using namespace GraphTheory;
 
 // initialize number of edge objects
-uint Edge::objectCounter = 0;
+QAtomicInteger<uint> Edge::objectCounter(0);
 
 class GraphTheory::EdgePrivate {
 public:
     EdgePrivate()
         : m_valid(false)
+        , m_documentIndex(-1)
     {
     }
 
@@ -44,12 +47,19 @@ public:
     NodePtr m_to;
     EdgeTypePtr m_type;
     bool m_valid;
+    int m_documentIndex;
+    QVector<QVariant> m_dynamicValues;
 };
 
 Edge::Edge()
     : QObject()
     , d(new EdgePrivate)
 {
+    connect(this, &Edge::dynamicPropertyAdded,
+        this, &Edge::dynamicPropertiesChanged);
+    connect(this, &Edge::dynamicPropertyRemoved,
+        this, &Edge::dynamicPropertiesChanged);
+
     ++Edge::objectCounter;
 }
 
@@ -99,6 +109,16 @@ bool Edge::isValid() const
     return d->m_valid;
 }
 
+int Edge::documentIndex() const
+{
+    return d->m_documentIndex;
+}
+
+void Edge::setDocumentIndex(int index)
+{
+    d->m_documentIndex = index;
+}
+
 NodePtr Edge::from() const
 {
     return d->m_from;
@@ -124,18 +144,29 @@ void Edge::setType(EdgeTypePtr type)
     if (d->m_type) {
         d->m_type->disconnect(this);
         d->m_type->style()->disconnect(this);
+
+        // move values to the slots of the new type, properties unknown to it are dropped
+        QVector<QVariant> values(type->dynamicProperties().count());
+        for (int i = 0; i < d->m_dynamicValues.count(); ++i) {
+            const int index = type->dynamicPropertyIndex(d->m_type->dynamicProperties().at(i));
+            if (index >= 0) {
+                values[index] = d->m_dynamicValues.at(i);
+            }
+        }
+        d->m_dynamicValues = values;
     }
     d->m_type = type;
+    d->m_from->document()->invalidateSnapshots();
     connect(type.data(), &EdgeType::dynamicPropertyAboutToBeAdded,
         this, &Edge::dynamicPropertyAboutToBeAdded);
     connect(type.data(), &EdgeType::dynamicPropertyAdded,
         this, &Edge::dynamicPropertyAdded);
     connect(type.data(), &EdgeType::dynamicPropertiesAboutToBeRemoved,
         this, &Edge::dynamicPropertiesAboutToBeRemoved);
+    connect(type.data(), &EdgeType::dynamicPropertiesAboutToBeRemoved,
+        this, &Edge::removeDynamicPropertyValues);
     connect(type.data(), &EdgeType::dynamicPropertyRemoved,
         this, &Edge::dynamicPropertyRemoved);
-    connect(type.data(), &EdgeType::dynamicPropertyRemoved,
-        this, &Edge::updateDynamicProperty);
     connect(type.data(), &EdgeType::directionChanged,
         this, &Edge::directionChanged);
     connect(type.data(), &EdgeType::dynamicPropertyRenamed,
@@ -149,11 +180,22 @@ void Edge::setType(EdgeTypePtr type)
 
 QVariant Edge::dynamicProperty(const QString &property) const
 {
-    return Edge::property(("_graph_" + property).toLatin1());
+    if (!d->m_type) {
+        return QVariant();
+    }
+    return dynamicProperty(d->m_type->dynamicPropertyIndex(property));
+}
+
+QVariant Edge::dynamicProperty(int index) const
+{
+    return d->m_dynamicValues.value(index);
 }
 
 QStringList Edge::dynamicProperties() const
 {
+    if (!d->m_type) {
+        return QStringList();
+    }
     return d->m_type->dynamicProperties();
 }
 
@@ -161,29 +203,57 @@ void Edge::setDynamicProperty(const QString &property, const QVariant &value)
 {
     if (!d->m_type) {
         qCWarning(GRAPHTHEORY_GENERAL) << "No type registered, aborting to set property.";
+        return;
     }
-    if (value.isValid() && !d->m_type->dynamicProperties().contains(property)) {
-        qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+    const int index = d->m_type->dynamicPropertyIndex(property);
+    if (index < 0) {
+        if (value.isValid()) {
+            qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+        }
+        return;
+    }
+    setDynamicProperty(index, value);
+}
+
+void Edge::setDynamicProperty(int index, const QVariant &value)
+{
+    Q_ASSERT(d->m_type);
+    Q_ASSERT(index >= 0 && index < d->m_type->dynamicProperties().count());
+    if (!storeDynamicProperty(index, value)) {
+        return;
     }
-    setProperty(("_graph_" + property).toLatin1(), value);
-    emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(property));
+    d->m_from->document()->invalidateSnapshots();
+    emit dynamicPropertyChanged(index);
 }
 
-void Edge::updateDynamicProperty(const QString &property)
+bool Edge::storeDynamicProperty(int index, const QVariant &value)
 {
-    // remove property if not registered at type
-    if (!d->m_type->dynamicProperties().contains(property)) {
-        setDynamicProperty(property, QVariant::Invalid);
+    if (index < 0 || index >= d->m_type->dynamicProperties().count()) {
+        return false;
+    }
+    // slots are only allocated up to the last set property
+    if (index >= d->m_dynamicValues.count()) {
+        if (!value.isValid()) {
+            return false;
+        }
+        d->m_dynamicValues.resize(index + 1);
     }
+    d->m_dynamicValues[index] = value;
+    return true;
+}
 
-    emit dynamicPropertiesChanged();
+void Edge::removeDynamicPropertyValues(int first, int last)
+{
+    if (first < d->m_dynamicValues.count()) {
+        d->m_dynamicValues.remove(first, qMin(last, d->m_dynamicValues.count() - 1) - first + 1);
+    }
 }
 
 void Edge::renameDynamicProperty(const QString &oldProperty, const QString &newProperty)
 {
-    setDynamicProperty(newProperty, dynamicProperty(oldProperty));
-    setDynamicProperty(oldProperty, QVariant::Invalid);
-    emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(newProperty));
+    Q_UNUSED(oldProperty);
+    // values are stored by slot, which is preserved by renaming
+    emit dynamicPropertyChanged(d->m_type->dynamicPropertyIndex(newProperty));
 }
 
 void Edge::setQpointer(EdgePtr q)
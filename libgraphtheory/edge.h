@@ -27,6 +27,7 @@
 #include "node.h"
 
 #include <QObject>
+#include <QAtomicInteger>
 #include <QSharedPointer>
 
 namespace GraphTheory
@@ -74,6 +75,14 @@ public:
      */
     bool isValid() const;
 
+    /**
+     * The document index is the position of the edge in GraphDocument::edges(). It is maintained
+     * by the document and may change whenever another edge is removed from the document.
+     *
+     * @return position of the edge in its document or -1 if edge is not contained in document
+     */
+    int documentIndex() const;
+
     /**
      * @return the Node the edge points from
      */
@@ -105,6 +114,15 @@ public:
      */
     QVariant dynamicProperty(const QString &property) const;
 
+    /**
+     * Access dynamic property by its slot @p index as given by EdgeType::dynamicPropertyIndex().
+     * Use this method instead of the name based lookup when accessing the same property for
+     * many elements.
+     *
+     * @return return value of dynamic property, value is QVariant::Invalid if it is not set
+     */
+    QVariant dynamicProperty(int index) const;
+
     /**
      * @return list of dynamic properties registered at edge type
      */
@@ -112,8 +130,9 @@ public:
 
     /**
      * Set dynamic property with identifier @c property. If @c value is
-     * QVariant::Invalid, the dynamic property is unset. Internally, this
-     * method use the QObject::setProperty mechanism but prefixes properties to avoid name clashes.
+     * QVariant::Invalid, the dynamic property is unset. The property must be registered at the
+     * edge type, otherwise the value is not stored. Values are kept in one slot per registered
+     * property, see EdgeType::dynamicPropertyIndex().
      *
      * @param property is the identifier for the new property
      * @param value is the value of this property
@@ -121,7 +140,16 @@ public:
     void setDynamicProperty(const QString &property, const QVariant &value);
 
     /**
-     * Rename dynamic property from identifier @c oldProperty to @c newProperty.
+     * Set dynamic property with slot @p index as given by EdgeType::dynamicPropertyIndex().
+     *
+     * @param index is the slot of the property
+     * @param value is the value of this property
+     */
+    void setDynamicProperty(int index, const QVariant &value);
+
+    /**
+     * Notify about renaming of dynamic property from identifier @c oldProperty to @c newProperty
+     * at the type. The value is preserved, since its slot does not change by renaming.
      *
      * @param oldProperty the former value of the property
      * @param newProperty the new value of the property
@@ -135,7 +163,7 @@ public:
      */
     static uint objects()
     {
-        return objectCounter;
+        return objectCounter.load();
     }
 
 Q_SIGNALS:
@@ -155,7 +183,7 @@ Q_SIGNALS:
     void styleChanged();
 
 private Q_SLOTS:
-    void updateDynamicProperty(const QString &property);
+    void removeDynamicPropertyValues(int first, int last);
 
 protected:
     Edge();
@@ -164,7 +192,12 @@ private:
     Q_DISABLE_COPY(Edge)
     const QScopedPointer<EdgePrivate> d;
     void setQpointer(EdgePtr q);
-    static uint objectCounter;
+    void setDocumentIndex(int index);
+    /** store value of dynamic property slot @p index without notification, @return true if stored **/
+    bool storeDynamicProperty(int index, const QVariant &value);
+    static QAtomicInteger<uint> objectCounter;
+
+    friend class GraphDocument;
 };
 }
 
@@ -22,11 +22,12 @@
 #include "edgetypestyle.h"
 #include "graphdocument.h"
 #include <QDebug>
+#include <QHash>
 
 using namespace GraphTheory;
 
 // initialize number of edge type objects
-uint EdgeType::objectCounter = 0;
+QAtomicInteger<uint> EdgeType::objectCounter(0);
 
 class GraphTheory::EdgeTypePrivate {
 public:
@@ -49,6 +50,7 @@ public:
     GraphDocumentPtr m_document;
     int m_id;
     QStringList m_dynamicProperties;
+    QHash<QString, int> m_dynamicPropertyIndices;
     EdgeTypeStyle *m_style;
     EdgeType::Direction m_direction;
     QString m_name;
@@ -128,7 +130,11 @@ void EdgeType::setId(int id)
     if (id == d->m_id) {
         return;
     }
+    const int oldId = d->m_id;
     d->m_id = id;
+    if (d->m_document) {
+        d->m_document->updateId(d->q, oldId);
+    }
     emit idChanged(id);
 }
 
@@ -142,37 +148,55 @@ QStringList EdgeType::dynamicProperties() const
     return d->m_dynamicProperties;
 }
 
+int EdgeType::dynamicPropertyIndex(const QString &property) const
+{
+    return d->m_dynamicPropertyIndices.value(property, -1);
+}
+
 void EdgeType::addDynamicProperty(const QString& property)
 {
-    if (d->m_dynamicProperties.contains(property)) {
+    if (d->m_dynamicPropertyIndices.contains(property)) {
         return;
     }
     emit dynamicPropertyAboutToBeAdded(property, d->m_dynamicProperties.count());
+    d->m_dynamicPropertyIndices.insert(property, d->m_dynamicProperties.count());
     d->m_dynamicProperties.append(property);
     emit dynamicPropertyAdded();
 }
 
 void EdgeType::removeDynamicProperty(const QString& property)
 {
-    if (!d->m_dynamicProperties.contains(property)) {
+    if (!d->m_dynamicPropertyIndices.contains(property)) {
         return;
     }
-    int index = d->m_dynamicProperties.indexOf(property);
+    const int index = d->m_dynamicPropertyIndices.value(property);
     emit dynamicPropertiesAboutToBeRemoved(index, index);
-    d->m_dynamicProperties.removeOne(property);
+    d->m_dynamicProperties.removeAt(index);
+    d->m_dynamicPropertyIndices.remove(property);
+    // all following properties move by one slot
+    for (int i = index; i < d->m_dynamicProperties.count(); ++i) {
+        d->m_dynamicPropertyIndices[d->m_dynamicProperties.at(i)] = i;
+    }
+    if (d->m_document) {
+        d->m_document->invalidateSnapshots();
+    }
     emit dynamicPropertyRemoved(property);
 }
 
 void EdgeType::renameDynamicProperty(const QString& oldProperty, const QString& newProperty)
 {
-    Q_ASSERT(d->m_dynamicProperties.contains(oldProperty));
-    Q_ASSERT(!d->m_dynamicProperties.contains(newProperty));
+    Q_ASSERT(d->m_dynamicPropertyIndices.contains(oldProperty));
+    Q_ASSERT(!d->m_dynamicPropertyIndices.contains(newProperty));
 
-    if (!d->m_dynamicProperties.contains(oldProperty) || d->m_dynamicProperties.contains(newProperty)) {
+    if (!d->m_dynamicPropertyIndices.contains(oldProperty) || d->m_dynamicPropertyIndices.contains(newProperty)) {
         return;
     }
-    int index = d->m_dynamicProperties.indexOf(oldProperty);
+    const int index = d->m_dynamicPropertyIndices.take(oldProperty);
     d->m_dynamicProperties[index] = newProperty;
+    d->m_dynamicPropertyIndices.insert(newProperty, index);
+    if (d->m_document) {
+        d->m_document->invalidateSnapshots();
+    }
     emit dynamicPropertyRenamed(oldProperty, newProperty);
     emit dynamicPropertyChanged(index);
 }
@@ -188,6 +212,9 @@ void EdgeType::setDirection(EdgeType::Direction direction)
         return;
     }
     d->m_direction = direction;
+    if (d->m_document) {
+        d->m_document->invalidateSnapshots();
+    }
     emit directionChanged(direction);
 }
 
@@ -25,6 +25,7 @@
 #include "typenames.h"
 
 #include <QObject>
+#include <QAtomicInteger>
 #include <QSharedPointer>
 
 namespace GraphTheory
@@ -91,6 +92,15 @@ public:
      */
     QStringList dynamicProperties() const;
 
+    /**
+     * Dynamic properties are stored at the edges in dense slots that correspond to the position
+     * of the property in dynamicProperties(). The lookup is performed in constant time, such
+     * that it can be done once before accessing the property of many elements by index.
+     *
+     * @return index of dynamic property @p property or -1 if it is not registered
+     */
+    int dynamicPropertyIndex(const QString &property) const;
+
     /**
      * Add dynamic property @c property to list of dynamic properties.
      * Signal dynamicPropertyAdded(@c property) is emitted afterwards
@@ -152,7 +162,7 @@ public:
      */
     static uint objects()
     {
-        return objectCounter;
+        return objectCounter.load();
     }
 
 Q_SIGNALS:
@@ -173,7 +183,7 @@ private:
     Q_DISABLE_COPY(EdgeType)
     const QScopedPointer<EdgeTypePrivate> d;
     void setQpointer(EdgeTypePtr q);
-    static uint objectCounter;
+    static QAtomicInteger<uint> objectCounter;
 };
 }
 
@@ -71,11 +71,11 @@ GraphDocumentPtr Editor::createDocument()
 
 GraphDocumentPtr Editor::openDocument(const QUrl &documentUrl)
 {
-    // get file extension/format
+    // get file extension/format, only the last one identifies the format of names like "graph.v2.tgf"
     QFileInfo fi(documentUrl.toLocalFile());
-    QString ext = fi.completeSuffix();
+    QString ext = fi.suffix();
 
-    GraphTheory::FileFormatInterface *importer = d->m_fileFormatManager.backendByExtension(ext);
+    GraphTheory::FileFormatInterface *importer = fileFormatBackend(ext);
     if (!importer) {
         qCCritical(GRAPHTHEORY_GENERAL) << "No graph file backend found for extension" << ext << ", aborting.";
         return GraphDocumentPtr();
@@ -83,10 +83,14 @@ GraphDocumentPtr Editor::openDocument(const QUrl &documentUrl)
     importer->setFile(documentUrl);
     importer->readFile();
     if (importer->hasError()) {
-        qCCritical(GRAPHTHEORY_GENERAL) << "Graph file importer reported the following error, aborting.";
-        importer->errorString();
+        qCCritical(GRAPHTHEORY_GENERAL) << "Graph file importer reported the following error, aborting:" << importer->errorString();
         return GraphDocumentPtr();
     }
     importer->graphDocument()->setDocumentUrl(documentUrl);
     return importer->graphDocument();
 }
+
+FileFormatInterface * Editor::fileFormatBackend(const QString &extension) const
+{
+    return d->m_fileFormatManager.backendByExtension(extension);
+}
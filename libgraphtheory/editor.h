@@ -31,6 +31,7 @@ class QQmlEngine;
 namespace GraphTheory
 {
 class EditorPrivate;
+class FileFormatInterface;
 
 class GRAPHTHEORY_EXPORT Editor : public QObject
 {
@@ -48,6 +49,12 @@ public:
      */
     GraphDocumentPtr openDocument(const QUrl &documentUrl);
 
+    /**
+     * @return file format backend of this editor for files with extension @p extension,
+     *         or null if no backend supports the extension
+     */
+    FileFormatInterface * fileFormatBackend(const QString &extension) const;
+
 Q_SIGNALS:
     void documentCreated(GraphDocumentPtr document);
 
@@ -24,6 +24,7 @@
 #include "graphdocument.h"
 #include "edge.h"
 #include "modifiers/topology.h"
+#include "modifiers/layoutjob.h"
 #include "logging_p.h"
 
 #include <KLocalizedString>
@@ -33,6 +34,7 @@
 #include <QList>
 #include <QMap>
 #include <QPair>
+#include <QRectF>
 #include <QButtonGroup>
 
 #include <cmath>
@@ -42,7 +44,6 @@
 #include <boost/graph/random.hpp>
 #include <boost/graph/random_layout.hpp>
 #include <boost/graph/topology.hpp>
-#include <boost/graph/fruchterman_reingold.hpp>
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/graph/erdos_renyi_generator.hpp>
 #include <boost/math/constants/constants.hpp>
@@ -71,6 +72,18 @@ namespace boost {
     }
 }
 
+namespace
+{
+// arranges @p nodes by a force directed layout inside @p rect, while the dialog is already closed
+void startForceDirectedLayout(GraphDocumentPtr document, const NodeList &nodes, const QRectF &rect)
+{
+    LayoutJob *job = new LayoutJob(LayoutJob::ForceDirected, nodes, document.data());
+    job->setBoundingRect(rect);
+    QObject::connect(job, &LayoutJob::finished, job, &QObject::deleteLater);
+    job->start();
+}
+}
+
 
 GenerateGraphWidget::GenerateGraphWidget(GraphDocumentPtr document, QWidget *parent)
     : QDialog(parent)
@@ -187,6 +200,9 @@ void GenerateGraphWidget::generateGraph()
 {
     setGraphIdentifier(ui->identifier->text());
 
+    // announce all generated nodes and edges at once to the views
+    GraphDocument::BulkUpdateGuard bulkUpdate(m_document);
+
     switch (m_graphGenerator) {
     case MeshGraph:
         generateMesh(ui->meshRows->value(), ui->meshColumns->value());
@@ -372,29 +388,27 @@ void GenerateGraphWidget::generateRandomGraph(int nodes, int edges, bool selfEdg
 
     boost::random_graph_layout(randomGraph, positionMap, topology);
 
-    // minimize cuts by Fruchtman-Reingold layout algorithm
-    boost::fruchterman_reingold_force_directed_layout< boost::rectangle_topology< boost::mt19937 >, Graph, PositionMap >
-    (randomGraph,
-     positionMap,
-     topology,
-     boost::cooling(boost::linear_cooling<double>(100))
-    );
-
     // put nodes at whiteboard as generated
     QMap<int, NodePtr > mapNodes;
     boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
     for (boost::tie(vi, vi_end) = boost::vertices(randomGraph); vi != vi_end; ++vi) {
         mapNodes[*vi] = Node::create(m_document);
-        mapNodes[*vi]->setX(positionMap[*vi][0]);
-        mapNodes[*vi]->setY(positionMap[*vi][1]);
         mapNodes[*vi]->setType(m_nodeType);
     }
+    QVector<QPointF> positions = m_document->nodePositions();
+    for (boost::tie(vi, vi_end) = boost::vertices(randomGraph); vi != vi_end; ++vi) {
+        positions[mapNodes[*vi]->documentIndex()] = QPointF(positionMap[*vi][0], positionMap[*vi][1]);
+    }
+    m_document->setNodePositions(positions);
 
     boost::graph_traits<Graph>::edge_iterator ei, ei_end;
     for (boost::tie(ei, ei_end) = boost::edges(randomGraph); ei != ei_end; ++ei) {
         EdgePtr edge = Edge::create(mapNodes[boost::source(*ei, randomGraph)], mapNodes[boost::target(*ei, randomGraph)]);
         edge->setType(m_edgeType);
     }
+
+    // minimize cuts by force directed layout
+    startForceDirectedLayout(m_document, mapNodes.values().toVector(), QRectF(center.x() - 20 * nodes, center.y() - 20 * nodes, 40 * nodes, 40 * nodes));
 }
 
 void GenerateGraphWidget::generateErdosRenyiRandomGraph(int nodes, double edgeProbability, bool selfEdges)
@@ -414,29 +428,27 @@ void GenerateGraphWidget::generateErdosRenyiRandomGraph(int nodes, double edgePr
     PositionMap positionMap(position_vec.begin(), get(boost::vertex_index, randomGraph));
     boost::random_graph_layout(randomGraph, positionMap, topology);
 
-    // minimize cuts by Fruchtman-Reingold layout algorithm
-    boost::fruchterman_reingold_force_directed_layout< boost::rectangle_topology< boost::mt19937 >, Graph, PositionMap >
-    (randomGraph,
-     positionMap,
-     topology,
-     boost::cooling(boost::linear_cooling<double>(100))
-    );
-
     // put nodes at whiteboard as generated
     QMap<int, NodePtr > mapNodes;
     boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
     for (boost::tie(vi, vi_end) = boost::vertices(randomGraph); vi != vi_end; ++vi) {
         mapNodes[*vi] = Node::create(m_document);
-        mapNodes[*vi]->setX(positionMap[*vi][0]);
-        mapNodes[*vi]->setY(positionMap[*vi][1]);
         mapNodes[*vi]->setType(m_nodeType);
     }
+    QVector<QPointF> positions = m_document->nodePositions();
+    for (boost::tie(vi, vi_end) = boost::vertices(randomGraph); vi != vi_end; ++vi) {
+        positions[mapNodes[*vi]->documentIndex()] = QPointF(positionMap[*vi][0], positionMap[*vi][1]);
+    }
+    m_document->setNodePositions(positions);
 
     boost::graph_traits<Graph>::edge_iterator ei, ei_end;
     for (boost::tie(ei, ei_end) = boost::edges(randomGraph); ei != ei_end; ++ei) {
         EdgePtr edge = Edge::create(mapNodes[boost::source(*ei, randomGraph)], mapNodes[boost::target(*ei, randomGraph)]);
         edge->setType(m_edgeType);
     }
+
+    // minimize cuts by force directed layout
+    startForceDirectedLayout(m_document, mapNodes.values().toVector(), QRectF(center.x() - 20 * nodes, center.y() - 20 * nodes, 40 * nodes, 40 * nodes));
 }
 
 void GenerateGraphWidget::generateRandomTreeGraph(int number)
@@ -445,14 +457,17 @@ void GenerateGraphWidget::generateRandomTreeGraph(int number)
     gen.seed(static_cast<unsigned int>(m_seed));
 
     NodeList nodes;
+    const QPointF center = documentCenter();
 
     NodePtr node = Node::create(m_document);
     node->setType(m_nodeType);
+    node->setX(center.x());
+    node->setY(center.y());
     nodes.append(node);
 
     for (int i = 1; i < number; ++i) {
         NodePtr thisNode = Node::create(m_document);
-        node->setType(m_nodeType);
+        thisNode->setType(m_nodeType);
         boost::random::uniform_int_distribution<> randomEarlierNodeGen(0, i-1);
         int randomEarlierNode = randomEarlierNodeGen(gen);
         EdgePtr edge = Edge::create(thisNode, nodes.at(randomEarlierNode));
@@ -464,6 +479,7 @@ void GenerateGraphWidget::generateRandomTreeGraph(int number)
         nodes.append(thisNode);
     }
 
+    // only arrange the new tree around its root, the existing nodes keep their positions
     Topology topology = Topology();
-    topology.directedGraphDefaultTopology(m_document);
+    topology.applyIncrementalAlignment(nodes);
 }
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "graphlayoutwidget.h"
+#include "typenames.h"
+#include "graphdocument.h"
+#include "modifiers/topology.h"
+#include "modifiers/layoutjob.h"
+
+#include <KLocalizedString>
+#include <QPushButton>
+
+using namespace GraphTheory;
+
+GraphLayoutWidget::GraphLayoutWidget(GraphDocumentPtr document, QWidget *parent)
+    : QDialog(parent)
+    , m_document(document)
+    , m_job(nullptr)
+{
+    setWindowTitle(i18nc("@title:window", "Graph Layout"));
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    setLayout(mainLayout);
+
+    QWidget *widget = new QWidget(this);
+    ui = new Ui::GraphLayoutWidget;
+    ui->setupUi(widget);
+    mainLayout->addWidget(widget);
+
+    connect(ui->buttons, &QDialogButtonBox::accepted, this, &GraphLayoutWidget::applyLayout);
+    connect(ui->buttons, &QDialogButtonBox::rejected, this, &GraphLayoutWidget::reject);
+}
+
+GraphLayoutWidget::~GraphLayoutWidget()
+{
+    delete ui;
+}
+
+void GraphLayoutWidget::applyLayout()
+{
+    if (m_job) {
+        return;
+    }
+    if (ui->radioButtonLayered->isChecked()) {
+        Topology topology;
+        topology.applyLayeredAlignment(m_document->nodes());
+        accept();
+        return;
+    }
+    if (ui->radioButtonCircle->isChecked()) {
+        Topology topology;
+        topology.applyCircleAlignment(m_document->nodes());
+        accept();
+        return;
+    }
+
+    const LayoutJob::Algorithm algorithm = ui->radioButtonMultilevel->isChecked()
+        ? LayoutJob::Multilevel : LayoutJob::ForceDirected;
+    m_job = new LayoutJob(algorithm, m_document->nodes(), this);
+    connect(m_job, &LayoutJob::finished, this, &GraphLayoutWidget::layoutFinished);
+    ui->buttons->button(QDialogButtonBox::Ok)->setEnabled(false);
+    ui->radioButtonForceDirected->setEnabled(false);
+    ui->radioButtonMultilevel->setEnabled(false);
+    ui->radioButtonLayered->setEnabled(false);
+    ui->radioButtonCircle->setEnabled(false);
+    m_job->start();
+}
+
+void GraphLayoutWidget::reject()
+{
+    if (m_job) {
+        m_job->cancel();
+        return;
+    }
+    QDialog::reject();
+}
+
+void GraphLayoutWidget::layoutFinished()
+{
+    const bool canceled = m_job->isCanceled();
+    m_job->deleteLater();
+    m_job = nullptr;
+    if (canceled) {
+        QDialog::reject();
+    } else {
+        accept();
+    }
+}
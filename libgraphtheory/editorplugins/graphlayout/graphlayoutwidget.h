@@ -0,0 +1,61 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GRAPHLAYOUTWIDGET_H
+#define GRAPHLAYOUTWIDGET_H
+
+#include "ui_graphlayoutwidget.h"
+#include "typenames.h"
+#include <QDialog>
+
+namespace GraphTheory {
+class LayoutJob;
+
+class GraphLayoutWidget : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit GraphLayoutWidget(GraphDocumentPtr document, QWidget *parent = 0);
+    ~GraphLayoutWidget();
+
+public Q_SLOTS:
+    /**
+     * Apply the selected layout to all nodes of the document. Force directed layouts run in the
+     * background and the dialog is closed when they are finished.
+     */
+    void applyLayout();
+
+    /**
+     * Cancel a running layout, otherwise close the dialog.
+     */
+    void reject() Q_DECL_OVERRIDE;
+
+private Q_SLOTS:
+    void layoutFinished();
+
+private:
+    GraphDocumentPtr m_document;
+    LayoutJob *m_job;
+    Ui::GraphLayoutWidget *ui;
+};
+}
+
+#endif
@@ -21,12 +21,15 @@
 #include "transformedgeswidget.h"
 #include "typenames.h"
 #include "graphdocument.h"
+#include "graphsnapshot.h"
 #include "edge.h"
-#include "modifiers/topology.h"
+#include "edgetype.h"
+#include "algorithms/graphalgorithms.h"
+#include "logging_p.h"
 
 #include <KLocalizedString>
-#include <QMap>
 #include <QPair>
+#include <QSet>
 #include <QDebug>
 
 using namespace GraphTheory;
@@ -47,6 +50,19 @@ TransformEdgesWidget::TransformEdgesWidget(GraphDocumentPtr document, QWidget *p
     connect(ui->buttons, &QDialogButtonBox::accepted, this, &TransformEdgesWidget::accept);
     connect(ui->buttons, &QDialogButtonBox::rejected, this, &TransformEdgesWidget::reject);
     connect(this, &QDialog::accepted, this, &TransformEdgesWidget::transform);
+    connect(ui->edgeTypeSelector, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &TransformEdgesWidget::updateWeightProperties);
+
+    for (int i = 0; i < document->edgeTypes().length(); ++i) {
+        EdgeTypePtr type = document->edgeTypes().at(i);
+        QString item = i18nc(
+            "@item:inlistbox",
+            "%1 (ID %2)",
+            type->name(),
+            i);
+        ui->edgeTypeSelector->addItem(item, QVariant(i));
+    }
+    ui->edgeTypeSelector->setCurrentIndex(0);
+    updateWeightProperties(0);
 }
 
 TransformEdgesWidget::~TransformEdgesWidget()
@@ -114,111 +130,42 @@ void TransformEdgesWidget::reverseAllEdges()
     }
 }
 
-qreal TransformEdgesWidget::makeSpanningTree()
+void TransformEdgesWidget::updateWeightProperties(int index)
 {
-    NodeList nodes = m_document->nodes();
-    int n = nodes.size();
-
-    // the resulting spanning tree (MST)
-    QList< QPair<int, int> > MST;
-
-    /*
-     * distance[i] denotes the distance between node i and the minimum spanning
-     * tree; initially this distance is infinity. Note that if i is already element
-     * in MST distance[i] is only a temporary variable and its value is undefined.
-     */
-    QMap<int, qreal> distance;
-    for (int i = 0; i < nodes.size(); i++) {
-        distance[i] = std::numeric_limits<unsigned int>::max();
+    ui->weightPropertySelector->clear();
+    if (index < 0 || index >= m_document->edgeTypes().length()) {
+        return;
     }
-
-    /*
-     * Indicator variable that is true if node is in tree, false otherwise.
-     * Initially all nodes are marked to be not in MST.
-     */
-    QMap<int, bool> inTree;
-    for (int i = 0; i < nodes.size(); i++) {
-        inTree[i] = false;
+    // empty entry: all edges have weight 1
+    ui->weightPropertySelector->addItem(QString());
+    const QStringList properties = m_document->edgeTypes().at(index)->dynamicProperties();
+    ui->weightPropertySelector->addItems(properties);
+    if (properties.contains("value")) {
+        ui->weightPropertySelector->setCurrentIndex(properties.indexOf("value") + 1);
     }
+}
 
-    /* weight[i][j] denotes distance between nodes i and j. If no
-     * path is present between i and j in the previous tree the weight
-     * must be set to 0.
-     */
-    QMap< QPair<int, int>, qreal> weight;
-
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            if (i == j)   weight[QPair<int, int>(i, j)] = 0;
-
-            EdgeList out;
-            out = nodes[i]->edges();
-
-            for (int k = 0; k < out.size(); k++) {
-                if (out[k]->to() == nodes[j]) {
-                    if (!out[k]->property("value").toString().isEmpty())
-                        weight[QPair<int, int>(i, j)] = out[k]->property("value").toDouble();
-                    else
-                        weight[QPair<int, int>(i, j)] = 1;
-
-                }
-            }
-        }
-    }
-
-    /*
-     * successor[i] denotes the index of the node, to which i must be
-     * linked to in order to get distance distance[i]
-     */
-    QMap< int, int> successor;
-
-    // start with first graph node
-    inTree[0] = true;
-
-    // update distances
-    for (int i = 0; i < n; ++i) {
-        if ((weight[QPair<int, int>(0, i)] != 0) && (distance[i] > weight[QPair<int, int>(0, i)])) {
-            distance[i] = weight[QPair<int, int>(0, i)] ;
-            successor[i] = 0;
-        }
+qreal TransformEdgesWidget::makeSpanningTree()
+{
+    const int typeIndex = ui->edgeTypeSelector->currentIndex();
+    if (typeIndex < 0 || typeIndex >= m_document->edgeTypes().length()) {
+        qCWarning(GRAPHTHEORY_GENERAL) << "Edge type " << typeIndex << " does not exist: aborting";
+        return 0;
     }
+    EdgeTypePtr type = m_document->edgeTypes().at(typeIndex);
+    GraphSnapshotPtr graph = m_document->snapshot(type, ui->weightPropertySelector->currentText());
 
     qreal total = 0;
-    for (int treeSize = 1; treeSize < n; treeSize++) {
-        // Find node with the smallest distance to the tree
-        int min = -1;
-        for (int i = 0; i < n; ++i) {
-            if (inTree[i] == false) {
-                if ((min == -1) || (distance[min] > distance[i])) {
-                    min = i;
-                }
-            }
-        }
-
-        // add node to tree
-        MST << QPair<int, int>(successor[min], min);
-        inTree[min] = 1;
-        total += distance[min];
-
-        // update distances
-        for (int i = 0; i < n; ++i) {
-            if ((weight[QPair<int, int>(min, i)]  != 0) && (distance[i] > weight[QPair<int, int>(min, i)])) {
-                distance[i] = weight[QPair<int, int>(min, i)];
-                successor[i] = min;
-            }
-        }
+    QSet<Edge*> tree;
+    foreach (int arc, GraphAlgorithms::minimumSpanningForest(graph, &total)) {
+        tree.insert(graph->edge(arc).data());
     }
 
-    removeAllEdges();
-
-    // refill with MST edges
-    for (int i = 0; i < MST.size(); i++) {
-        EdgePtr edge = Edge::create(nodes[MST[i].first], nodes[MST[i].second]);
-
-        if (weight[QPair<int, int>(MST[i].first, MST[i].second)] != 1) {
-            QString value;
-            value.setNum(weight[QPair<int, int>(MST[i].first, MST[i].second)]);
-            edge->setDynamicProperty("value", value);
+    // remove all other edges of this type, the tree edges keep their properties
+    GraphDocument::BulkUpdateGuard bulkUpdate(m_document);
+    foreach (EdgePtr edge, m_document->edges(type)) {
+        if (!tree.contains(edge.data())) {
+            edge->destroy();
         }
     }
 
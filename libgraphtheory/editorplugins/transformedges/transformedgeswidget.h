@@ -38,6 +38,12 @@ public:
 public Q_SLOTS:
     void transform();
 
+private Q_SLOTS:
+    /**
+     * Offer the dynamic properties of edge type at position \p index as weight properties.
+     */
+    void updateWeightProperties(int index);
+
 private:
     /**
      * Create edges between all nodes.
@@ -55,9 +61,10 @@ private:
     void reverseAllEdges();
 
     /**
-     * Transform given graph to a spanning tree by executing Prim's minimum spanning tree (MST)
-     * algorithm. All edges are assumed to have weight 1 if no weights are given. Otherwise,
-     * with given weights the specified values are used.
+     * Transform given graph to a spanning tree by executing Kruskal's minimum spanning tree (MST)
+     * algorithm on the edges of the selected edge type. Edges of that type that are not part of
+     * the MST are removed. Weights are read from the selected dynamic property; edges without
+     * numeric weight are assumed to have weight 1.
      *
      * \return  total weight of MST
      */
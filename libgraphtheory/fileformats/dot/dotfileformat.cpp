@@ -61,6 +61,7 @@ void DotFileFormat::readFile()
 {
     GraphDocumentPtr document = GraphDocument::create();
     setGraphDocument(document);
+    GraphDocument::BulkUpdateGuard bulkUpdate(document);
 
     QList < QPair<QString, QString> > edges;
     QFile fileHandle(file().toLocalFile());
@@ -122,14 +123,18 @@ QString DotFileFormat::processEdge(EdgePtr edge) const
         edgeStr.append("[");
         edgeStr.append(QString(" label = \"%2\" ").arg(edge->property("name").toString()));
     }
-    foreach(const QByteArray& property, edge->dynamicPropertyNames()) {
+    const QStringList edgeProperties = edge->dynamicProperties();
+    for (int i = 0; i < edgeProperties.count(); ++i) {
+        if (!edge->dynamicProperty(i).isValid()) {
+            continue;
+        }
         if (firstProperty == true) {
                 firstProperty = false;
                 edgeStr.append("[");
             } else {
                 edgeStr.append(", ");
         }
-        edgeStr.append(QString(" %1 = \"%2\" ").arg(QString(property)).arg(edge->property(property).toString()));
+        edgeStr.append(QString(" %1 = \"%2\" ").arg(edgeProperties.at(i)).arg(edge->dynamicProperty(i).toString()));
     }
     if (!firstProperty) { // at least one property was inserted
         edgeStr.append("]");
@@ -148,9 +153,13 @@ QString DotFileFormat::processNode(NodePtr node) const
         nodeStr.append(QString("label=\"%1\" ").arg(node->dynamicProperty("name").toString()));
     }
 
-    foreach(const QByteArray& property, node->dynamicPropertyNames()) {
+    const QStringList nodeProperties = node->dynamicProperties();
+    for (int i = 0; i < nodeProperties.count(); ++i) {
+        if (!node->dynamicProperty(i).isValid()) {
+            continue;
+        }
         nodeStr.append(", ");
-        nodeStr.append(QString(" %1 = \"%2\" ").arg(QString(property)).arg(node->property(property).toString()));
+        nodeStr.append(QString(" %1 = \"%2\" ").arg(nodeProperties.at(i)).arg(node->dynamicProperty(i).toString()));
     }
 
     // at least one property was inserted
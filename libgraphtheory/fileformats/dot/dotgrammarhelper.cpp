@@ -86,13 +86,13 @@ void DotGraphParsingHelper::setNodeAttributes()
     AttributesMap::ConstIterator iter;
     iter = nodeAttributes.constBegin();
     for (; iter != nodeAttributes.constEnd(); ++iter) {
-        if (!currentNode->dynamicProperties().contains(iter.key())) {
-            currentNode->type()->addDynamicProperty(iter.key());
-        }
         QString key = iter.key(); // do not overwrite labels
         if (key == "name") {
             key = "dot_name";
         }
+        if (!currentNode->dynamicProperties().contains(key)) {
+            currentNode->type()->addDynamicProperty(key);
+        }
         currentNode->setDynamicProperty(key, iter.value());
     }
 }
@@ -194,10 +194,10 @@ void DotGraphParsingHelper::createEdge()
         // if necessary create from id
         if (!nodeMap.contains(fromId)) {
             NodePtr from = Node::create(document);
-            from->setDynamicProperty("name", fromId);
-            if (from->dynamicProperties().contains("name")) {
+            if (!from->dynamicProperties().contains("name")) {
                 from->type()->addDynamicProperty("name");
             }
+            from->setDynamicProperty("name", fromId);
             nodeMap.insert(fromId, from);
             currentNode = from;
             setNodeAttributes();
@@ -207,7 +207,7 @@ void DotGraphParsingHelper::createEdge()
         // if necessary create to node
         if (!nodeMap.contains(toId)) {
             NodePtr to = Node::create(document);
-            if (to->dynamicProperties().contains("name")) {
+            if (!to->dynamicProperties().contains("name")) {
                 to->type()->addDynamicProperty("name");
             }
             to->setDynamicProperty("name", toId);
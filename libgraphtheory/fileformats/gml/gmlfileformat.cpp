@@ -60,6 +60,7 @@ void GmlFileFormat::readFile()
 {
     GraphDocumentPtr document = GraphDocument::create();
     setGraphDocument(document);
+    GraphDocument::BulkUpdateGuard bulkUpdate(document);
 
     QList < QPair<QString, QString> > edges;
     QFile fileHandle(file().toLocalFile());
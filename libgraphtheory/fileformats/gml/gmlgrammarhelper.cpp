@@ -114,6 +114,7 @@ void GmlGrammarHelper::setAttribute(const QString& key, const QString& value)
             QString joined = attributeStack.join(".");
             joined.append('.').append(key);
             if (currentEdge) {
+                currentEdge->type()->addDynamicProperty(joined);
                 currentEdge->setDynamicProperty(joined, value);
             } else {
                 edgeAttributes.insert(joined, value);
@@ -127,6 +128,7 @@ void GmlGrammarHelper::setAttribute(const QString& key, const QString& value)
         } else if (currentEdge) {      //if edge was created.
 //               if(!currentEdge->setProperty(processKey(key).toAscii(),value)){
             qCDebug(GRAPHTHEORY_FILEFORMAT) << "inserting edge key: " << key;
+            currentEdge->type()->addDynamicProperty(processKey(key));
             currentEdge->setDynamicProperty(processKey(key), value);
 // //               }
         } else {
@@ -142,6 +144,7 @@ void GmlGrammarHelper::setAttribute(const QString& key, const QString& value)
         } else {
             qCDebug(GRAPHTHEORY_FILEFORMAT) << "seting property to node" << key << value;
 //           if(!currentNode->setProperty(processKey(key).toAscii(),value)){
+            currentNode->type()->addDynamicProperty(processKey(key));
             currentNode->setDynamicProperty(processKey(key), value);
 //           }
         }
@@ -180,6 +183,7 @@ void GmlGrammarHelper::createEdge()
         edgeTarget.clear();
         while (!edgeAttributes.isEmpty()) {
             QString property = edgeAttributes.keys().at(0);
+            currentEdge->type()->addDynamicProperty(property);
             currentEdge->setDynamicProperty(property, edgeAttributes.value(property));
             edgeAttributes.remove(property);
         }
@@ -67,6 +67,7 @@ const QStringList Rocs1FileFormat::extensions() const
 void Rocs1FileFormat::readFile()
 {
     GraphDocumentPtr document = GraphDocument::create();
+    GraphDocument::BulkUpdateGuard bulkUpdate(document);
 
     QFile fileHandle(file().toLocalFile());
     document->setDocumentUrl(file());
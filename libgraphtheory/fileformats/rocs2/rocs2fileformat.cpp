@@ -76,6 +76,7 @@ void Rocs2FileFormat::readFile()
     GraphDocumentPtr document = GraphDocument::create();
     document->remove(document->nodeTypes().first());
     document->remove(document->edgeTypes().first());
+    GraphDocument::BulkUpdateGuard bulkUpdate(document);
 
     QJsonDocument jsonDoc = QJsonDocument::fromJson(fileContent);
     QJsonObject jsonObj = jsonDoc.object();
@@ -128,14 +129,7 @@ void Rocs2FileFormat::readFile()
         NodePtr node = Node::create(document);
 
         // set type
-        NodeTypePtr typeToSet;
-        //TODO this is not very efficient for big files: use table instead to cache IDs
-        foreach (NodeTypePtr type, document->nodeTypes()) {
-            if (type->id() == nodeJson["Type"].toInt()) {
-                typeToSet = type;
-                break;
-            }
-        }
+        NodeTypePtr typeToSet = document->nodeType(nodeJson["Type"].toInt());
         if (!typeToSet) {
             qCCritical(GRAPHTHEORY_FILEFORMAT) << "No type found with this ID, defaulting to first found type";
             typeToSet = document->nodeTypes().first();
@@ -161,16 +155,8 @@ void Rocs2FileFormat::readFile()
         QJsonObject edgeJson = edgesJson.at(index).toObject();
 
         // find nodes to connect to
-        NodePtr fromNode, toNode;
-        //TODO this is not very efficient for big files: use table instead to cache IDs
-        foreach (NodePtr node, document->nodes()) {
-            if (node->id() == edgeJson["From"].toInt()) {
-                fromNode = node;
-            }
-            if (node->id() == edgeJson["To"].toInt()) {
-                toNode = node;
-            }
-        }
+        NodePtr fromNode = document->node(edgeJson["From"].toInt());
+        NodePtr toNode = document->node(edgeJson["To"].toInt());
         if (!fromNode || !toNode) {
             qCCritical(GRAPHTHEORY_FILEFORMAT) << "No type found with this ID, aborting edge from"
                 << edgeJson["From"].toInt() << "to" << edgeJson["To"].toInt();
@@ -179,14 +165,7 @@ void Rocs2FileFormat::readFile()
         EdgePtr edge = Edge::create(fromNode, toNode);
 
         // set type
-        EdgeTypePtr typeToSet;
-        //TODO this is not very efficient for big files: use table instead to cache IDs
-        foreach (EdgeTypePtr type, document->edgeTypes()) {
-            if (type->id() == edgeJson["Type"].toInt()) {
-                typeToSet = type;
-                break;
-            }
-        }
+        EdgeTypePtr typeToSet = document->edgeType(edgeJson["Type"].toInt());
         if (!typeToSet) {
             qCCritical(GRAPHTHEORY_FILEFORMAT) << "No type found with this ID, defaulting to first found type";
             typeToSet = document->edgeTypes().first();
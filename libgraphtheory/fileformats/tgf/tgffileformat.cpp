@@ -57,6 +57,7 @@ const QStringList TgfFileFormat::extensions() const
 void TgfFileFormat::readFile()
 {
     GraphDocumentPtr document = GraphDocument::create();
+    GraphDocument::BulkUpdateGuard bulkUpdate(document);
     document->nodeTypes().first()->addDynamicProperty("label");
     document->edgeTypes().first()->addDynamicProperty("label");
 
@@ -19,6 +19,7 @@
  */
 
 #include "graphdocument.h"
+#include "graphsnapshot.h"
 #include "view.h"
 #include "edgetype.h"
 #include "nodetype.h"
@@ -28,11 +29,13 @@
 #include <KLocalizedString>
 #include <QSurfaceFormat>
 #include <QString>
+#include <QMultiHash>
+#include <QPair>
 
 using namespace GraphTheory;
 
 // initialize number of edge objects
-uint GraphDocument::objectCounter = 0;
+QAtomicInteger<uint> GraphDocument::objectCounter(0);
 
 class GraphTheory::GraphDocumentPrivate {
 public:
@@ -43,6 +46,9 @@ public:
         , m_name(QString())
         , m_lastGeneratedId(0)
         , m_modified(false)
+        , m_bulkUpdateDepth(0)
+        , m_nodesRevision(0)
+        , m_edgesRevision(0)
     {
     }
 
@@ -56,12 +62,21 @@ public:
     QList<EdgeTypePtr> m_edgeTypes;
     QList<NodeTypePtr> m_nodeTypes;
     NodeList m_nodes;
+    QVector<QPointF> m_nodePositions; // in order of m_nodes
+    QVector<QColor> m_nodeColors; // in order of m_nodes
     EdgeList m_edges;
+    QMultiHash<int, NodePtr> m_nodeIds;
+    QMultiHash<int, NodeTypePtr> m_nodeTypeIds;
+    QMultiHash<int, EdgeTypePtr> m_edgeTypeIds;
+    QHash<QPair<EdgeTypePtr, QString>, GraphSnapshotPtr> m_snapshots;
 
     QUrl m_documentUrl;
     QString m_name;
     uint m_lastGeneratedId;
     bool m_modified;
+    int m_bulkUpdateDepth;
+    uint m_nodesRevision;
+    uint m_edgesRevision;
 };
 
 GraphDocumentPtr GraphDocument::self() const
@@ -71,6 +86,7 @@ GraphDocumentPtr GraphDocument::self() const
 
 void GraphDocument::destroy()
 {
+    emit aboutToBeDestroyed();
     d->m_valid = false;
     foreach (EdgePtr edge, d->m_edges) {
         edge->destroy();
@@ -80,6 +96,8 @@ void GraphDocument::destroy()
         node->destroy();
     }
     d->m_nodes.clear();
+    d->m_nodePositions.clear();
+    d->m_nodeColors.clear();
     foreach (NodeTypePtr type, d->m_nodeTypes) {
         type->destroy();
     }
@@ -88,6 +106,10 @@ void GraphDocument::destroy()
         type->destroy();
     }
     d->m_edgeTypes.clear();
+    d->m_nodeIds.clear();
+    d->m_nodeTypeIds.clear();
+    d->m_edgeTypeIds.clear();
+    d->m_snapshots.clear();
 
     // reset last reference to this object
     d->q.reset();
@@ -165,21 +187,42 @@ EdgeList GraphDocument::edges(EdgeTypePtr type) const
     return edges;
 }
 
+uint GraphDocument::nodesRevision() const
+{
+    return d->m_nodesRevision;
+}
+
+uint GraphDocument::edgesRevision() const
+{
+    return d->m_edgesRevision;
+}
+
 void GraphDocument::insert(NodePtr node)
 {
     Q_ASSERT(node);
     Q_ASSERT(node->document() == d->q);
 
-    if (!node || d->m_nodes.contains(node)) {
+    if (!node || node->documentIndex() >= 0) {
         return;
     }
     if (0 <= node->id() && (uint)node->id() < d->m_lastGeneratedId) {
         d->m_lastGeneratedId = node->id();
     }
 
-    emit nodeAboutToBeAdded(node, d->m_nodes.length());
+    const bool notify = (d->m_bulkUpdateDepth == 0);
+    if (notify) {
+        emit nodeAboutToBeAdded(node, d->m_nodes.length());
+    }
+    d->m_nodePositions.append(QPointF(node->x(), node->y()));
+    d->m_nodeColors.append(node->color());
+    node->setDocumentIndex(d->m_nodes.length());
     d->m_nodes.append(node);
-    emit nodeAdded();
+    d->m_nodeIds.insert(node->id(), node);
+    ++d->m_nodesRevision;
+    if (notify) {
+        emit nodeAdded();
+    }
+    invalidateSnapshots();
     setModified(true);
 }
 
@@ -189,13 +232,21 @@ void GraphDocument::insert(EdgePtr edge)
     Q_ASSERT(edge->from()->document() == d->q);
     Q_ASSERT(edge->to()->document() == d->q);
 
-    if (!edge || d->m_edges.contains(edge)) {
+    if (!edge || edge->documentIndex() >= 0) {
         return;
     }
 
-    emit edgeAboutToBeAdded(edge, d->m_edges.length());
+    const bool notify = (d->m_bulkUpdateDepth == 0);
+    if (notify) {
+        emit edgeAboutToBeAdded(edge, d->m_edges.length());
+    }
+    edge->setDocumentIndex(d->m_edges.length());
     d->m_edges.append(edge);
-    emit edgeAdded();
+    ++d->m_edgesRevision;
+    if (notify) {
+        emit edgeAdded();
+    }
+    invalidateSnapshots();
     setModified(true);
 }
 
@@ -210,6 +261,7 @@ void GraphDocument::insert(NodeTypePtr type)
     }
     emit nodeTypeAboutToBeAdded(type, d->m_nodeTypes.length());
     d->m_nodeTypes.append(type);
+    d->m_nodeTypeIds.insert(type->id(), type);
     emit nodeTypeAdded();
     setModified(true);
 }
@@ -225,6 +277,7 @@ void GraphDocument::insert(EdgeTypePtr type)
     }
     emit edgeTypeAboutToBeAdded(type, d->m_edgeTypes.length());
     d->m_edgeTypes.append(type);
+    d->m_edgeTypeIds.insert(type->id(), type);
     emit edgeTypeAdded();
     setModified(true);
 }
@@ -234,12 +287,36 @@ void GraphDocument::remove(NodePtr node)
     if (node->isValid()) {
         node->destroy();
     }
-    int index = d->m_nodes.indexOf(node);
-    if (index >= 0) {
-        emit nodesAboutToBeRemoved(index,index);
-        d->m_nodes.removeAt(index);
-        emit nodesRemoved();
+    const int index = node->documentIndex();
+    if (index >= 0 && index < d->m_nodes.length() && d->m_nodes.at(index) == node) {
+        // efficient way to remove node without having to preserve order:
+        // move last node into the gap and only remove the last list entry
+        const bool notify = (d->m_bulkUpdateDepth == 0);
+        const int last = d->m_nodes.length() - 1;
+        // node takes its position and color from document buffers
+        node->setDocumentIndex(-1);
+        if (index != last) {
+            d->m_nodes[index] = d->m_nodes.at(last);
+            d->m_nodePositions[index] = d->m_nodePositions.at(last);
+            d->m_nodeColors[index] = d->m_nodeColors.at(last);
+            d->m_nodes.at(index)->setDocumentIndex(index);
+            if (notify) {
+                emit nodeMoved(last, index);
+            }
+        }
+        if (notify) {
+            emit nodesAboutToBeRemoved(last, last);
+        }
+        d->m_nodes.removeLast();
+        d->m_nodePositions.removeLast();
+        d->m_nodeColors.removeLast();
+        d->m_nodeIds.remove(node->id(), node);
+        ++d->m_nodesRevision;
+        if (notify) {
+            emit nodesRemoved();
+        }
     }
+    invalidateSnapshots();
     setModified(true);
 }
 
@@ -248,12 +325,30 @@ void GraphDocument::remove(EdgePtr edge)
     if (edge->isValid()) {
         edge->destroy();
     }
-    int index = d->m_edges.indexOf(edge);
-    if (index >= 0) {
-        emit edgesAboutToBeRemoved(index,index);
-        d->m_edges.removeAt(index);
-        emit edgesRemoved();
+    const int index = edge->documentIndex();
+    if (index >= 0 && index < d->m_edges.length() && d->m_edges.at(index) == edge) {
+        // efficient way to remove edge without having to preserve order:
+        // move last edge into the gap and only remove the last list entry
+        const bool notify = (d->m_bulkUpdateDepth == 0);
+        const int last = d->m_edges.length() - 1;
+        if (index != last) {
+            d->m_edges[index] = d->m_edges.at(last);
+            d->m_edges.at(index)->setDocumentIndex(index);
+            if (notify) {
+                emit edgeMoved(last, index);
+            }
+        }
+        if (notify) {
+            emit edgesAboutToBeRemoved(last, last);
+        }
+        d->m_edges.removeLast();
+        edge->setDocumentIndex(-1);
+        ++d->m_edgesRevision;
+        if (notify) {
+            emit edgesRemoved();
+        }
     }
+    invalidateSnapshots();
     setModified(true);
 }
 
@@ -270,6 +365,7 @@ void GraphDocument::remove(NodeTypePtr type)
     int index = d->m_nodeTypes.indexOf(type);
     emit nodeTypesAboutToBeRemoved(index, index);
     d->m_nodeTypes.removeOne(type);
+    d->m_nodeTypeIds.remove(type->id(), type);
     emit nodeTypesRemoved();
     setModified(true);
 }
@@ -285,7 +381,9 @@ void GraphDocument::remove(EdgeTypePtr type)
     int index = d->m_edgeTypes.indexOf(type);
     emit edgeTypesAboutToBeRemoved(index, index);
     d->m_edgeTypes.removeOne(type);
+    d->m_edgeTypeIds.remove(type->id(), type);
     emit edgeTypesRemoved();
+    invalidateSnapshots();
     setModified(true);
 }
 
@@ -299,6 +397,167 @@ QList< NodeTypePtr > GraphDocument::nodeTypes() const
     return d->m_nodeTypes;
 }
 
+NodePtr GraphDocument::node(int id) const
+{
+    return d->m_nodeIds.value(id);
+}
+
+NodeTypePtr GraphDocument::nodeType(int id) const
+{
+    return d->m_nodeTypeIds.value(id);
+}
+
+EdgeTypePtr GraphDocument::edgeType(int id) const
+{
+    return d->m_edgeTypeIds.value(id);
+}
+
+void GraphDocument::updateId(NodePtr node, int oldId)
+{
+    // only update index if node is registered at all
+    if (d->m_nodeIds.remove(oldId, node) > 0) {
+        d->m_nodeIds.insert(node->id(), node);
+    }
+}
+
+void GraphDocument::updateId(NodeTypePtr type, int oldId)
+{
+    if (d->m_nodeTypeIds.remove(oldId, type) > 0) {
+        d->m_nodeTypeIds.insert(type->id(), type);
+    }
+}
+
+void GraphDocument::updateId(EdgeTypePtr type, int oldId)
+{
+    if (d->m_edgeTypeIds.remove(oldId, type) > 0) {
+        d->m_edgeTypeIds.insert(type->id(), type);
+    }
+}
+
+GraphSnapshotPtr GraphDocument::snapshot(EdgeTypePtr type, const QString &weightProperty) const
+{
+    const QPair<EdgeTypePtr, QString> key(type, weightProperty);
+    GraphSnapshotPtr snapshot = d->m_snapshots.value(key);
+    if (!snapshot) {
+        snapshot = GraphSnapshot::create(d->q, type, weightProperty);
+        d->m_snapshots.insert(key, snapshot);
+    }
+    return snapshot;
+}
+
+void GraphDocument::invalidateSnapshots()
+{
+    if (!d->m_snapshots.isEmpty()) {
+        d->m_snapshots.clear();
+    }
+}
+
+QVector<QPointF> GraphDocument::nodePositions() const
+{
+    return d->m_nodePositions;
+}
+
+void GraphDocument::setNodePositions(const QVector<QPointF> &positions)
+{
+    Q_ASSERT(positions.count() == d->m_nodes.count());
+    if (positions.count() != d->m_nodes.count()) {
+        qCWarning(GRAPHTHEORY_GENERAL) << "Number of positions does not match number of nodes, aborting.";
+        return;
+    }
+    d->m_nodePositions = positions;
+    emit nodePositionsChanged();
+}
+
+void GraphDocument::setNodeProperties(const NodeList &nodes, const QString &property, const QVector<QVariant> &values)
+{
+    Q_ASSERT(values.count() == 1 || values.count() == nodes.count());
+    if (values.count() != 1 && values.count() != nodes.count()) {
+        qCWarning(GRAPHTHEORY_GENERAL) << "Number of values does not match number of nodes, aborting.";
+        return;
+    }
+    // property slots only differ between node types, hence look them up once per type
+    QHash<NodeTypePtr, int> indices;
+    for (int i = 0; i < nodes.count(); ++i) {
+        const NodePtr &node = nodes.at(i);
+        const NodeTypePtr type = node->type();
+        auto iter = indices.constFind(type);
+        if (iter == indices.constEnd()) {
+            iter = indices.insert(type, type->dynamicPropertyIndex(property));
+        }
+        node->storeDynamicProperty(iter.value(), values.count() == 1 ? values.first() : values.at(i));
+    }
+    emit nodePropertiesChanged(property);
+}
+
+void GraphDocument::setEdgeProperties(const EdgeList &edges, const QString &property, const QVector<QVariant> &values)
+{
+    Q_ASSERT(values.count() == 1 || values.count() == edges.count());
+    if (values.count() != 1 && values.count() != edges.count()) {
+        qCWarning(GRAPHTHEORY_GENERAL) << "Number of values does not match number of edges, aborting.";
+        return;
+    }
+    QHash<EdgeTypePtr, int> indices;
+    for (int i = 0; i < edges.count(); ++i) {
+        const EdgePtr &edge = edges.at(i);
+        const EdgeTypePtr type = edge->type();
+        auto iter = indices.constFind(type);
+        if (iter == indices.constEnd()) {
+            iter = indices.insert(type, type->dynamicPropertyIndex(property));
+        }
+        edge->storeDynamicProperty(iter.value(), values.count() == 1 ? values.first() : values.at(i));
+    }
+    invalidateSnapshots();
+    emit edgePropertiesChanged(property);
+}
+
+QVector<QColor> GraphDocument::nodeColors() const
+{
+    return d->m_nodeColors;
+}
+
+QPointF GraphDocument::nodePosition(int index) const
+{
+    return d->m_nodePositions.at(index);
+}
+
+void GraphDocument::setNodePosition(int index, const QPointF &position)
+{
+    d->m_nodePositions[index] = position;
+}
+
+QColor GraphDocument::nodeColor(int index) const
+{
+    return d->m_nodeColors.at(index);
+}
+
+void GraphDocument::setNodeColor(int index, const QColor &color)
+{
+    d->m_nodeColors[index] = color;
+}
+
+void GraphDocument::beginBulkUpdate()
+{
+    if (d->m_bulkUpdateDepth++ == 0) {
+        emit bulkUpdateAboutToBegin();
+    }
+}
+
+void GraphDocument::endBulkUpdate()
+{
+    Q_ASSERT(d->m_bulkUpdateDepth > 0);
+    if (d->m_bulkUpdateDepth <= 0) {
+        return;
+    }
+    if (--d->m_bulkUpdateDepth == 0) {
+        emit bulkUpdateFinished();
+    }
+}
+
+bool GraphDocument::isBulkUpdate() const
+{
+    return d->m_bulkUpdateDepth > 0;
+}
+
 uint GraphDocument::generateId()
 {
     return ++d->m_lastGeneratedId;
@@ -28,8 +28,12 @@
 #include "nodetype.h"
 
 #include <QObject>
+#include <QAtomicInteger>
 #include <QSharedPointer>
 #include <QList>
+#include <QVector>
+#include <QPointF>
+#include <QColor>
 
 namespace GraphTheory
 {
@@ -77,10 +81,29 @@ public:
      */
     EdgeList edges(EdgeTypePtr type = EdgeTypePtr()) const;
 
+    /**
+     * @return revision of the node list, which changes whenever a node is added or removed
+     */
+    uint nodesRevision() const;
+
+    /**
+     * @return revision of the edge list, which changes whenever an edge is added or removed
+     */
+    uint edgesRevision() const;
+
+    /**
+     * Look up node by its identifier. The lookup is performed in constant time by an index that
+     * is kept up-to-date on every Node::setId() call. If several nodes share the same
+     * identifier, any of them is returned.
+     *
+     * @return node with identifier @p id or an invalid pointer if no such node exists
+     */
+    NodePtr node(int id) const;
+
     /**
      * Add @p node to this document. The node must be correctly setup before, i.e.,
      * its type and document values have to be set. When inserting a node already in the list,
-     * insert does nothing.
+     * insert does nothing. Insertion is performed in constant time.
      *
      * @param node  the node to be added to the document
      */
@@ -89,7 +112,7 @@ public:
     /**
      * Add @p edge to this document. The edge must be correctly setup before, i.e.,
      * its type and end points have to be set. When inserting an edge already in the list,
-     * insert does not perform any operation.
+     * insert does not perform any operation. Insertion is performed in constant time.
      *
      * @param edge  the edge to be added to the document
      */
@@ -111,7 +134,9 @@ public:
 
     /**
      * Remove @p node from this document. If the node is valid, Node::destroy() will be called,
-     * otherwise it will only be removed.
+     * otherwise it will only be removed. Removal is performed in constant time by moving the
+     * last node of the list to the position of the removed node, i.e., the order of nodes is
+     * not preserved.
      *
      * @param node  the node to be removed from the document
      */
@@ -119,7 +144,9 @@ public:
 
     /**
      * Remove @p edge from this document. If the edge is valid, Edge::destroy() will be called,
-     * otherwise it will only be removed.
+     * otherwise it will only be removed. Removal is performed in constant time by moving the
+     * last edge of the list to the position of the removed edge, i.e., the order of edges is
+     * not preserved.
      *
      * @param edge  the edge to be removed from the document
      */
@@ -157,6 +184,113 @@ public:
      */
     QList<NodeTypePtr> nodeTypes() const;
 
+    /**
+     * Look up node type by its identifier in constant time.
+     *
+     * @return node type with identifier @p id or an invalid pointer if no such type exists
+     */
+    NodeTypePtr nodeType(int id) const;
+
+    /**
+     * Look up edge type by its identifier in constant time.
+     *
+     * @return edge type with identifier @p id or an invalid pointer if no such type exists
+     */
+    EdgeTypePtr edgeType(int id) const;
+
+    /**
+     * Compressed sparse row representation of the current document structure. The snapshot is
+     * cached and only rebuilt if nodes, edges, edge types or edge properties changed since the
+     * last call with the same arguments.
+     *
+     * @param type if set, only edges of this type are considered
+     * @param weightProperty if not empty, arc weights are read from this dynamic property
+     * @return snapshot of current document structure
+     * @see GraphSnapshot::create()
+     */
+    GraphSnapshotPtr snapshot(EdgeTypePtr type = EdgeTypePtr(), const QString &weightProperty = QString()) const;
+
+    /**
+     * Positions of all nodes are stored contiguously by the document in the order of nodes(),
+     * such that layout algorithms can process them without accessing each node object.
+     *
+     * @return positions of all nodes, the i-th entry belongs to the i-th node of nodes()
+     */
+    QVector<QPointF> nodePositions() const;
+
+    /**
+     * Set positions of all nodes at once. In contrast to setting positions by Node::setX() and
+     * Node::setY(), no per node signals are emitted but only nodePositionsChanged() once.
+     *
+     * @param positions the new positions in the order of nodes(), must have the same size
+     */
+    void setNodePositions(const QVector<QPointF> &positions);
+
+    /**
+     * Set dynamic property @p property of all @p nodes at once. In contrast to
+     * Node::setDynamicProperty(), no per node signals are emitted but only nodePropertiesChanged()
+     * once. Nodes whose type does not register @p property are skipped.
+     *
+     * @param values either one value for all nodes or one value per node in the order of @p nodes
+     */
+    void setNodeProperties(const NodeList &nodes, const QString &property, const QVector<QVariant> &values);
+
+    /**
+     * Set dynamic property @p property of all @p edges at once. In contrast to
+     * Edge::setDynamicProperty(), no per edge signals are emitted but only edgePropertiesChanged()
+     * once. Edges whose type does not register @p property are skipped.
+     *
+     * @param values either one value for all edges or one value per edge in the order of @p edges
+     */
+    void setEdgeProperties(const EdgeList &edges, const QString &property, const QVector<QVariant> &values);
+
+    /**
+     * @return colors of all nodes, the i-th entry belongs to the i-th node of nodes()
+     */
+    QVector<QColor> nodeColors() const;
+
+    /**
+     * Start a bulk update of this document. Until the matching endBulkUpdate() call, no per
+     * element signals are emitted when nodes or edges are added to or removed from the document.
+     * Instead, signal bulkUpdateAboutToBegin() is emitted now and bulkUpdateFinished() is
+     * emitted at the end, such that listeners can perform one reset instead of processing each
+     * element separately. Calls can be nested; only the outermost pair emits signals.
+     *
+     * @note prefer BulkUpdateGuard over calling this method directly
+     */
+    void beginBulkUpdate();
+
+    /**
+     * Finish a bulk update that was started by beginBulkUpdate().
+     */
+    void endBulkUpdate();
+
+    /**
+     * @return true if a bulk update is in progress, otherwise false
+     */
+    bool isBulkUpdate() const;
+
+    /**
+     * \class BulkUpdateGuard
+     * Starts a bulk update of a document on construction and finishes it on destruction.
+     */
+    class BulkUpdateGuard
+    {
+    public:
+        explicit BulkUpdateGuard(GraphDocumentPtr document)
+            : m_document(document)
+        {
+            m_document->beginBulkUpdate();
+        }
+        ~BulkUpdateGuard()
+        {
+            m_document->endBulkUpdate();
+        }
+    private:
+        Q_DISABLE_COPY(BulkUpdateGuard)
+        const GraphDocumentPtr m_document;
+    };
+
     /**
      * Generate a unique unique identifier. This identifier is uniquely generated within this
      * document. But it is not checked, if it is already used for any node.
@@ -171,7 +305,7 @@ public:
      */
     static uint objects()
     {
-        return objectCounter;
+        return objectCounter.load();
     }
 
 Q_SIGNALS:
@@ -179,10 +313,26 @@ Q_SIGNALS:
     void nodeAdded();
     void nodesAboutToBeRemoved(int,int);
     void nodesRemoved();
+    /** the node at index @p from was moved to index @p to, replacing the node at that index **/
+    void nodeMoved(int from, int to);
     void edgeAboutToBeAdded(EdgePtr,int);
     void edgeAdded();
     void edgesAboutToBeRemoved(int,int);
     void edgesRemoved();
+    /** the edge at index @p from was moved to index @p to, replacing the edge at that index **/
+    void edgeMoved(int from, int to);
+    /** positions of arbitrary many nodes were changed by setNodePositions() **/
+    void nodePositionsChanged();
+    /** dynamic property @p property of arbitrary many nodes was changed by setNodeProperties() **/
+    void nodePropertiesChanged(const QString &property);
+    /** dynamic property @p property of arbitrary many edges was changed by setEdgeProperties() **/
+    void edgePropertiesChanged(const QString &property);
+    /** a bulk update starts, no per element node and edge signals follow until its end **/
+    void bulkUpdateAboutToBegin();
+    /** a bulk update finished, node and edge lists may have changed arbitrarily **/
+    void bulkUpdateFinished();
+    /** destroy() was called, all nodes, edges and types of the document are removed next **/
+    void aboutToBeDestroyed();
     void nodeTypeAboutToBeAdded(NodeTypePtr,int);
     void nodeTypeAdded();
     void nodeTypesAboutToBeRemoved(int,int);
@@ -270,7 +420,25 @@ private:
     Q_DISABLE_COPY(GraphDocument)
     const QScopedPointer<GraphDocumentPrivate> d;
     void setQpointer(GraphDocumentPtr q);
-    static uint objectCounter;
+    /** drop cached snapshots, must be called on every change of the structure or of edge properties **/
+    void invalidateSnapshots();
+    /** position and color buffer access for node at @p index, used by Node **/
+    QPointF nodePosition(int index) const;
+    void setNodePosition(int index, const QPointF &position);
+    QColor nodeColor(int index) const;
+    void setNodeColor(int index, const QColor &color);
+    /** update identifier index after id of @p node changed from @p oldId **/
+    void updateId(NodePtr node, int oldId);
+    /** update identifier index after id of @p type changed from @p oldId **/
+    void updateId(NodeTypePtr type, int oldId);
+    /** update identifier index after id of @p type changed from @p oldId **/
+    void updateId(EdgeTypePtr type, int oldId);
+    static QAtomicInteger<uint> objectCounter;
+
+    friend class Node;
+    friend class Edge;
+    friend class NodeType;
+    friend class EdgeType;
 };
 }
 
@@ -0,0 +1,210 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "graphsnapshot.h"
+#include "graphdocument.h"
+#include "edge.h"
+#include "edgetype.h"
+
+#include <QHash>
+
+using namespace GraphTheory;
+
+class GraphTheory::GraphSnapshotPrivate {
+public:
+    GraphSnapshotPrivate()
+    {
+    }
+
+    ~GraphSnapshotPrivate()
+    {
+    }
+
+    EdgeTypePtr m_type;
+    QString m_weightProperty;
+    NodeList m_nodes;
+    EdgeList m_edges;
+    QVector<int> m_outOffsets;
+    QVector<int> m_targets;
+    QVector<int> m_arcEdges; // index of edge in m_edges for each arc
+    QVector<qreal> m_weights;
+    QVector<int> m_inOffsets;
+    QVector<int> m_sources;
+    QVector<int> m_inArcs;
+};
+
+GraphSnapshot::GraphSnapshot()
+    : d(new GraphSnapshotPrivate)
+{
+}
+
+GraphSnapshot::~GraphSnapshot()
+{
+}
+
+GraphSnapshotPtr GraphSnapshot::create(GraphDocumentPtr document, EdgeTypePtr type, const QString &weightProperty)
+{
+    Q_ASSERT(document);
+    GraphSnapshotPtr pi(new GraphSnapshot);
+    GraphSnapshotPrivate * const d = pi->d.data();
+    d->m_type = type;
+    d->m_weightProperty = weightProperty;
+    d->m_nodes = document->nodes();
+    d->m_edges = document->edges();
+    const int nodeCount = d->m_nodes.count();
+    const int edgeCount = d->m_edges.count();
+
+    // dense node indices are the positions in node list, which are maintained by the document
+    QVector<int> fromIndex(edgeCount, -1);
+    QVector<int> toIndex(edgeCount, -1);
+    QVector<bool> bidirectional(edgeCount, false);
+    d->m_outOffsets.fill(0, nodeCount + 1);
+    d->m_inOffsets.fill(0, nodeCount + 1);
+    for (int e = 0; e < edgeCount; ++e) {
+        const EdgePtr &edge = d->m_edges.at(e);
+        if (type && edge->type() != type) {
+            continue;
+        }
+        fromIndex[e] = edge->from()->documentIndex();
+        toIndex[e] = edge->to()->documentIndex();
+        bidirectional[e] = (edge->type()->direction() == EdgeType::Bidirectional);
+        ++d->m_outOffsets[fromIndex[e] + 1];
+        ++d->m_inOffsets[toIndex[e] + 1];
+        if (bidirectional[e]) {
+            ++d->m_outOffsets[toIndex[e] + 1];
+            ++d->m_inOffsets[fromIndex[e] + 1];
+        }
+    }
+    for (int i = 0; i < nodeCount; ++i) {
+        d->m_outOffsets[i + 1] += d->m_outOffsets[i];
+        d->m_inOffsets[i + 1] += d->m_inOffsets[i];
+    }
+
+    const int arcCount = d->m_outOffsets[nodeCount];
+    const bool hasWeights = !weightProperty.isEmpty();
+    d->m_targets.resize(arcCount);
+    d->m_arcEdges.resize(arcCount);
+    d->m_sources.resize(arcCount);
+    d->m_inArcs.resize(arcCount);
+    if (hasWeights) {
+        d->m_weights.resize(arcCount);
+    }
+
+    // look up property slot only once per edge type
+    QHash<EdgeType*, int> propertyIndices;
+    QVector<int> nextOut = d->m_outOffsets;
+    QVector<int> nextIn = d->m_inOffsets;
+    auto addArc = [&](int source, int target, int edge, qreal weight) {
+        const int arc = nextOut[source]++;
+        d->m_targets[arc] = target;
+        d->m_arcEdges[arc] = edge;
+        if (hasWeights) {
+            d->m_weights[arc] = weight;
+        }
+        const int inArc = nextIn[target]++;
+        d->m_sources[inArc] = source;
+        d->m_inArcs[inArc] = arc;
+    };
+    for (int e = 0; e < edgeCount; ++e) {
+        if (fromIndex.at(e) < 0) {
+            continue;
+        }
+        qreal weight = 1;
+        if (hasWeights) {
+            const EdgePtr &edge = d->m_edges.at(e);
+            EdgeType * const edgeType = edge->type().data();
+            auto iter = propertyIndices.constFind(edgeType);
+            if (iter == propertyIndices.constEnd()) {
+                iter = propertyIndices.insert(edgeType, edgeType->dynamicPropertyIndex(weightProperty));
+            }
+            bool ok = false;
+            const qreal value = edge->dynamicProperty(iter.value()).toDouble(&ok);
+            if (ok) {
+                weight = value;
+            }
+        }
+        addArc(fromIndex.at(e), toIndex.at(e), e, weight);
+        if (bidirectional.at(e)) {
+            addArc(toIndex.at(e), fromIndex.at(e), e, weight);
+        }
+    }
+
+    return pi;
+}
+
+EdgeTypePtr GraphSnapshot::edgeType() const
+{
+    return d->m_type;
+}
+
+QString GraphSnapshot::weightProperty() const
+{
+    return d->m_weightProperty;
+}
+
+int GraphSnapshot::nodeCount() const
+{
+    return d->m_nodes.count();
+}
+
+int GraphSnapshot::arcCount() const
+{
+    return d->m_targets.count();
+}
+
+NodePtr GraphSnapshot::node(int index) const
+{
+    return d->m_nodes.at(index);
+}
+
+EdgePtr GraphSnapshot::edge(int arc) const
+{
+    return d->m_edges.at(d->m_arcEdges.at(arc));
+}
+
+const QVector<int> & GraphSnapshot::outOffsets() const
+{
+    return d->m_outOffsets;
+}
+
+const QVector<int> & GraphSnapshot::targets() const
+{
+    return d->m_targets;
+}
+
+const QVector<qreal> & GraphSnapshot::weights() const
+{
+    return d->m_weights;
+}
+
+const QVector<int> & GraphSnapshot::inOffsets() const
+{
+    return d->m_inOffsets;
+}
+
+const QVector<int> & GraphSnapshot::sources() const
+{
+    return d->m_sources;
+}
+
+const QVector<int> & GraphSnapshot::inArcs() const
+{
+    return d->m_inArcs;
+}
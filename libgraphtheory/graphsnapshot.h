@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GRAPHSNAPSHOT_H
+#define GRAPHSNAPSHOT_H
+
+#include "graphtheory_export.h"
+#include "typenames.h"
+
+#include <QScopedPointer>
+#include <QString>
+#include <QVector>
+
+namespace GraphTheory
+{
+
+class GraphSnapshotPrivate;
+
+/**
+ * \class GraphSnapshot
+ * Immutable compressed sparse row (CSR) representation of the structure of a GraphDocument.
+ *
+ * The snapshot numbers nodes densely by their position in GraphDocument::nodes() at creation
+ * time and stores every edge of the considered edge type as arc. Unidirectional edges provide
+ * one arc from Edge::from() to Edge::to(), bidirectional edges provide one arc in each
+ * direction. Outgoing arcs of node @c i are the arcs in range [outOffsets()[i], outOffsets()[i+1])
+ * and incoming arcs of node @c i are those in range [inOffsets()[i], inOffsets()[i+1]).
+ *
+ * Since the snapshot is immutable, it may be shared between threads. It does not follow changes
+ * of the document; use GraphDocument::snapshot() to obtain an up-to-date snapshot that is only
+ * rebuilt after the document changed.
+ */
+class GRAPHTHEORY_EXPORT GraphSnapshot
+{
+public:
+    /**
+     * Creates a snapshot of @p document.
+     *
+     * @param document the document whose structure is captured
+     * @param type if set, only edges of this type are considered
+     * @param weightProperty if not empty, arc weights are read from this dynamic property
+     * @return the snapshot
+     */
+    static GraphSnapshotPtr create(GraphDocumentPtr document, EdgeTypePtr type = EdgeTypePtr(),
+                                   const QString &weightProperty = QString());
+
+    ~GraphSnapshot();
+
+    /**
+     * @return edge type that was used for filtering edges or a null pointer if all edges are considered
+     */
+    EdgeTypePtr edgeType() const;
+
+    /**
+     * @return name of the dynamic property that provides arc weights, may be empty
+     */
+    QString weightProperty() const;
+
+    /**
+     * @return number of nodes
+     */
+    int nodeCount() const;
+
+    /**
+     * @return number of arcs
+     */
+    int arcCount() const;
+
+    /**
+     * @return node with dense index @p index
+     */
+    NodePtr node(int index) const;
+
+    /**
+     * @return edge from which arc @p arc was created
+     */
+    EdgePtr edge(int arc) const;
+
+    /**
+     * @return arc offsets of outgoing arcs with nodeCount() + 1 entries
+     */
+    const QVector<int> & outOffsets() const;
+
+    /**
+     * @return target node index of each arc
+     */
+    const QVector<int> & targets() const;
+
+    /**
+     * Arc weights are only present if a weight property is given. Values that cannot be
+     * converted to a number, including unset values, are treated as weight 1.
+     *
+     * @return weight of each arc or an empty vector if no weight property is given
+     */
+    const QVector<qreal> & weights() const;
+
+    /**
+     * @return arc offsets of incoming arcs with nodeCount() + 1 entries
+     */
+    const QVector<int> & inOffsets() const;
+
+    /**
+     * @return source node index of each incoming arc
+     */
+    const QVector<int> & sources() const;
+
+    /**
+     * Allows to access the target, weight and edge of incoming arcs.
+     *
+     * @return arc index of each incoming arc
+     */
+    const QVector<int> & inArcs() const;
+
+protected:
+    GraphSnapshot();
+
+private:
+    Q_DISABLE_COPY(GraphSnapshot)
+    const QScopedPointer<GraphSnapshotPrivate> d;
+};
+}
+
+#endif
@@ -23,25 +23,71 @@
 #include "edgewrapper.h"
 #include "graphdocument.h"
 #include "nodetype.h"
+#include "edgetype.h"
 #include "edge.h"
+#include "graphsnapshot.h"
+#include "algorithms/graphalgorithms.h"
+#include "modifiers/topology.h"
+#include "modifiers/forcedirectedlayout.h"
+#include "modifiers/multilevellayout.h"
+#include "modifiers/layeredlayout.h"
+#include "modifiers/layoutobserver.h"
+#include "modifiers/layoututils_p.h"
 #include <KLocalizedString>
 #include <QDebug>
+#include <QMutex>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QTimer>
 
 using namespace GraphTheory;
 
-DocumentWrapper::DocumentWrapper(GraphDocumentPtr document, QScriptEngine *engine)
-    : m_document(document)
-    , m_engine(engine)
+namespace {
+// cancels layouts computed by scripts when the execution is aborted
+class AbortObserver : public LayoutObserver
 {
-    foreach (NodePtr node, document->nodes()) {
-        registerWrapper(node);
+public:
+    explicit AbortObserver(const std::function<bool()> &isAborted)
+        : m_isAborted(isAborted)
+    {
+    }
+    bool isCanceled() const Q_DECL_OVERRIDE
+    {
+        return m_isAborted();
     }
-    foreach (EdgePtr edge, document->edges()) {
-        registerWrapper(edge);
+    bool isUpdateDue() const Q_DECL_OVERRIDE
+    {
+        return false;
+    }
+    void update(const QVector<QPointF> &positions) Q_DECL_OVERRIDE
+    {
+        Q_UNUSED(positions);
     }
 
-    connect(document.data(), &GraphDocument::nodeAboutToBeAdded, this, static_cast<void (DocumentWrapper::*)(NodePtr)>(&DocumentWrapper::registerWrapper));
-    connect(document.data(), &GraphDocument::edgeAboutToBeAdded, this, static_cast<void (DocumentWrapper::*)(EdgePtr)>(&DocumentWrapper::registerWrapper));
+private:
+    const std::function<bool()> m_isAborted;
+};
+}
+
+DocumentWrapper::DocumentWrapper(GraphDocumentPtr document, QScriptEngine *engine, const QAtomicInt *aborted)
+    : m_document(document)
+    , m_engine(engine)
+    , m_aborted(aborted)
+    , m_nodeValuesRevision(0)
+    , m_edgeValuesRevision(0)
+    , m_nodeWrappersRevision(0)
+    , m_edgeWrappersRevision(0)
+{
+    // wrappers are created on demand, see nodeWrapper() and edgeWrapper()
+    connect(m_document.data(), &GraphDocument::aboutToBeDestroyed, this, [this]() {
+        m_documentDestroyed.storeRelease(1);
+    }, Qt::DirectConnection);
+    connect(m_document.data(), &GraphDocument::nodePropertiesChanged, this, [this]() {
+        m_nodePropertiesChanged.storeRelease(1);
+    }, Qt::DirectConnection);
+    connect(m_document.data(), &GraphDocument::edgePropertiesChanged, this, [this]() {
+        m_edgePropertiesChanged.storeRelease(1);
+    }, Qt::DirectConnection);
 }
 
 DocumentWrapper::~DocumentWrapper()
@@ -55,50 +101,264 @@ QScriptEngine* DocumentWrapper::engine() const
     return m_engine;
 }
 
-void DocumentWrapper::registerWrapper(NodePtr node)
+GraphDocumentPtr DocumentWrapper::document() const
 {
-    if (m_nodeMap.contains(node)) {
+    return m_document;
+}
+
+QScriptValue DocumentWrapper::scriptValue() const
+{
+    if (!m_scriptValue.isValid()) {
+        m_scriptValue = m_engine->newQObject(const_cast<DocumentWrapper*>(this));
+    }
+    return m_scriptValue;
+}
+
+void DocumentWrapper::releaseRemovedElements()
+{
+    NodeList nodes;
+    EdgeList edges;
+    synchronized([&]() {
+        // revisions change whenever elements are added or removed
+        if (m_nodeWrappersRevision != m_document->nodesRevision()) {
+            for (auto iter = m_nodeMap.constBegin(); iter != m_nodeMap.constEnd(); ++iter) {
+                if (!iter.key()->isValid()) {
+                    nodes.append(iter.key());
+                }
+            }
+            m_nodeWrappersRevision = m_document->nodesRevision();
+        }
+        if (m_edgeWrappersRevision != m_document->edgesRevision()) {
+            for (auto iter = m_edgeMap.constBegin(); iter != m_edgeMap.constEnd(); ++iter) {
+                if (!iter.key()->isValid()) {
+                    edges.append(iter.key());
+                }
+            }
+            m_edgeWrappersRevision = m_document->edgesRevision();
+        }
+    });
+    foreach (const NodePtr &node, nodes) {
+        releaseWrappers(node, EdgeList());
+    }
+    releaseWrappers(NodePtr(), edges);
+}
+
+void DocumentWrapper::updateChangedProperties()
+{
+    const bool allNodes = m_nodePropertiesChanged.fetchAndStoreAcquire(0) != 0;
+    const bool allEdges = m_edgePropertiesChanged.fetchAndStoreAcquire(0) != 0;
+    QVector<NodeWrapper*> nodeWrappers;
+    foreach (NodeWrapper *wrapper, m_nodeMap) {
+        if (wrapper->takeDynamicPropertyChange() || allNodes) {
+            nodeWrappers.append(wrapper);
+        }
+    }
+    QVector<EdgeWrapper*> edgeWrappers;
+    foreach (EdgeWrapper *wrapper, m_edgeMap) {
+        if (wrapper->takeDynamicPropertyChange() || allEdges) {
+            edgeWrappers.append(wrapper);
+        }
+    }
+    if (nodeWrappers.isEmpty() && edgeWrappers.isEmpty()) {
         return;
     }
-    NodeWrapper *wrapper = new NodeWrapper(node, this);
-    m_nodeMap.insert(node, wrapper);
-    connect(wrapper, &NodeWrapper::message, this, &DocumentWrapper::message);
-    return;
+
+    QVector<QStringList> nodeProperties(nodeWrappers.count());
+    QVector<QVector<QVariant> > nodeValues(nodeWrappers.count());
+    QVector<QStringList> edgeProperties(edgeWrappers.count());
+    QVector<QVector<QVariant> > edgeValues(edgeWrappers.count());
+    synchronized([&]() {
+        for (int i = 0; i < nodeWrappers.count(); ++i) {
+            const NodePtr node = nodeWrappers.at(i)->node();
+            nodeProperties[i] = node->dynamicProperties();
+            foreach (const QString &property, nodeProperties.at(i)) {
+                nodeValues[i].append(node->dynamicProperty(property));
+            }
+        }
+        for (int i = 0; i < edgeWrappers.count(); ++i) {
+            const EdgePtr edge = edgeWrappers.at(i)->edge();
+            edgeProperties[i] = edge->dynamicProperties();
+            foreach (const QString &property, edgeProperties.at(i)) {
+                edgeValues[i].append(edge->dynamicProperty(property));
+            }
+        }
+    });
+    for (int i = 0; i < nodeWrappers.count(); ++i) {
+        for (int j = 0; j < nodeProperties.at(i).count(); ++j) {
+            nodeWrappers.at(i)->updateDynamicProperty(nodeProperties.at(i).at(j), nodeValues.at(i).at(j));
+        }
+    }
+    for (int i = 0; i < edgeWrappers.count(); ++i) {
+        for (int j = 0; j < edgeProperties.at(i).count(); ++j) {
+            edgeWrappers.at(i)->updateDynamicProperty(edgeProperties.at(i).at(j), edgeValues.at(i).at(j));
+        }
+    }
+}
+
+void DocumentWrapper::resetScriptProperties()
+{
+    foreach (NodeWrapper *wrapper, m_nodesWithScriptProperties) {
+        wrapper->removeScriptProperties();
+    }
+    m_nodesWithScriptProperties.clear();
+    foreach (EdgeWrapper *wrapper, m_edgesWithScriptProperties) {
+        wrapper->removeScriptProperties();
+    }
+    m_edgesWithScriptProperties.clear();
+}
+
+void DocumentWrapper::clearDistanceCache()
+{
+    m_distanceCache.clear();
+    m_distanceCacheGraphs.clear();
 }
 
-void DocumentWrapper::registerWrapper(EdgePtr edge)
+void DocumentWrapper::scriptPropertyAdded(NodeWrapper *wrapper) const
 {
-    if (m_edgeMap.contains(edge)) {
+    m_nodesWithScriptProperties.insert(wrapper);
+}
+
+void DocumentWrapper::scriptPropertyAdded(EdgeWrapper *wrapper) const
+{
+    m_edgesWithScriptProperties.insert(wrapper);
+}
+
+bool DocumentWrapper::isAborted() const
+{
+    return (m_aborted && m_aborted->loadAcquire() != 0) || m_documentDestroyed.loadAcquire() != 0;
+}
+
+void DocumentWrapper::invokeInDocumentThread(const std::function<void()> &function) const
+{
+    // The call is queued into the event loop of the document's thread, the calling thread waits
+    // for its completion such that the function may safely refer to the caller's stack. A call
+    // that did not start yet is cancelled on abort, since it might never be processed.
+    struct Call {
+        Call() : started(false), cancelled(false) {}
+        QMutex mutex;
+        bool started;
+        bool cancelled;
+        QSemaphore finished;
+    };
+    if (isAborted()) {
+        m_engine->abortEvaluation();
+        return;
+    }
+    QSharedPointer<Call> call(new Call);
+    QTimer::singleShot(0, m_document.data(), [call, &function]() {
+        {
+            QMutexLocker locker(&call->mutex);
+            if (call->cancelled) {
+                return;
+            }
+            call->started = true;
+        }
+        function();
+        call->finished.release();
+    });
+    while (!call->finished.tryAcquire(1, 20)) {
+        if (!isAborted()) {
+            continue;
+        }
+        QMutexLocker locker(&call->mutex);
+        if (call->started) {
+            // a running call completes without help of this thread
+            locker.unlock();
+            call->finished.acquire();
+            return;
+        }
+        call->cancelled = true;
+        locker.unlock();
+        m_engine->abortEvaluation();
         return;
     }
-    EdgeWrapper *wrapper = new EdgeWrapper(edge, this);
-    m_edgeMap.insert(edge, wrapper);
-    connect(wrapper, &EdgeWrapper::message, this, &DocumentWrapper::message);
-    return;
 }
 
 NodeWrapper * DocumentWrapper::nodeWrapper(NodePtr node) const
 {
-    Q_ASSERT(m_nodeMap.contains(node));
-    return m_nodeMap.value(node);
+    NodeWrapper *wrapper = m_nodeMap.value(node);
+    if (!wrapper) {
+        wrapper = new NodeWrapper(node, const_cast<DocumentWrapper*>(this));
+        m_nodeMap.insert(node, wrapper);
+        connect(wrapper, &NodeWrapper::message, this, &DocumentWrapper::message);
+    }
+    return wrapper;
 }
 
 EdgeWrapper * DocumentWrapper::edgeWrapper(EdgePtr edge) const
 {
-    Q_ASSERT(m_edgeMap.contains(edge));
-    return m_edgeMap.value(edge);
+    EdgeWrapper *wrapper = m_edgeMap.value(edge);
+    if (!wrapper) {
+        wrapper = new EdgeWrapper(edge, const_cast<DocumentWrapper*>(this));
+        m_edgeMap.insert(edge, wrapper);
+        connect(wrapper, &EdgeWrapper::message, this, &DocumentWrapper::message);
+    }
+    return wrapper;
 }
 
-QScriptValue DocumentWrapper::node(int id) const
+QVector<qreal> DocumentWrapper::distances(NodePtr source, const QString &lengthProperty, const QVector<int> &targets) const
 {
-    //TODO average access time is linear, which might drastically be improved by
-    //     using proper caching mechanisms at Document objects
-    for (auto const &node : m_document->nodes()) {
-        if (node->id() == id) {
-            return m_engine->newQObject(nodeWrapper(node),
-                                        QScriptEngine::QtOwnership,
-                                        QScriptEngine::AutoCreateDynamicProperties);
+    // the document hands out the same snapshot as long as nothing relevant changed
+    GraphSnapshotPtr graph;
+    int sourceIndex = -1;
+    synchronized([&]() {
+        graph = m_document->snapshot(EdgeTypePtr(), lengthProperty);
+        sourceIndex = source->documentIndex();
+    });
+    if (!graph) { // aborted execution
+        return QVector<qreal>();
+    }
+    // a new snapshot invalidates all distances computed for the previous one
+    if (m_distanceCacheGraphs.value(lengthProperty) != graph) {
+        auto stale = m_distanceCache.begin();
+        while (stale != m_distanceCache.end()) {
+            if (stale.key().second == lengthProperty) {
+                stale = m_distanceCache.erase(stale);
+            } else {
+                ++stale;
+            }
         }
+        m_distanceCacheGraphs.insert(lengthProperty, graph);
+    }
+    const QPair<NodePtr, QString> key = qMakePair(source, lengthProperty);
+    auto iter = m_distanceCache.constFind(key);
+    if (iter != m_distanceCache.constEnd() && iter->graph == graph) {
+        bool settled = true;
+        if (targets.isEmpty()) {
+            settled = !iter->settled.contains(false);
+        }
+        foreach (int target, targets) {
+            if (!iter->settled.at(target)) {
+                settled = false;
+                break;
+            }
+        }
+        if (settled) {
+            return iter->distances;
+        }
+    }
+
+    DistanceCacheEntry entry;
+    entry.graph = graph;
+    entry.distances = GraphAlgorithms::shortestPathDistances(graph, sourceIndex, targets, &entry.settled);
+    m_distanceCache.insert(key, entry);
+    return entry.distances;
+}
+
+QScriptValue DocumentWrapper::scriptArray(const QVector<QScriptValue> &values) const
+{
+    QScriptValue array = m_engine->newArray(values.count());
+    for (int i = 0; i < values.count(); ++i) {
+        array.setProperty(i, values.at(i));
+    }
+    return array;
+}
+
+QScriptValue DocumentWrapper::node(int id) const
+{
+    NodePtr node = synchronized([&]() { return m_document->node(id); });
+    if (node) {
+        return nodeWrapper(node)->scriptValue();
     }
     QString command = QString("Document.node(%1)").arg(id);
     emit message(i18nc("@info:shell", "%1: no node with ID %2 registered", command, id), Kernel::ErrorMessage);
@@ -107,88 +367,91 @@ QScriptValue DocumentWrapper::node(int id) const
 
 QScriptValue DocumentWrapper::nodes() const
 {
-    NodeList nodes = m_document->nodes();
-    QScriptValue array = m_engine->newArray(nodes.length());
-    for (int i = 0; i < nodes.length(); ++i) {
-        QScriptValue nodeScriptValue = m_engine->newQObject(nodeWrapper(nodes.at(i)),
-                                                            QScriptEngine::QtOwnership,
-                                                            QScriptEngine::AutoCreateDynamicProperties);
-        array.setProperty(i, nodeScriptValue);
+    uint revision = 0;
+    NodeList nodes = synchronized([&]() {
+        revision = m_document->nodesRevision();
+        return m_document->nodes();
+    });
+    // every call creates a new array since scripts may modify it, but the elements are reused
+    if (m_nodeValuesRevision != revision || m_nodeValues.count() != nodes.count()) {
+        m_nodeValues.resize(nodes.count());
+        for (int i = 0; i < nodes.count(); ++i) {
+            m_nodeValues[i] = nodeWrapper(nodes.at(i))->scriptValue();
+        }
+        m_nodeValuesRevision = revision;
     }
-    return array;
+    return scriptArray(m_nodeValues);
 }
 
 QScriptValue DocumentWrapper::nodes(int type) const
 {
-    NodeTypePtr typePtr;
-    foreach (NodeTypePtr typeTest, m_document->nodeTypes()) {
-        if (typeTest->id() == type) {
-            typePtr = typeTest;
-            break;
-        }
-    }
-    if (!typePtr) {
+    bool validType = true;
+    NodeList nodes = synchronized([&]() -> NodeList {
+        NodeTypePtr typePtr = m_document->nodeType(type);
+        validType = !typePtr.isNull();
+        return validType ? m_document->nodes(typePtr) : NodeList();
+    });
+    if (!validType) {
         QString command = QString("Document.nodes(%1)").arg(type);
         emit message(i18nc("@info:shell", "%1: node type ID %2 not registered", command, type), Kernel::ErrorMessage);
         return m_engine->newArray();
     }
-    NodeList nodes = m_document->nodes(typePtr);
     QScriptValue array = m_engine->newArray(nodes.length());
     for (int i = 0; i < nodes.length(); ++i) {
-        QScriptValue nodeScriptValue = m_engine->newQObject(nodeWrapper(nodes.at(i)),
-                                                            QScriptEngine::QtOwnership,
-                                                            QScriptEngine::AutoCreateDynamicProperties);
-        array.setProperty(i, nodeScriptValue);
+        array.setProperty(i, nodeWrapper(nodes.at(i))->scriptValue());
     }
     return array;
 }
 
 QScriptValue DocumentWrapper::edges() const
 {
-    EdgeList edges = m_document->edges();
-    QScriptValue array = m_engine->newArray(edges.length());
-    for (int i = 0; i < edges.length(); ++i) {
-        QScriptValue edgeScriptValue = m_engine->newQObject(edgeWrapper(edges.at(i)),
-                                                            QScriptEngine::QtOwnership,
-                                                            QScriptEngine::AutoCreateDynamicProperties);
-        array.setProperty(i, edgeScriptValue);
+    uint revision = 0;
+    EdgeList edges = synchronized([&]() {
+        revision = m_document->edgesRevision();
+        return m_document->edges();
+    });
+    if (m_edgeValuesRevision != revision || m_edgeValues.count() != edges.count()) {
+        m_edgeValues.resize(edges.count());
+        for (int i = 0; i < edges.count(); ++i) {
+            m_edgeValues[i] = edgeWrapper(edges.at(i))->scriptValue();
+        }
+        m_edgeValuesRevision = revision;
     }
-    return array;
+    return scriptArray(m_edgeValues);
 }
 
 QScriptValue DocumentWrapper::edges(int type) const
 {
-    EdgeTypePtr typePtr;
-    foreach (EdgeTypePtr typeTest, m_document->edgeTypes()) {
-        if (typeTest->id() == type) {
-            typePtr = typeTest;
-            break;
-        }
-    }
-    if (!typePtr) {
+    bool validType = true;
+    EdgeList edges = synchronized([&]() -> EdgeList {
+        EdgeTypePtr typePtr = m_document->edgeType(type);
+        validType = !typePtr.isNull();
+        return validType ? m_document->edges(typePtr) : EdgeList();
+    });
+    if (!validType) {
         QString command = QString("Document.edges(%1)").arg(type);
         emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, type), Kernel::ErrorMessage);
         return m_engine->newArray();
     }
-    EdgeList edges = m_document->edges(typePtr);
     QScriptValue array = m_engine->newArray(edges.length());
     for (int i = 0; i < edges.length(); ++i) {
-        QScriptValue edgeScriptValue = m_engine->newQObject(edgeWrapper(edges.at(i)),
-                                                            QScriptEngine::QtOwnership,
-                                                            QScriptEngine::AutoCreateDynamicProperties);
-        array.setProperty(i, edgeScriptValue);
+        array.setProperty(i, edgeWrapper(edges.at(i))->scriptValue());
     }
     return array;
 }
 
 QScriptValue DocumentWrapper::createNode(int x, int y)
 {
-    NodePtr node = Node::create(m_document);
-    node->setX(x);
-    node->setY(y);
-    return m_engine->newQObject(nodeWrapper(node),
-                                QScriptEngine::QtOwnership,
-                                QScriptEngine::AutoCreateDynamicProperties);
+    NodePtr node = synchronized([&]() -> NodePtr {
+        NodePtr node = Node::create(m_document);
+        node->setX(x);
+        node->setY(y);
+        return node;
+    });
+    if (!node) { // aborted execution
+        return QScriptValue();
+    }
+    return nodeWrapper(node)->scriptValue();
 }
 
 QScriptValue DocumentWrapper::createEdge(NodeWrapper *from, NodeWrapper *to)
@@ -203,10 +466,11 @@ QScriptValue DocumentWrapper::createEdge(NodeWrapper *from, NodeWrapper *to)
         emit message(i18nc("@info:shell", "%1: \"to\" is not a valid node object", command), Kernel::ErrorMessage);
         return QScriptValue();
     }
-    EdgePtr edge = Edge::create(from->node(), to->node());
-    return m_engine->newQObject(edgeWrapper(edge),
-                                QScriptEngine::QtOwnership,
-                                QScriptEngine::AutoCreateDynamicProperties);
+    EdgePtr edge = synchronized([&]() { return Edge::create(from->node(), to->node()); });
+    if (!edge) { // aborted execution
+        return QScriptValue();
+    }
+    return edgeWrapper(edge)->scriptValue();
 }
 
 void DocumentWrapper::remove(NodeWrapper *node)
@@ -216,11 +480,13 @@ void DocumentWrapper::remove(NodeWrapper *node)
         emit message(i18nc("@info:shell", "%1: \"node\" is not a valid node object", command), Kernel::ErrorMessage);
         return;
     }
-    // note: The NodeWrapper object explicitly is not removed freom m_nodeMap and by this the node object is not removed.
-    // This has the benefit to not taking care validity of Node, NodeWrapper and its QScriptObject, but on the downside
-    // leads to much used memory, that is only freed after run.
-    // TODO: we need a mechanism that carefully implements on-the-fly object deletions
-    node->node()->destroy();
+    const NodePtr nodePtr = node->node();
+    const EdgeList edges = synchronized([&]() -> EdgeList {
+        const EdgeList edges = nodePtr->edges();
+        nodePtr->destroy();
+        return edges;
+    });
+    releaseWrappers(nodePtr, edges);
 }
 
 void DocumentWrapper::remove(EdgeWrapper *edge)
@@ -230,9 +496,301 @@ void DocumentWrapper::remove(EdgeWrapper *edge)
         emit message(i18nc("@info:shell", "%1: \"edge\" is not a valid edge object", command), Kernel::ErrorMessage);
         return;
     }
-    // note: The EdgeWrapper object explicitly is not removed freom m_edgeMap and by this the edge object is not removed.
-    // This has the benefit to not taking care validity of Edge, EdgeWrapper and its QScriptObject, but on the downside
-    // leads to much used memory, that is only freed after run.
-    // TODO: we need a mechanism that carefully implements on-the-fly object deletions
-    edge->edge()->destroy();
+    const EdgePtr edgePtr = edge->edge();
+    synchronized([&]() { edgePtr->destroy(); });
+    releaseWrappers(NodePtr(), EdgeList() << edgePtr);
+}
+
+void DocumentWrapper::releaseWrappers(NodePtr node, const EdgeList &edges)
+{
+    // The script engine only holds guarded pointers to the wrappers, such that script values of
+    // deleted wrappers become invalid instead of dangling. Deleting the wrappers right away keeps
+    // memory bounded for scripts that create and remove many elements.
+    foreach (const EdgePtr &edge, edges) {
+        EdgeWrapper *wrapper = m_edgeMap.take(edge);
+        m_edgesWithScriptProperties.remove(wrapper);
+        delete wrapper;
+    }
+    if (node) {
+        NodeWrapper *wrapper = m_nodeMap.take(node);
+        m_nodesWithScriptProperties.remove(wrapper);
+        delete wrapper;
+        auto iter = m_distanceCache.begin();
+        while (iter != m_distanceCache.end()) {
+            if (iter.key().first == node) {
+                iter = m_distanceCache.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+}
+
+QScriptValue DocumentWrapper::distanceMatrix(const QString &lengthProperty) const
+{
+    GraphSnapshotPtr graph = synchronized([&]() { return m_document->snapshot(EdgeTypePtr(), lengthProperty); });
+    if (!graph) { // aborted execution
+        return m_engine->newArray();
+    }
+    if (graph->nodeCount() > GraphAlgorithms::maxDistanceMatrixNodes()) {
+        QString command = QString("Document.distanceMatrix(%1)").arg(lengthProperty);
+        emit message(i18nc("@info:shell", "%1: the document has %2 nodes, but distance matrices are limited to %3 nodes",
+                           command, graph->nodeCount(), GraphAlgorithms::maxDistanceMatrixNodes()), Kernel::ErrorMessage);
+        return m_engine->newArray();
+    }
+    const QVector<qreal> matrix = GraphAlgorithms::distanceMatrix(graph);
+    const int n = graph->nodeCount();
+    QScriptValue rows = m_engine->newArray(n);
+    for (int i = 0; i < n; ++i) {
+        QScriptValue row = m_engine->newArray(n);
+        for (int j = 0; j < n; ++j) {
+            row.setProperty(j, matrix.at(i * n + j));
+        }
+        rows.setProperty(i, row);
+    }
+    return rows;
+}
+
+void DocumentWrapper::layout(const QString &algorithm)
+{
+    if (algorithm != QLatin1String("forcedirected") && algorithm != QLatin1String("multilevel")
+        && algorithm != QLatin1String("layered") && algorithm != QLatin1String("circle")) {
+        QString command = QString("Document.layout(algorithm)");
+        emit message(i18nc("@info:shell", "%1: unknown layout algorithm \"%2\"", command, algorithm), Kernel::ErrorMessage);
+        return;
+    }
+    if (algorithm == QLatin1String("circle")) { // linear time, hence not worth copying the graph
+        synchronized([&]() {
+            Topology topology;
+            topology.applyCircleAlignment(m_document->nodes());
+        });
+        return;
+    }
+
+    // only the graph is copied in the document's thread, the layout is computed in the thread of
+    // the script such that neither the editor nor stopping the script is blocked meanwhile
+    NodeList nodes;
+    QVector<QPointF> positions;
+    QVector<QPair<int, int> > edges;
+    synchronized([&]() {
+        nodes = m_document->nodes();
+        positions = m_document->nodePositions();
+        edges.reserve(m_document->edges().count());
+        foreach (const EdgePtr &edge, m_document->edges()) {
+            edges.append(qMakePair(edge->from()->documentIndex(), edge->to()->documentIndex()));
+        }
+    });
+    if (algorithm == QLatin1String("layered")) {
+        if (nodes.isEmpty()) {
+            return;
+        }
+        LayeredLayout layout;
+        layout.apply(positions, edges);
+    } else {
+        // two nodes cannot have crossing edges
+        if (nodes.count() < 3) {
+            return;
+        }
+        // nodes that are all placed at the same spot, e.g. by scripts, get the natural layout size
+        QRectF boundingRect = LayoutUtils::boundingBox(positions);
+        if (boundingRect.width() < 10 && boundingRect.height() < 10) {
+            boundingRect = QRectF();
+        }
+        AbortObserver observer([this]() { return isAborted(); });
+        if (algorithm == QLatin1String("multilevel")) {
+            MultilevelLayout layout;
+            layout.setBoundingRect(boundingRect);
+            layout.setObserver(&observer);
+            layout.apply(positions, edges);
+        } else {
+            ForceDirectedLayout layout;
+            layout.setBoundingRect(boundingRect);
+            layout.setObserver(&observer);
+            layout.apply(positions, edges);
+        }
+    }
+    if (isAborted()) {
+        return;
+    }
+
+    // nodes removed meanwhile are skipped
+    synchronized([&]() {
+        QVector<QPointF> documentPositions = m_document->nodePositions();
+        for (int i = 0; i < nodes.count(); ++i) {
+            if (nodes.at(i)->isValid()) {
+                documentPositions[nodes.at(i)->documentIndex()] = positions.at(i);
+            }
+        }
+        m_document->setNodePositions(documentPositions);
+    });
+}
+
+bool DocumentWrapper::resolveElements(const QScriptValue &elements, const QString &command,
+                                      NodeList &nodes, QVector<int> &nodePositions,
+                                      EdgeList &edges, QVector<int> &edgePositions) const
+{
+    if (elements.isNumber()) {
+        const int type = elements.toInt32();
+        bool validType = synchronized([&]() -> bool {
+            if (NodeTypePtr nodeType = m_document->nodeType(type)) {
+                nodes = m_document->nodes(nodeType);
+                return true;
+            }
+            if (EdgeTypePtr edgeType = m_document->edgeType(type)) {
+                edges = m_document->edges(edgeType);
+                return true;
+            }
+            return false;
+        });
+        if (!validType) {
+            emit message(i18nc("@info:shell", "%1: type ID %2 not registered", command, type), Kernel::ErrorMessage);
+            return false;
+        }
+        for (int i = 0; i < nodes.count(); ++i) {
+            nodePositions.append(i);
+        }
+        for (int i = 0; i < edges.count(); ++i) {
+            edgePositions.append(i);
+        }
+        return true;
+    }
+    if (!elements.isArray()) {
+        emit message(i18nc("@info:shell", "%1: \"elements\" is neither an array nor a type ID", command), Kernel::ErrorMessage);
+        return false;
+    }
+    const int length = elements.property("length").toInt32();
+    for (int i = 0; i < length; ++i) {
+        QObject *object = elements.property(i).toQObject();
+        if (NodeWrapper *node = qobject_cast<NodeWrapper*>(object)) {
+            if (node->node()->document() == m_document) {
+                nodes.append(node->node());
+                nodePositions.append(i);
+                continue;
+            }
+        } else if (EdgeWrapper *edge = qobject_cast<EdgeWrapper*>(object)) {
+            if (edge->edge()->from()->document() == m_document) {
+                edges.append(edge->edge());
+                edgePositions.append(i);
+                continue;
+            }
+        }
+        emit message(i18nc("@info:shell", "%1: element %2 is not a node or edge of this document", command, i), Kernel::ErrorMessage);
+        return false;
+    }
+    return true;
+}
+
+void DocumentWrapper::setPropertyValues(const QScriptValue &elements, const QString &property, const QScriptValue &values)
+{
+    const QString command = QString("Document.setPropertyValues(elements, %1, values)").arg(property);
+    NodeList nodes;
+    EdgeList edges;
+    QVector<int> nodePositions;
+    QVector<int> edgePositions;
+    if (!resolveElements(elements, command, nodes, nodePositions, edges, edgePositions)) {
+        return;
+    }
+    QVector<QVariant> nodeValues;
+    QVector<QVariant> edgeValues;
+    if (values.isArray()) {
+        if (values.property("length").toInt32() != nodes.count() + edges.count()) {
+            emit message(i18nc("@info:shell", "%1: number of values does not match number of elements", command), Kernel::ErrorMessage);
+            return;
+        }
+        nodeValues.reserve(nodes.count());
+        foreach (int position, nodePositions) {
+            nodeValues.append(values.property(position).toVariant());
+        }
+        edgeValues.reserve(edges.count());
+        foreach (int position, edgePositions) {
+            edgeValues.append(values.property(position).toVariant());
+        }
+    } else {
+        nodeValues.append(values.toVariant());
+        edgeValues.append(values.toVariant());
+    }
+
+    // elements whose type does not register the property only store the value at their wrapper,
+    // like it is the case for single property assignments
+    QVector<bool> nodeRegistered(nodes.count());
+    QVector<bool> edgeRegistered(edges.count());
+    synchronized([&]() {
+        for (int i = 0; i < nodes.count(); ++i) {
+            nodeRegistered[i] = nodes.at(i)->type()->dynamicPropertyIndex(property) >= 0;
+        }
+        for (int i = 0; i < edges.count(); ++i) {
+            edgeRegistered[i] = edges.at(i)->type()->dynamicPropertyIndex(property) >= 0;
+        }
+        if (!nodes.isEmpty()) {
+            m_document->setNodeProperties(nodes, property, nodeValues);
+        }
+        if (!edges.isEmpty()) {
+            m_document->setEdgeProperties(edges, property, edgeValues);
+        }
+    });
+    for (int i = 0; i < nodes.count(); ++i) {
+        NodeWrapper *wrapper = nodeRegistered.at(i) ? m_nodeMap.value(nodes.at(i)) : nodeWrapper(nodes.at(i));
+        if (wrapper) {
+            wrapper->updateDynamicProperty(property, nodeValues.count() == 1 ? nodeValues.first() : nodeValues.at(i));
+            if (!nodeRegistered.at(i)) {
+                scriptPropertyAdded(wrapper);
+            }
+        }
+    }
+    for (int i = 0; i < edges.count(); ++i) {
+        EdgeWrapper *wrapper = edgeRegistered.at(i) ? m_edgeMap.value(edges.at(i)) : edgeWrapper(edges.at(i));
+        if (wrapper) {
+            wrapper->updateDynamicProperty(property, edgeValues.count() == 1 ? edgeValues.first() : edgeValues.at(i));
+            if (!edgeRegistered.at(i)) {
+                scriptPropertyAdded(wrapper);
+            }
+        }
+    }
+}
+
+QScriptValue DocumentWrapper::propertyValues(const QScriptValue &elements, const QString &property) const
+{
+    const QString command = QString("Document.propertyValues(elements, %1)").arg(property);
+    NodeList nodes;
+    EdgeList edges;
+    QVector<int> nodePositions;
+    QVector<int> edgePositions;
+    if (!resolveElements(elements, command, nodes, nodePositions, edges, edgePositions)) {
+        return m_engine->newArray();
+    }
+    QVector<QVariant> nodeValues(nodes.count());
+    QVector<QVariant> edgeValues(edges.count());
+    QVector<bool> nodeRegistered(nodes.count());
+    QVector<bool> edgeRegistered(edges.count());
+    synchronized([&]() {
+        for (int i = 0; i < nodes.count(); ++i) {
+            const int index = nodes.at(i)->type()->dynamicPropertyIndex(property);
+            nodeRegistered[i] = index >= 0;
+            nodeValues[i] = nodes.at(i)->dynamicProperty(index);
+        }
+        for (int i = 0; i < edges.count(); ++i) {
+            const int index = edges.at(i)->type()->dynamicPropertyIndex(property);
+            edgeRegistered[i] = index >= 0;
+            edgeValues[i] = edges.at(i)->dynamicProperty(index);
+        }
+    });
+
+    const QByteArray name = property.toUtf8();
+    QScriptValue array = m_engine->newArray(nodes.count() + edges.count());
+    for (int i = 0; i < nodes.count(); ++i) {
+        // values of unregistered properties only exist at the wrapper, if at all
+        if (!nodeRegistered.at(i)) {
+            NodeWrapper *wrapper = m_nodeMap.value(nodes.at(i));
+            nodeValues[i] = wrapper ? wrapper->property(name) : QVariant();
+        }
+        array.setProperty(nodePositions.at(i), nodeValues.at(i).isValid() ? m_engine->toScriptValue(nodeValues.at(i)) : m_engine->undefinedValue());
+    }
+    for (int i = 0; i < edges.count(); ++i) {
+        if (!edgeRegistered.at(i)) {
+            EdgeWrapper *wrapper = m_edgeMap.value(edges.at(i));
+            edgeValues[i] = wrapper ? wrapper->property(name) : QVariant();
+        }
+        array.setProperty(edgePositions.at(i), edgeValues.at(i).isValid() ? m_engine->toScriptValue(edgeValues.at(i)) : m_engine->undefinedValue());
+    }
+    return array;
 }
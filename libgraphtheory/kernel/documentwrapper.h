@@ -29,8 +29,16 @@
 #include "graphdocument.h"
 
 #include <QScriptEngine>
+#include <QAtomicInt>
 #include <QObject>
 #include <QColor>
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QThread>
+#include <QVector>
+#include <functional>
+#include <type_traits>
 
 namespace GraphTheory
 {
@@ -41,27 +49,105 @@ class EdgeWrapper;
 /**
  * \class DocumentWrapper
  * Wraps DocumentPtr to be accessible via QtScript.
+ *
+ * The wrapper and the script engine may live in a different thread than the document. In this
+ * case, all accesses to graph objects must be performed via synchronized(), which executes them
+ * in the thread of the document.
+ *
+ * Such calls are cancelled if the execution is aborted or the document is destroyed, because the
+ * document's thread may never process them. Cancelled calls return default constructed values.
  */
 class DocumentWrapper : public QObject
 {
     Q_OBJECT
 
 public:
-    DocumentWrapper(GraphDocumentPtr document, QScriptEngine *engine);
+    /**
+     * \param aborted flag that is set from any thread to abort the current script execution
+     */
+    DocumentWrapper(GraphDocumentPtr document, QScriptEngine *engine, const QAtomicInt *aborted = nullptr);
     virtual ~DocumentWrapper();
 
     QScriptEngine * engine() const;
 
     /**
-     * \return wrapper for \p node
+     * \return the wrapped document
+     */
+    GraphDocumentPtr document() const;
+
+    /**
+     * \return script object of this wrapper, which is created only once
+     */
+    QScriptValue scriptValue() const;
+
+    /**
+     * Delete the wrappers of nodes and edges that were removed from the document since the last
+     * call, e.g. by the user between two script executions. The document is only searched for
+     * removed elements if its node or edge list changed meanwhile.
+     */
+    void releaseRemovedElements();
+
+    /**
+     * Copy the dynamic property values of all nodes and edges that changed since the last call
+     * into their wrappers, e.g. values that the user edited between two script executions. The
+     * values of all changed elements are read by a single call into the document's thread.
+     */
+    void updateChangedProperties();
+
+    /**
+     * Remove the dynamic properties that scripts assigned to node and edge wrappers without
+     * registering them at the node or edge type. Only wrappers that got such properties since the
+     * last call are visited.
+     */
+    void resetScriptProperties();
+
+    /**
+     * Drop all cached distances, such that the snapshots they refer to and the nodes and edges
+     * of these are released. Called after each script execution.
+     */
+    void clearDistanceCache();
+
+    /**
+     * Remember that a script assigned an unregistered dynamic property to \p wrapper.
+     */
+    void scriptPropertyAdded(NodeWrapper *wrapper) const;
+    void scriptPropertyAdded(EdgeWrapper *wrapper) const;
+
+    /**
+     * Call \p function in the thread of the wrapped document and return its result. If the script
+     * is executed in the thread of the document, \p function is called directly. Otherwise the
+     * calling thread is blocked until the document's thread processed the call, by which all
+     * accesses to graph objects are serialized with those of the GUI.
+     */
+    template<typename Function>
+    auto synchronized(Function function) const -> decltype(function())
+    {
+        if (QThread::currentThread() == m_document->thread()) {
+            return function();
+        }
+        return synchronizedCall(function, std::is_void<decltype(function())>());
+    }
+
+    /**
+     * \return wrapper for \p node, which is created if it does not exist yet
      */
     NodeWrapper * nodeWrapper(NodePtr node) const;
 
     /**
-     * \return wrapper for \p edge
+     * \return wrapper for \p edge, which is created if it does not exist yet
      */
     EdgeWrapper * edgeWrapper(EdgePtr edge) const;
 
+    /**
+     * Compute shortest path distances from \p source, where edge lengths are given by the dynamic
+     * edge property \p lengthProperty. Results are cached until the document structure or an edge
+     * property changes.
+     * \param targets indices of the requested nodes in GraphDocument::nodes(), all nodes if empty
+     * \return distances to all nodes in order of GraphDocument::nodes(), only those of \p targets
+     *         are guaranteed to be final
+     */
+    QVector<qreal> distances(NodePtr source, const QString &lengthProperty, const QVector<int> &targets = QVector<int>()) const;
+
     Q_INVOKABLE QScriptValue node(int id) const;
     Q_INVOKABLE QScriptValue nodes() const;
     Q_INVOKABLE QScriptValue nodes(int type) const;
@@ -71,20 +157,90 @@ public:
     Q_INVOKABLE QScriptValue createEdge(GraphTheory::NodeWrapper *from, GraphTheory::NodeWrapper *to);
     Q_INVOKABLE void remove(GraphTheory::NodeWrapper *node);
     Q_INVOKABLE void remove(GraphTheory::EdgeWrapper *edge);
+    Q_INVOKABLE QScriptValue distanceMatrix(const QString &lengthProperty) const;
+
+    /**
+     * Arrange all nodes by the layout \p algorithm, which is one of "forcedirected",
+     * "multilevel", "layered" and "circle". Except for the circle, the layout is computed in the
+     * thread of the script and written with a single position update.
+     */
+    Q_INVOKABLE void layout(const QString &algorithm);
+
+    /**
+     * Set dynamic property \p property of many nodes or edges with a single change notification.
+     * \param elements array of nodes and edges or the ID of a node type or edge type
+     * \param values either one value for all elements or an array with one value per element
+     */
+    Q_INVOKABLE void setPropertyValues(const QScriptValue &elements, const QString &property, const QScriptValue &values);
+
+    /**
+     * \param elements array of nodes and edges or the ID of a node type or edge type
+     * \return array of the values of dynamic property \p property of \p elements
+     */
+    Q_INVOKABLE QScriptValue propertyValues(const QScriptValue &elements, const QString &property) const;
 
 Q_SIGNALS:
     void message(const QString &messageString, Kernel::MessageType type) const;
 
-private Q_SLOTS:
-    void registerWrapper(NodePtr node);
-    void registerWrapper(EdgePtr edge);
-
 private:
     Q_DISABLE_COPY(DocumentWrapper)
+    template<typename Function>
+    void synchronizedCall(Function function, std::true_type) const
+    {
+        invokeInDocumentThread(function);
+    }
+    template<typename Function>
+    auto synchronizedCall(Function function, std::false_type) const -> decltype(function())
+    {
+        typename std::decay<decltype(function())>::type result{};
+        invokeInDocumentThread([&]() { result = function(); });
+        return result;
+    }
+    void invokeInDocumentThread(const std::function<void()> &function) const;
+    /** @return true if calls into the document's thread must not be waited for anymore **/
+    bool isAborted() const;
+    /**
+     * Delete the wrappers of the destroyed \p node and of its destroyed \p edges. Script values
+     * that still refer to them become invalid.
+     */
+    void releaseWrappers(NodePtr node, const EdgeList &edges);
+    /**
+     * Resolve \p elements as given to setPropertyValues() to lists of nodes and edges, where
+     * \p nodePositions and \p edgePositions hold the positions of these in \p elements.
+     * \return false and emit an error message if \p elements is not valid
+     */
+    bool resolveElements(const QScriptValue &elements, const QString &command,
+                         NodeList &nodes, QVector<int> &nodePositions,
+                         EdgeList &edges, QVector<int> &edgePositions) const;
+    /** @return new script array with elements \p values **/
+    QScriptValue scriptArray(const QVector<QScriptValue> &values) const;
+
     const GraphDocumentPtr m_document;
     QScriptEngine *m_engine;
-    QMap<NodePtr, NodeWrapper*> m_nodeMap;
-    QMap<EdgePtr, EdgeWrapper*> m_edgeMap;
+    const QAtomicInt *m_aborted;
+    QAtomicInt m_documentDestroyed; //!< set in the thread of the document
+    mutable QHash<NodePtr, NodeWrapper*> m_nodeMap;
+    mutable QHash<EdgePtr, EdgeWrapper*> m_edgeMap;
+    mutable QVector<QScriptValue> m_nodeValues; // script values in order of GraphDocument::nodes()
+    mutable uint m_nodeValuesRevision;
+    mutable QVector<QScriptValue> m_edgeValues; // script values in order of GraphDocument::edges()
+    mutable uint m_edgeValuesRevision;
+    uint m_nodeWrappersRevision; // nodes revision for which m_nodeMap contains no removed nodes
+    uint m_edgeWrappersRevision; // edges revision for which m_edgeMap contains no removed edges
+    mutable QScriptValue m_scriptValue;
+    mutable QSet<NodeWrapper*> m_nodesWithScriptProperties;
+    mutable QSet<EdgeWrapper*> m_edgesWithScriptProperties;
+    // set in the thread of the document if values of many elements changed without per element signals
+    QAtomicInt m_nodePropertiesChanged;
+    QAtomicInt m_edgePropertiesChanged;
+
+    struct DistanceCacheEntry {
+        GraphSnapshotPtr graph; // snapshot the distances were computed for
+        QVector<qreal> distances;
+        QVector<bool> settled;
+    };
+    mutable QHash<QPair<NodePtr, QString>, DistanceCacheEntry> m_distanceCache;
+    mutable QHash<QString, GraphSnapshotPtr> m_distanceCacheGraphs; // current snapshot per length property
 };
 }
 
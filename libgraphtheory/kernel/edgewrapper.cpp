@@ -24,9 +24,11 @@
 #include "edgetype.h"
 #include "edge.h"
 #include "edgetypestyle.h"
+#include "scriptprofiler.h"
 #include <KLocalizedString>
 #include <QColor>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QEvent>
 
 using namespace GraphTheory;
@@ -34,11 +36,16 @@ using namespace GraphTheory;
 EdgeWrapper::EdgeWrapper(EdgePtr edge, DocumentWrapper *documentWrapper)
     : m_edge(edge)
     , m_documentWrapper(documentWrapper)
+    , m_updatingProperties(false)
 {
     connect(m_edge.data(), &Edge::styleChanged, this, [=] () {
-        emit colorChanged(m_edge->type()->style()->color());
+        emit colorChanged(m_documentWrapper->synchronized([this]() { return m_edge->type()->style()->color(); }));
     } );
     connect(m_edge.data(), &Edge::dynamicPropertiesChanged, this, &EdgeWrapper::updateDynamicProperties);
+    // noted in the thread of the document, see DocumentWrapper::updateChangedProperties()
+    connect(m_edge.data(), &Edge::dynamicPropertyChanged, this, [this]() {
+        m_dynamicPropertyChanged.storeRelease(1);
+    }, Qt::DirectConnection);
     connect(m_edge.data(), &Edge::typeChanged, this, &EdgeWrapper::typeChanged);
     updateDynamicProperties();
 }
@@ -53,34 +60,44 @@ EdgePtr EdgeWrapper::edge() const
     return m_edge;
 }
 
+QScriptValue EdgeWrapper::scriptValue() const
+{
+    if (!m_scriptValue.isValid()) {
+        m_scriptValue = m_documentWrapper->engine()->newQObject(const_cast<EdgeWrapper*>(this),
+                                                                QScriptEngine::QtOwnership,
+                                                                QScriptEngine::AutoCreateDynamicProperties);
+    }
+    return m_scriptValue;
+}
+
 int EdgeWrapper::type() const
 {
-    return m_edge->type()->id();
+    return m_documentWrapper->synchronized([this]() { return m_edge->type()->id(); });
 }
 
 void EdgeWrapper::setType(int typeId)
 {
-    EdgeTypePtr newType = m_edge->type();
-    if (newType->id() == typeId) {
-        return;
-    }
-    foreach (EdgeTypePtr type, m_edge->from()->document()->edgeTypes()) {
-        if (type->id() == typeId) {
-            newType = type;
-            break;
+    bool validType = m_documentWrapper->synchronized([this, typeId]() -> bool {
+        if (m_edge->type()->id() == typeId) {
+            return true;
         }
-    }
-    if (newType == m_edge->type()) {
+        EdgeTypePtr newType = m_edge->from()->document()->edgeType(typeId);
+        if (!newType) {
+            return false;
+        }
+        m_edge->setType(newType);
+        return true;
+    });
+    if (!validType) {
         QString command = QString("edge.type = %1)").arg(typeId);
         emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, typeId), Kernel::ErrorMessage);
-        return;
     }
-    m_edge->setType(newType);
     // change signal will be emitted by connection to m_node signal
 }
 
 GraphTheory::NodeWrapper * EdgeWrapper::from() const
 {
+    // edge endpoints never change during the lifetime of an edge
     return m_documentWrapper->nodeWrapper(m_edge->from());
 }
 
@@ -91,21 +108,39 @@ GraphTheory::NodeWrapper * EdgeWrapper::to() const
 
 bool EdgeWrapper::directed() const
 {
-    if (m_edge->type()->direction() == EdgeType::Unidirectional) {
-        return true;
-    }
-    return false;
+    return m_documentWrapper->synchronized([this]() {
+        return m_edge->type()->direction() == EdgeType::Unidirectional;
+    });
 }
 
 bool EdgeWrapper::event(QEvent *e)
 {
     if (e->type() == QEvent::DynamicPropertyChange) {
+        if (m_updatingProperties) {
+            return true;
+        }
         QDynamicPropertyChangeEvent *propertyEvent = static_cast<QDynamicPropertyChangeEvent *>(e);
         QString name = QString::fromUtf8(propertyEvent->propertyName());
         QVariant value = property(propertyEvent->propertyName());
+        // assignments are no function calls of the engine, hence they are timed here
+        ScriptProfiler *profiler = ScriptProfiler::profiler(m_documentWrapper->engine());
+        QElapsedTimer timer;
+        if (profiler) {
+            timer.start();
+        }
         // only propagate property to edge object if it is registered
-        if (m_edge->dynamicProperties().contains(name)) {
+        const bool registered = m_documentWrapper->synchronized([this, name, value]() -> bool {
+            if (!m_edge->dynamicProperties().contains(name)) {
+                return false;
+            }
             m_edge->setDynamicProperty(name, value);
+            return true;
+        });
+        if (!registered) {
+            m_documentWrapper->scriptPropertyAdded(this);
+        }
+        if (profiler) {
+            profiler->recordCall(QStringLiteral("Edge.%1 =").arg(name), timer.nsecsElapsed());
         }
         return true;
     }
@@ -114,13 +149,45 @@ bool EdgeWrapper::event(QEvent *e)
 
 void EdgeWrapper::updateDynamicProperties()
 {
-    foreach (const QString &property, m_edge->dynamicProperties()) {
-        // property value must not be set to QVariant::Invalid, else the properties are not accessible
-        // from the script engine
-        if (m_edge->dynamicProperty(property).isValid()) {
-            setProperty(property.toUtf8(), m_edge->dynamicProperty(property));
-        } else {
-            setProperty(property.toUtf8(), QVariant::Int);
+    QStringList properties;
+    QVector<QVariant> values;
+    m_documentWrapper->synchronized([&]() {
+        properties = m_edge->dynamicProperties();
+        foreach (const QString &property, properties) {
+            values.append(m_edge->dynamicProperty(property));
+        }
+    });
+    for (int i = 0; i < properties.count(); ++i) {
+        updateDynamicProperty(properties.at(i), values.at(i));
+    }
+}
+
+void EdgeWrapper::updateDynamicProperty(const QString &property, const QVariant &value)
+{
+    m_updatingProperties = true;
+    // property value must not be set to QVariant::Invalid, else the properties are not accessible
+    // from the script engine
+    if (value.isValid()) {
+        setProperty(property.toUtf8(), value);
+    } else {
+        setProperty(property.toUtf8(), QVariant::Int);
+    }
+    m_updatingProperties = false;
+}
+
+bool EdgeWrapper::takeDynamicPropertyChange()
+{
+    return m_dynamicPropertyChanged.fetchAndStoreAcquire(0) != 0;
+}
+
+void EdgeWrapper::removeScriptProperties()
+{
+    const QStringList registered = m_documentWrapper->synchronized([&]() { return m_edge->dynamicProperties(); });
+    m_updatingProperties = true;
+    foreach (const QByteArray &name, dynamicPropertyNames()) {
+        if (!registered.contains(QString::fromUtf8(name))) {
+            setProperty(name, QVariant());
         }
     }
+    m_updatingProperties = false;
 }
@@ -27,7 +27,9 @@
 #include "node.h"
 #include "graphdocument.h"
 
+#include <QAtomicInt>
 #include <QObject>
+#include <QScriptValue>
 #include <QColor>
 
 class QEvent;
@@ -55,6 +57,11 @@ public:
 
     EdgePtr edge() const;
 
+    /**
+     * @return script object of this wrapper, which is created once and then reused
+     */
+    QScriptValue scriptValue() const;
+
     /**
      * @return EdgeType::id of corresponding node
      */
@@ -73,6 +80,24 @@ public:
     /** reimplemented from QObject **/
     virtual bool event(QEvent *e) Q_DECL_OVERRIDE;
 
+    /**
+     * Set the script visible value of dynamic property @p property to @p value without writing
+     * it back to the edge, e.g. after the edge value was changed by the document.
+     */
+    void updateDynamicProperty(const QString &property, const QVariant &value);
+
+    /**
+     * Remove all dynamic properties that scripts assigned to this wrapper but that are not
+     * registered at the edge, such that they do not leak into subsequent script executions.
+     */
+    void removeScriptProperties();
+
+    /**
+     * @return true if a dynamic property value of the edge changed since the last call, e.g. by
+     * the user between two script executions
+     */
+    bool takeDynamicPropertyChange();
+
 public Q_SLOTS:
     void updateDynamicProperties();
 
@@ -85,6 +110,9 @@ private:
     Q_DISABLE_COPY(EdgeWrapper)
     const EdgePtr m_edge;
     const DocumentWrapper *m_documentWrapper;
+    mutable QScriptValue m_scriptValue;
+    bool m_updatingProperties; //!< true while values are copied from the edge
+    QAtomicInt m_dynamicPropertyChanged; //!< set in the thread of the document
 };
 }
 
@@ -24,106 +24,361 @@
 #include "nodewrapper.h"
 #include "edgewrapper.h"
 #include "logging_p.h"
+#include "scriptprofiler.h"
 #include "kernel/modules/console/consolemodule.h"
+#include "kernel/modules/algorithms/algorithmsmodule.h"
 
 #include <KLocalizedString>
+#include <QAtomicInt>
+#include <QCache>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QFutureWatcher>
 #include <QScriptEngine>
+#include <QScriptProgram>
+#include <QThread>
+#include <QTimer>
+#include <QtConcurrentRun>
 
 using namespace GraphTheory;
 
+namespace {
+// wrappers are converted to their cached script objects instead of creating new ones per access
+template<typename Wrapper>
+QScriptValue wrapperToScriptValue(QScriptEngine *engine, Wrapper * const &wrapper)
+{
+    return wrapper ? wrapper->scriptValue() : engine->nullValue();
+}
+
+template<typename Wrapper>
+void wrapperFromScriptValue(const QScriptValue &value, Wrapper *&wrapper)
+{
+    wrapper = qobject_cast<Wrapper*>(value.toQObject());
+}
+
+// QScriptSyntaxCheckResult cannot be default constructed, thus it cannot be a QFuture result
+struct SyntaxCheckResult
+{
+    bool valid;
+    int errorLine;
+    QString errorMessage;
+};
+}
+
 class GraphTheory::KernelPrivate {
 public:
-    KernelPrivate()
-        : m_engine(nullptr)
+    /**
+     * Script engine together with the objects that are kept for subsequent executions.
+     */
+    struct EngineContext {
+        EngineContext()
+            : engine(nullptr)
+            , consoleModule(nullptr)
+            , algorithmsModule(nullptr)
+            , receiver(nullptr)
+            , documentWrapper(nullptr)
+            , releaseDocument(false)
+            , programs(20)
+        {
+        }
+
+        QScriptEngine *engine;
+        ConsoleModule *consoleModule; //!< owned by engine
+        AlgorithmsModule *algorithmsModule; //!< owned by engine, refers to the current document
+        QObject *receiver; //!< context object for calls in the thread of the engine
+        DocumentWrapper *documentWrapper; //!< wrapper of the document of the last execution
+        QMetaObject::Connection documentConnection;
+        bool releaseDocument; //!< the document was destroyed during the current execution
+        QAtomicInt aborted; //!< set by Kernel::stop() from any thread
+        QCache<QByteArray, QScriptProgram> programs; //!< recently executed scripts by content hash
+    };
+
+    KernelPrivate(Kernel *q)
+        : q(q)
+        , m_worker(nullptr)
+        , m_profilingEnabled(false)
+        , m_syntaxCheck(0)
     {
+        m_context.receiver = q;
     }
 
     ~KernelPrivate()
     {
+        releaseDocumentWrapper(m_context);
+        delete m_context.engine;
     }
 
     QScriptValue registerGlobalObject(QObject *qobject, const QString &name);
+    void createEngine(EngineContext &context);
+    DocumentWrapper * documentWrapper(EngineContext &context, GraphDocumentPtr document);
+    void releaseDocumentWrapper(EngineContext &context);
+    QScriptProgram program(EngineContext &context, const QString &script, bool profile);
+    QScriptValue run(EngineContext &context, GraphDocumentPtr document, const QString &script, bool profile);
 
-    QScriptEngine *m_engine;
-    ConsoleModule m_consoleModule;
+    Kernel * const q;
+    EngineContext m_context; //!< engine used by execute()
+    QThread m_thread;
+    QObject *m_worker; //!< context object for calls in m_thread
+    EngineContext m_workerContext; //!< engine that is created and used only in m_thread
+    QAtomicInt m_running;
+    bool m_profilingEnabled;
+    int m_syntaxCheck; //!< number of the last requested syntax check
 };
 
 QScriptValue KernelPrivate::registerGlobalObject(QObject *qobject, const QString &name)
 {
-    if (!m_engine) {
+    if (!m_context.engine) {
         qCCritical(GRAPHTHEORY_KERNEL) << "No engine set, aborting global object creation.";
         return 0;
     }
-    QScriptValue globalObject = m_engine->newQObject(qobject);
-    m_engine->globalObject().setProperty(name, globalObject);
+    QScriptValue globalObject = m_context.engine->newQObject(qobject);
+    m_context.engine->globalObject().setProperty(name, globalObject);
 
     return globalObject;
 }
 
-///BEGIN: Kernel
-Kernel::Kernel()
-    : d(new KernelPrivate)
+void KernelPrivate::createEngine(EngineContext &context)
 {
-    connect(&d->m_consoleModule, &ConsoleModule::message, this, &Kernel::processMessage);
+    // everything that does not depend on the executed script is set up only once per engine
+    QScriptEngine *engine = new QScriptEngine;
+    qScriptRegisterMetaType<GraphTheory::NodeWrapper*>(engine, wrapperToScriptValue<NodeWrapper>, wrapperFromScriptValue<NodeWrapper>);
+    qScriptRegisterMetaType<GraphTheory::EdgeWrapper*>(engine, wrapperToScriptValue<EdgeWrapper>, wrapperFromScriptValue<EdgeWrapper>);
+    qScriptRegisterSequenceMetaType<QList<GraphTheory::NodeWrapper*> >(engine);
+    qScriptRegisterSequenceMetaType<QList<GraphTheory::EdgeWrapper*> >(engine);
+
+    // modules are created per engine, since they refer to the document of the engine's execution
+    context.consoleModule = new ConsoleModule(engine);
+    context.algorithmsModule = new AlgorithmsModule(engine);
+    QObject::connect(context.consoleModule, &ConsoleModule::message, q, &Kernel::processMessage);
+    QObject::connect(context.algorithmsModule, &AlgorithmsModule::message, q, &Kernel::processMessage);
+    engine->globalObject().setProperty("Console", engine->newQObject(context.consoleModule));
+    engine->globalObject().setProperty("Algorithms", engine->newQObject(context.algorithmsModule));
+    engine->setProcessEventsInterval(100); //! TODO: Make that changeable.
+    context.engine = engine;
 }
 
-Kernel::~Kernel()
+DocumentWrapper * KernelPrivate::documentWrapper(EngineContext &context, GraphDocumentPtr document)
 {
+    if (context.documentWrapper && context.documentWrapper->document() == document) {
+        // only catch up with elements the user removed or changed since the last execution
+        context.documentWrapper->releaseRemovedElements();
+        context.documentWrapper->updateChangedProperties();
+        return context.documentWrapper;
+    }
+    releaseDocumentWrapper(context);
+    DocumentWrapper *wrapper = new DocumentWrapper(document, context.engine, &context.aborted);
+    QObject::connect(wrapper, &DocumentWrapper::message, q, &Kernel::processMessage);
 
+    // the element wrappers keep the document alive, hence they must not outlive its destruction
+    context.documentConnection = QObject::connect(document.data(), &GraphDocument::aboutToBeDestroyed,
+        context.receiver, [this, &context, wrapper]() {
+            if (context.documentWrapper != wrapper) {
+                return;
+            }
+            if (context.engine->isEvaluating()) {
+                context.releaseDocument = true;
+            } else {
+                releaseDocumentWrapper(context);
+            }
+        });
+    context.documentWrapper = wrapper;
+    return wrapper;
 }
 
-QScriptValue Kernel::execute(GraphDocumentPtr document, const QString &script)
+void KernelPrivate::releaseDocumentWrapper(EngineContext &context)
 {
-    if (!d->m_engine) {
-        d->m_engine = new QScriptEngine(this);
+    QObject::disconnect(context.documentConnection);
+    if (context.engine) {
+        context.engine->globalObject().setProperty("Document", QScriptValue());
     }
+    delete context.documentWrapper;
+    context.documentWrapper = nullptr;
+    context.releaseDocument = false;
+}
 
-    // register meta types
-    qScriptRegisterSequenceMetaType<QList<GraphTheory::NodeWrapper*> >(d->m_engine);
-    qScriptRegisterSequenceMetaType<QList<GraphTheory::EdgeWrapper*> >(d->m_engine);
-    qRegisterMetaType<GraphTheory::NodeWrapper*>();
-    qRegisterMetaType<GraphTheory::EdgeWrapper*>();
+QScriptProgram KernelPrivate::program(EngineContext &context, const QString &script, bool profile)
+{
+    // programs are compiled at their first evaluation, subsequent evaluations skip parsing;
+    // only programs compiled while a profiler is attached report their line positions to it
+    QByteArray key = QCryptographicHash::hash(script.toUtf8(), QCryptographicHash::Sha1);
+    if (profile) {
+        key.append('p');
+    }
+    QScriptProgram *program = context.programs.object(key);
+    if (!program) {
+        program = new QScriptProgram(script);
+        context.programs.insert(key, program);
+    }
+    return *program;
+}
 
-    if (d->m_engine->isEvaluating()) {
-        d->m_engine->abortEvaluation();
+QScriptValue KernelPrivate::run(EngineContext &context, GraphDocumentPtr document, const QString &script, bool profile)
+{
+    if (!context.engine) {
+        createEngine(context);
     }
-    d->m_engine->collectGarbage();
-    d->m_engine->pushContext();
+    QScriptEngine *engine = context.engine;
+    if (engine->isEvaluating()) {
+        engine->abortEvaluation();
+    }
+    context.aborted.storeRelease(0);
+    engine->pushContext();
 
     // add document
-    DocumentWrapper documentWrapper(document, d->m_engine);
-    d->m_engine->globalObject().setProperty("Document", d->m_engine->newQObject(&documentWrapper));
-    connect(&documentWrapper, &DocumentWrapper::message,
-        this, &Kernel::processMessage);
+    DocumentWrapper *documentWrapper = this->documentWrapper(context, document);
+    engine->globalObject().setProperty("Document", documentWrapper->scriptValue());
+    context.algorithmsModule->setDocumentWrapper(documentWrapper);
 
-    // set modules
-    d->m_engine->globalObject().setProperty("Console", d->m_engine->newQObject(&d->m_consoleModule));
+    QScopedPointer<ScriptProfiler> profiler;
+    if (profile) {
+        profiler.reset(new ScriptProfiler(engine));
+        engine->setAgent(profiler.data());
+    }
 
-    // set evaluation
-    d->m_engine->setProcessEventsInterval(100); //! TODO: Make that changeable.
+    // elements are announced one by one, because views must learn about removed elements before
+    // these are deleted; only wholesale rebuilds like file imports use bulk updates
+    QScriptValue result = engine->evaluate(program(context, script, profile)).toString();
 
-    QScriptValue result = d->m_engine->evaluate(script).toString();
-    if (d->m_engine && d->m_engine->hasUncaughtException()) {
-        emit message(result.toString(), WarningMessage);
-        emit message(d->m_engine->uncaughtExceptionBacktrace().join("\n"), InfoMessage);
+    if (engine->hasUncaughtException()) {
+        emit q->message(result.toString(), Kernel::ErrorMessage);
+        emit q->message(engine->uncaughtExceptionBacktrace().join("\n"), Kernel::InfoMessage);
     }
-    if (d->m_engine) {
-        emit message(i18nc("@info status message after successful script execution", "<i>Execution Finished</i>"), InfoMessage);
-        emit message(result.toString(), InfoMessage);
-        d->m_engine->popContext();
+    emit q->message(i18nc("@info status message after successful script execution", "<i>Execution Finished</i>"), Kernel::InfoMessage);
+    emit q->message(result.toString(), Kernel::InfoMessage);
+    engine->popContext();
+    if (profiler) {
+        engine->setAgent(nullptr);
+        foreach (const QString &line, profiler->report()) {
+            emit q->message(line, Kernel::InfoMessage);
+        }
     }
-    // end processing messages
-    disconnect(&documentWrapper, &DocumentWrapper::message, this, &Kernel::processMessage);
 
-    emit executionFinished();
-    d->m_engine->globalObject().setProperty("Document", QScriptValue());
+    // properties that are not registered at the types only live for a single execution
+    context.algorithmsModule->setDocumentWrapper(nullptr);
+    documentWrapper->resetScriptProperties();
+    documentWrapper->clearDistanceCache();
+    if (context.releaseDocument) {
+        releaseDocumentWrapper(context);
+    }
 
     return result;
 }
 
+///BEGIN: Kernel
+Kernel::Kernel()
+    : d(new KernelPrivate(this))
+{
+    qRegisterMetaType<GraphTheory::NodeWrapper*>();
+    qRegisterMetaType<GraphTheory::EdgeWrapper*>();
+    // messages of scripts run by start() are delivered via queued connections
+    qRegisterMetaType<GraphTheory::Kernel::MessageType>();
+}
+
+Kernel::~Kernel()
+{
+    if (!d->m_worker) {
+        return;
+    }
+    stop();
+    d->m_thread.quit();
+    // scripts may wait for calls into this thread, hence keep processing them until the worker returned
+    while (!d->m_thread.wait(20)) {
+        QCoreApplication::processEvents();
+    }
+    delete d->m_worker;
+}
+
+QScriptValue Kernel::execute(GraphDocumentPtr document, const QString &script)
+{
+    QScriptValue result = d->run(d->m_context, document, script, d->m_profilingEnabled);
+    emit executionFinished();
+    return result;
+}
+
+void Kernel::start(GraphDocumentPtr document, const QString &script)
+{
+    if (!d->m_worker) {
+        d->m_worker = new QObject;
+        d->m_worker->moveToThread(&d->m_thread);
+        d->m_workerContext.receiver = d->m_worker;
+        connect(&d->m_thread, &QThread::finished, d->m_worker, [=]() {
+            d->releaseDocumentWrapper(d->m_workerContext);
+            delete d->m_workerContext.engine;
+            d->m_workerContext.engine = nullptr;
+            d->m_workerContext.consoleModule = nullptr;
+            d->m_workerContext.algorithmsModule = nullptr;
+        }, Qt::DirectConnection);
+        d->m_thread.start();
+    }
+    d->m_running.ref();
+    const bool profile = d->m_profilingEnabled;
+    QTimer::singleShot(0, d->m_worker, [=]() {
+        d->run(d->m_workerContext, document, script, profile);
+        d->m_running.deref();
+        // emitted from the worker thread, thus delivered queued to receivers in the GUI thread
+        emit executionFinished();
+    });
+}
+
+bool Kernel::isRunning() const
+{
+    return d->m_running.load() > 0;
+}
+
 void Kernel::stop()
 {
-    d->m_engine->abortEvaluation();
+    // scripts waiting for calls into the document's thread are released, even if it never
+    // processes these calls anymore
+    d->m_context.aborted.storeRelease(1);
+    d->m_workerContext.aborted.storeRelease(1);
+    if (d->m_context.engine && d->m_context.engine->isEvaluating()) {
+        d->m_context.engine->abortEvaluation();
+    }
+    if (d->m_worker) {
+        // the engine must be aborted from its own thread, which handles this call while
+        // processing events during the evaluation
+        QTimer::singleShot(0, d->m_worker, [=]() {
+            if (d->m_workerContext.engine && d->m_workerContext.engine->isEvaluating()) {
+                d->m_workerContext.engine->abortEvaluation();
+            }
+        });
+    }
+}
+
+void Kernel::setProfilingEnabled(bool enabled)
+{
+    d->m_profilingEnabled = enabled;
+}
+
+bool Kernel::isProfilingEnabled() const
+{
+    return d->m_profilingEnabled;
+}
+
+void Kernel::checkSyntax(const QString &script)
+{
+    const int check = ++d->m_syntaxCheck;
+    QFutureWatcher<SyntaxCheckResult> *watcher = new QFutureWatcher<SyntaxCheckResult>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [=]() {
+        if (check == d->m_syntaxCheck) {
+            const SyntaxCheckResult result = watcher->result();
+            emit syntaxChecked(result.valid, result.errorLine, result.errorMessage);
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([script]() {
+        const QScriptSyntaxCheckResult syntax = QScriptEngine::checkSyntax(script);
+        SyntaxCheckResult result;
+        result.valid = (syntax.state() == QScriptSyntaxCheckResult::Valid);
+        result.errorLine = syntax.errorLineNumber();
+        result.errorMessage = syntax.errorMessage();
+        // incomplete scripts, e.g. with unclosed blocks, are only detected at their end
+        if (syntax.state() == QScriptSyntaxCheckResult::Intermediate) {
+            result.errorLine = script.count('\n') + 1;
+            result.errorMessage = i18nc("@info:shell", "unexpected end of script");
+        }
+        return result;
+    }));
 }
 
 void Kernel::processMessage(const QString &messageString, Kernel::MessageType type)
@@ -55,8 +55,43 @@ public:
      * execute javascript @p script on @p document and @return result as reported by engine
      */
     QScriptValue execute(GraphTheory::GraphDocumentPtr document, const QString &script);
+
+    /**
+     * Start execution of javascript @p script on @p document in a worker thread and return
+     * immediately. All accesses of the script to the document are performed in the thread of
+     * @p document, such that the GUI stays responsive. Signal executionFinished() is emitted
+     * when the script terminated.
+     */
+    void start(GraphTheory::GraphDocumentPtr document, const QString &script);
+
+    /**
+     * @return true if a script that was started by start() is not finished yet
+     */
+    bool isRunning() const;
+
+    /**
+     * abort the currently evaluated script
+     */
     void stop();
 
+    /**
+     * If @p enabled, scripts that are executed afterwards are profiled and a summary of the
+     * time spent per script line and per script API call is emitted as info message after the
+     * execution. Profiling slows down the execution and is disabled by default.
+     */
+    void setProfilingEnabled(bool enabled);
+
+    /**
+     * @return true if script executions are profiled
+     */
+    bool isProfilingEnabled() const;
+
+    /**
+     * Check the syntax of @p script in a background thread and report the result by signal
+     * syntaxChecked(). Results of checks that were superseded by a later call are dropped.
+     */
+    void checkSyntax(const QString &script);
+
 
 private Q_SLOTS:
     /** process all incoming messages and resend them afterwards**/
@@ -65,10 +100,17 @@ private Q_SLOTS:
 Q_SIGNALS:
     void message(const QString &message, GraphTheory::Kernel::MessageType type);
     void executionFinished();
+    /**
+     * Result of the last syntax check requested by checkSyntax(). If @p valid is false, the
+     * script has a syntax error at line @p errorLine that is described by @p errorMessage.
+     */
+    void syntaxChecked(bool valid, int errorLine, const QString &errorMessage);
 
 private:
     const QScopedPointer<KernelPrivate> d;
 };
 }
 
+Q_DECLARE_METATYPE(GraphTheory::Kernel::MessageType)
+
 #endif
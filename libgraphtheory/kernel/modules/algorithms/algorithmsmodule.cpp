@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "algorithmsmodule.h"
+#include "algorithms/graphalgorithms.h"
+#include "kernel/documentwrapper.h"
+#include "kernel/nodewrapper.h"
+#include "kernel/edgewrapper.h"
+#include "graphdocument.h"
+#include "graphsnapshot.h"
+#include <KLocalizedString>
+
+using namespace GraphTheory;
+
+AlgorithmsModule::AlgorithmsModule(QObject *parent)
+    : QObject(parent)
+    , m_documentWrapper(nullptr)
+{
+}
+
+AlgorithmsModule::~AlgorithmsModule()
+{
+}
+
+void AlgorithmsModule::setDocumentWrapper(DocumentWrapper *documentWrapper)
+{
+    m_documentWrapper = documentWrapper;
+}
+
+bool AlgorithmsModule::isValidNode(NodeWrapper *node, const QString &command)
+{
+    if (!m_documentWrapper) {
+        emit message(i18nc("@info:shell", "%1: no document available", command), Kernel::ErrorMessage);
+        return false;
+    }
+    if (!node) {
+        emit message(i18nc("@info:shell", "%1: node is not valid", command), Kernel::ErrorMessage);
+        return false;
+    }
+    if (node->node()->document() != m_documentWrapper->document()) {
+        emit message(i18nc("@info:shell", "%1: node does not belong to the current document", command), Kernel::ErrorMessage);
+        return false;
+    }
+    return true;
+}
+
+QScriptValue AlgorithmsModule::nodeArray(const QVector<int> &indices, GraphSnapshotPtr graph) const
+{
+    QScriptEngine *engine = m_documentWrapper->engine();
+    QScriptValue array = engine->newArray(indices.count());
+    for (int i = 0; i < indices.count(); ++i) {
+        array.setProperty(i, m_documentWrapper->nodeWrapper(graph->node(indices.at(i)))->scriptValue());
+    }
+    return array;
+}
+
+QScriptValue AlgorithmsModule::bfs(NodeWrapper *start)
+{
+    if (!isValidNode(start, QStringLiteral("Algorithms.bfs()"))) {
+        return QScriptValue();
+    }
+    GraphSnapshotPtr graph;
+    int startIndex = -1;
+    m_documentWrapper->synchronized([&]() {
+        graph = m_documentWrapper->document()->snapshot();
+        startIndex = start->node()->documentIndex();
+    });
+    if (!graph) { // aborted execution
+        return QScriptValue();
+    }
+    return nodeArray(GraphAlgorithms::breadthFirstSearch(graph, startIndex), graph);
+}
+
+QScriptValue AlgorithmsModule::dfs(NodeWrapper *start)
+{
+    if (!isValidNode(start, QStringLiteral("Algorithms.dfs()"))) {
+        return QScriptValue();
+    }
+    GraphSnapshotPtr graph;
+    int startIndex = -1;
+    m_documentWrapper->synchronized([&]() {
+        graph = m_documentWrapper->document()->snapshot();
+        startIndex = start->node()->documentIndex();
+    });
+    if (!graph) { // aborted execution
+        return QScriptValue();
+    }
+    return nodeArray(GraphAlgorithms::depthFirstSearch(graph, startIndex), graph);
+}
+
+QScriptValue AlgorithmsModule::distances(NodeWrapper *source, const QString &lengthProperty)
+{
+    const QString command = QString("Algorithms.distances(%1)").arg(lengthProperty);
+    if (!isValidNode(source, command)) {
+        return QScriptValue();
+    }
+    const QVector<qreal> distances = m_documentWrapper->distances(source->node(), lengthProperty);
+    QScriptValue array = m_documentWrapper->engine()->newArray(distances.count());
+    for (int i = 0; i < distances.count(); ++i) {
+        array.setProperty(i, distances.at(i));
+    }
+    return array;
+}
+
+QScriptValue AlgorithmsModule::components()
+{
+    if (!m_documentWrapper) {
+        emit message(i18nc("@info:shell", "%1: no document available", QStringLiteral("Algorithms.components()")), Kernel::ErrorMessage);
+        return QScriptValue();
+    }
+    GraphSnapshotPtr graph = m_documentWrapper->synchronized([this]() { return m_documentWrapper->document()->snapshot(); });
+    if (!graph) { // aborted execution
+        return QScriptValue();
+    }
+    int count = 0;
+    const QVector<int> components = GraphAlgorithms::connectedComponents(graph, &count);
+
+    // bucket nodes by component
+    QVector<QVector<int>> members(count);
+    for (int i = 0; i < components.count(); ++i) {
+        members[components.at(i)].append(i);
+    }
+    QScriptValue array = m_documentWrapper->engine()->newArray(count);
+    for (int i = 0; i < count; ++i) {
+        array.setProperty(i, nodeArray(members.at(i), graph));
+    }
+    return array;
+}
+
+QScriptValue AlgorithmsModule::spanningTree(GraphSnapshotPtr graph) const
+{
+    if (!graph) { // aborted execution
+        return QScriptValue();
+    }
+    const QVector<int> arcs = GraphAlgorithms::minimumSpanningForest(graph);
+    QScriptEngine *engine = m_documentWrapper->engine();
+    QScriptValue array = engine->newArray(arcs.count());
+    for (int i = 0; i < arcs.count(); ++i) {
+        array.setProperty(i, m_documentWrapper->edgeWrapper(graph->edge(arcs.at(i)))->scriptValue());
+    }
+    return array;
+}
+
+QScriptValue AlgorithmsModule::spanningTree(const QString &lengthProperty)
+{
+    if (!m_documentWrapper) {
+        QString command = QString("Algorithms.spanningTree(%1)").arg(lengthProperty);
+        emit message(i18nc("@info:shell", "%1: no document available", command), Kernel::ErrorMessage);
+        return QScriptValue();
+    }
+    return spanningTree(m_documentWrapper->synchronized([&]() {
+        return m_documentWrapper->document()->snapshot(EdgeTypePtr(), lengthProperty);
+    }));
+}
+
+QScriptValue AlgorithmsModule::spanningTree(const QString &lengthProperty, int type)
+{
+    QString command = QString("Algorithms.spanningTree(%1, %2)").arg(lengthProperty).arg(type);
+    if (!m_documentWrapper) {
+        emit message(i18nc("@info:shell", "%1: no document available", command), Kernel::ErrorMessage);
+        return QScriptValue();
+    }
+    EdgeTypePtr typePtr = m_documentWrapper->synchronized([&]() { return m_documentWrapper->document()->edgeType(type); });
+    if (!typePtr) {
+        emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, type), Kernel::ErrorMessage);
+        return m_documentWrapper->engine()->newArray();
+    }
+    return spanningTree(m_documentWrapper->synchronized([&]() {
+        return m_documentWrapper->document()->snapshot(typePtr, lengthProperty);
+    }));
+}
+
+QScriptValue AlgorithmsModule::topologicalSort()
+{
+    const QString command = QStringLiteral("Algorithms.topologicalSort()");
+    if (!m_documentWrapper) {
+        emit message(i18nc("@info:shell", "%1: no document available", command), Kernel::ErrorMessage);
+        return QScriptValue();
+    }
+    GraphSnapshotPtr graph = m_documentWrapper->synchronized([this]() { return m_documentWrapper->document()->snapshot(); });
+    if (!graph) { // aborted execution
+        return QScriptValue();
+    }
+    QVector<int> order;
+    if (!GraphAlgorithms::topologicalSort(graph, order)) {
+        emit message(i18nc("@info:shell", "%1: graph contains a cycle", command), Kernel::ErrorMessage);
+        return m_documentWrapper->engine()->newArray();
+    }
+    return nodeArray(order, graph);
+}
@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHMSMODULE_H
+#define ALGORITHMSMODULE_H
+
+#include "graphtheory_export.h"
+#include "kernel/kernel.h"
+#include <QObject>
+#include <QScriptValue>
+#include <QVector>
+
+namespace GraphTheory
+{
+class DocumentWrapper;
+class NodeWrapper;
+
+/**
+ * \class AlgorithmsModule
+ * This class provides an interface object for the scripting engine to run natively implemented
+ * graph algorithms on the current document. Results are returned as script arrays of node objects
+ * or numbers.
+ */
+class GRAPHTHEORY_EXPORT AlgorithmsModule : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AlgorithmsModule(QObject *parent = 0);
+    ~AlgorithmsModule();
+
+    /**
+     * Set document wrapper of the currently executed script to \p documentWrapper. The wrapper
+     * must be reset to a null pointer before it is destroyed.
+     */
+    void setDocumentWrapper(DocumentWrapper *documentWrapper);
+
+public Q_SLOTS:
+    /**
+     * \return all nodes reachable from \p start in breadth-first order
+     */
+    Q_INVOKABLE QScriptValue bfs(GraphTheory::NodeWrapper *start);
+
+    /**
+     * \return all nodes reachable from \p start in depth-first order
+     */
+    Q_INVOKABLE QScriptValue dfs(GraphTheory::NodeWrapper *start);
+
+    /**
+     * Compute shortest path distances from \p source, where edge lengths are given by the dynamic
+     * property \p lengthProperty.
+     * \return distances to all nodes in the order of Document.nodes()
+     */
+    Q_INVOKABLE QScriptValue distances(GraphTheory::NodeWrapper *source, const QString &lengthProperty);
+
+    /**
+     * \return array of connected components, each given as array of nodes
+     */
+    Q_INVOKABLE QScriptValue components();
+
+    /**
+     * Compute a minimum spanning forest, where edge directions are ignored and edge lengths are
+     * given by the dynamic property \p lengthProperty.
+     * \return array of the edges of the forest
+     */
+    Q_INVOKABLE QScriptValue spanningTree(const QString &lengthProperty);
+
+    /**
+     * Compute a minimum spanning forest that only consists of edges of edge type \p type.
+     * \return array of the edges of the forest
+     */
+    Q_INVOKABLE QScriptValue spanningTree(const QString &lengthProperty, int type);
+
+    /**
+     * \return all nodes in topological order or an empty array if the graph contains a cycle
+     */
+    Q_INVOKABLE QScriptValue topologicalSort();
+
+Q_SIGNALS:
+    void message(const QString &message, GraphTheory::Kernel::MessageType type);
+
+private:
+    Q_DISABLE_COPY(AlgorithmsModule)
+    bool isValidNode(GraphTheory::NodeWrapper *node, const QString &command);
+    QScriptValue nodeArray(const QVector<int> &indices, GraphSnapshotPtr graph) const;
+    QScriptValue spanningTree(GraphSnapshotPtr graph) const;
+    DocumentWrapper *m_documentWrapper;
+};
+}
+
+#endif
@@ -24,23 +24,32 @@
 #include "nodetype.h"
 #include "edge.h"
 #include "typenames.h"
+#include "scriptprofiler.h"
 #include <KLocalizedString>
 #include <QPointF>
 #include <QColor>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QEvent>
+#include <QSet>
 
 using namespace GraphTheory;
 
 NodeWrapper::NodeWrapper(NodePtr node, DocumentWrapper *documentWrapper)
-    : QObject(node.data())
+    : QObject()
     , m_node(node)
     , m_documentWrapper(documentWrapper)
+    , m_updatingProperties(false)
 {
     connect(m_node.data(), &Node::idChanged, this, &NodeWrapper::idChanged);
     connect(m_node.data(), &Node::colorChanged, this, &NodeWrapper::colorChanged);
     connect(m_node.data(), &Node::positionChanged, this, &NodeWrapper::positionChanged);
     connect(m_node.data(), &Node::dynamicPropertiesChanged, this, &NodeWrapper::updateDynamicProperties);
+    // values may change while a script runs in the thread of this wrapper, hence changes are
+    // only noted here and fetched by DocumentWrapper::updateChangedProperties()
+    connect(m_node.data(), &Node::dynamicPropertyChanged, this, [this]() {
+        m_dynamicPropertyChanged.storeRelease(1);
+    }, Qt::DirectConnection);
     connect(m_node.data(), &Node::typeChanged, this, &NodeWrapper::typeChanged);
 
     updateDynamicProperties();
@@ -56,372 +65,281 @@ NodePtr NodeWrapper::node() const
     return m_node;
 }
 
+QScriptValue NodeWrapper::scriptValue() const
+{
+    if (!m_scriptValue.isValid()) {
+        m_scriptValue = m_documentWrapper->engine()->newQObject(const_cast<NodeWrapper*>(this),
+                                                                QScriptEngine::QtOwnership,
+                                                                QScriptEngine::AutoCreateDynamicProperties);
+    }
+    return m_scriptValue;
+}
+
 int NodeWrapper::id() const
 {
-    return m_node->id();
+    return m_documentWrapper->synchronized([this]() { return m_node->id(); });
 }
 
 qreal NodeWrapper::x() const
 {
-    return m_node->x();
+    return m_documentWrapper->synchronized([this]() { return m_node->x(); });
 }
 
 void NodeWrapper::setX(qreal x)
 {
-    if (x == NodeWrapper::x()) {
-        return;
-    }
-    m_node->setX(x);
+    m_documentWrapper->synchronized([this, x]() {
+        if (x != m_node->x()) {
+            m_node->setX(x);
+        }
+    });
     // change signal will be emitted by connection to m_node signal
 }
 
 qreal NodeWrapper::y() const
 {
-    return m_node->y();
+    return m_documentWrapper->synchronized([this]() { return m_node->y(); });
 }
 
 void NodeWrapper::setY(qreal y)
 {
-    if (y == NodeWrapper::y()) {
-        return;
-    }
-    m_node->setY(y);
+    m_documentWrapper->synchronized([this, y]() {
+        if (y != m_node->y()) {
+            m_node->setY(y);
+        }
+    });
     // change signal will be emitted by connection to m_node signal
 }
 
 QString NodeWrapper::color() const
 {
-    return m_node->color().name();
+    return m_documentWrapper->synchronized([this]() { return m_node->color().name(); });
 }
 
 void NodeWrapper::setColor(const QString &colorString)
 {
     QColor color = QColor(colorString);
-    if (color == m_node->color()) {
-        return;
-    }
-    m_node->setColor(color);
+    m_documentWrapper->synchronized([this, color]() {
+        if (color != m_node->color()) {
+            m_node->setColor(color);
+        }
+    });
     // change signal will be emitted by connection to m_node signal
 }
 
 int NodeWrapper::type() const
 {
-    return m_node->type()->id();
+    return m_documentWrapper->synchronized([this]() { return m_node->type()->id(); });
 }
 
 void NodeWrapper::setType(int typeId)
 {
-    NodeTypePtr newType = m_node->type();
-    if (newType->id() == typeId) {
-        return;
-    }
-    for (const auto &type : m_node->document()->nodeTypes()) {
-        if (type->id() == typeId) {
-            newType = type;
-            break;
+    bool validType = m_documentWrapper->synchronized([this, typeId]() -> bool {
+        if (m_node->type()->id() == typeId) {
+            return true;
         }
-    }
-    if (newType == m_node->type()) {
+        NodeTypePtr newType = m_node->document()->nodeType(typeId);
+        if (!newType) {
+            return false;
+        }
+        m_node->setType(newType);
+        return true;
+    });
+    if (!validType) {
         QString command = QString("node.type = %1)").arg(typeId);
         emit message(i18nc("@info:shell", "%1: node type ID %2 not registered", command, typeId), Kernel::ErrorMessage);
-        return;
     }
-    m_node->setType(newType);
     // change signal will be emitted by connection to m_node signal
 }
 
-QList<GraphTheory::EdgeWrapper*> NodeWrapper::edges() const
+EdgeTypePtr NodeWrapper::edgeType(int type, const QString &command) const
+{
+    EdgeTypePtr typePtr = m_documentWrapper->synchronized([this, type]() { return m_node->document()->edgeType(type); });
+    if (!typePtr) {
+        emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, type), Kernel::ErrorMessage);
+    }
+    return typePtr;
+}
+
+QList<GraphTheory::EdgeWrapper*> NodeWrapper::edgeWrappers(const EdgeList &edges) const
 {
-    QList<EdgeWrapper*> edges;
-    for (const auto &edge : m_node->edges()) {
-        edges.append(m_documentWrapper->edgeWrapper(edge));
+    QList<EdgeWrapper*> wrappers;
+    for (const auto &edge : edges) {
+        wrappers.append(m_documentWrapper->edgeWrapper(edge));
     }
-    return edges;
+    return wrappers;
 }
 
-QList<GraphTheory::EdgeWrapper*> NodeWrapper::edges(int type) const
+QList<GraphTheory::NodeWrapper*> NodeWrapper::nodeWrappers(const QSet<NodePtr> &nodes) const
 {
-    EdgeTypePtr typePtr;
-    for (const auto &typeTest : m_node->document()->edgeTypes()) {
-        if (typeTest->id() == type) {
-            typePtr = typeTest;
-            break;
-        }
+    QList<NodeWrapper*> wrappers;
+    for (const auto &node : nodes) {
+        wrappers.append(m_documentWrapper->nodeWrapper(node));
     }
+    return wrappers;
+}
+
+QList<GraphTheory::EdgeWrapper*> NodeWrapper::edges() const
+{
+    return edgeWrappers(m_documentWrapper->synchronized([this]() { return m_node->edges(); }));
+}
+
+QList<GraphTheory::EdgeWrapper*> NodeWrapper::edges(int type) const
+{
+    EdgeTypePtr typePtr = edgeType(type, QString("node.edges(%1)").arg(type));
     if (!typePtr) {
-        QString command = QString("node.edges(%1)").arg(type);
-        emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, type), Kernel::ErrorMessage);
         return QList<EdgeWrapper*>();
     }
-    QList<EdgeWrapper*> edges;
-    for (const auto &edge : m_node->edges(typePtr)) {
-        edges.append(m_documentWrapper->edgeWrapper(edge));
-    }
-    return edges;
+    return edgeWrappers(m_documentWrapper->synchronized([this, typePtr]() { return m_node->edges(typePtr); }));
 }
 
 QList<GraphTheory::EdgeWrapper*> NodeWrapper::inEdges() const
 {
-    QList<EdgeWrapper*> edges;
-    for (const auto &edge : m_node->inEdges()) {
-        edges.append(m_documentWrapper->edgeWrapper(edge));
-    }
-    return edges;
+    return edgeWrappers(m_documentWrapper->synchronized([this]() { return m_node->inEdges(); }));
 }
 
 QList<GraphTheory::EdgeWrapper*> NodeWrapper::inEdges(int type) const
 {
-    EdgeTypePtr typePtr;
-    for (const auto &typeTest : m_node->document()->edgeTypes()) {
-        if (typeTest->id() == type) {
-            typePtr = typeTest;
-            break;
-        }
-    }
-    if (!typePtr) {;
-        QString command = QString("node.inEdges(%1)").arg(type);
-        emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, type), Kernel::ErrorMessage);
+    EdgeTypePtr typePtr = edgeType(type, QString("node.inEdges(%1)").arg(type));
+    if (!typePtr) {
         return QList<EdgeWrapper*>();
     }
-    QList<EdgeWrapper*> edges;
-    for (const auto &edge : m_node->inEdges(typePtr)) {
-        edges.append(m_documentWrapper->edgeWrapper(edge));
-    }
-    return edges;
+    return edgeWrappers(m_documentWrapper->synchronized([this, typePtr]() { return m_node->inEdges(typePtr); }));
 }
 
 QList<GraphTheory::EdgeWrapper*> NodeWrapper::outEdges() const
 {
-    QList<EdgeWrapper*> edges;
-    for (const auto &edge : m_node->outEdges()) {
-        edges.append(m_documentWrapper->edgeWrapper(edge));
-    }
-    return edges;
+    return edgeWrappers(m_documentWrapper->synchronized([this]() { return m_node->outEdges(); }));
 }
 
 QList<GraphTheory::EdgeWrapper*> NodeWrapper::outEdges(int type) const
 {
-    EdgeTypePtr typePtr;
-    for (const auto &typeTest : m_node->document()->edgeTypes()) {
-        if (typeTest->id() == type) {
-            typePtr = typeTest;
-            break;
-        }
-    }
+    EdgeTypePtr typePtr = edgeType(type, QString("node.outEdges(%1)").arg(type));
     if (!typePtr) {
-        QString command = QString("node.outEdges(%1)").arg(type);
-        emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, type), Kernel::ErrorMessage);
         return QList<EdgeWrapper*>();
     }
-    QList<EdgeWrapper*> edges;
-    for (const auto &edge : m_node->outEdges(typePtr)) {
-        edges.append(m_documentWrapper->edgeWrapper(edge));
-    }
-    return edges;
+    return edgeWrappers(m_documentWrapper->synchronized([this, typePtr]() { return m_node->outEdges(typePtr); }));
 }
 
-QList<NodeWrapper*> NodeWrapper::neighbors() const
+QSet<NodePtr> NodeWrapper::neighborNodes(const EdgeList &edges) const
 {
-    QSet<NodeWrapper*> neighbors;
-    for (const auto &edge : m_node->edges()) {
+    QSet<NodePtr> neighbors;
+    for (const auto &edge : edges) {
         if (m_node == edge->from()) {
-            neighbors.insert(m_documentWrapper->nodeWrapper(edge->to()));
+            neighbors.insert(edge->to());
         } else {
-            neighbors.insert(m_documentWrapper->nodeWrapper(edge->from()));
+            neighbors.insert(edge->from());
         }
     }
-    return neighbors.values();
+    return neighbors;
 }
 
-QList<NodeWrapper*> NodeWrapper::neighbors(int type) const
+QSet<NodePtr> NodeWrapper::predecessorNodes(const EdgeList &inEdges) const
 {
-    EdgeTypePtr typePtr;
-    for (const auto &typeTest : m_node->document()->edgeTypes()) {
-        if (typeTest->id() == type) {
-            typePtr = typeTest;
-            break;
-        }
-    }
-    if (!typePtr) {
-        QString command = QString("node.neighbors(%1)").arg(type);
-        emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, type), Kernel::ErrorMessage);
-        return QList<NodeWrapper*>();
-    }
-    QSet<NodeWrapper*> neighbors;
-    for (const auto &edge : m_node->edges(typePtr)) {
-        if (m_node == edge->from()) {
-            neighbors.insert(m_documentWrapper->nodeWrapper(edge->to()));
+    QSet<NodePtr> precessors;
+    for (const auto &edge : inEdges) {
+        if (edge->type()->direction() == EdgeType::Unidirectional) {
+            precessors.insert(edge->from());
+            continue;
         } else {
-            neighbors.insert(m_documentWrapper->nodeWrapper(edge->from()));
+            if (m_node == edge->from()) {
+                precessors.insert(edge->to());
+            } else {
+                precessors.insert(edge->from());
+            }
         }
     }
-    return neighbors.values();
+    return precessors;
 }
 
-QList<NodeWrapper*> NodeWrapper::predecessors() const
+QSet<NodePtr> NodeWrapper::successorNodes(const EdgeList &outEdges) const
 {
-    QSet<NodeWrapper*> precessors;
-    for (const auto &edge : m_node->inEdges()) {
+    QSet<NodePtr> successors;
+    for (const auto &edge : outEdges) {
         if (edge->type()->direction() == EdgeType::Unidirectional) {
-            precessors.insert(m_documentWrapper->nodeWrapper(edge->from()));
+            successors.insert(edge->to());
             continue;
         } else {
             if (m_node == edge->from()) {
-                precessors.insert(m_documentWrapper->nodeWrapper(edge->to()));
+                successors.insert(edge->to());
             } else {
-                precessors.insert(m_documentWrapper->nodeWrapper(edge->from()));
+                successors.insert(edge->from());
             }
         }
     }
-    return precessors.values();
+    return successors;
 }
 
-QList<NodeWrapper*> NodeWrapper::predecessors(int type) const
+QList<NodeWrapper*> NodeWrapper::neighbors() const
 {
-    EdgeTypePtr typePtr;
-    for (const auto &typeTest : m_node->document()->edgeTypes()) {
-        if (typeTest->id() == type) {
-            typePtr = typeTest;
-            break;
-        }
-    }
+    return nodeWrappers(m_documentWrapper->synchronized([this]() { return neighborNodes(m_node->edges()); }));
+}
+
+QList<NodeWrapper*> NodeWrapper::neighbors(int type) const
+{
+    EdgeTypePtr typePtr = edgeType(type, QString("node.neighbors(%1)").arg(type));
     if (!typePtr) {
-        QString command = QString("node.predecessors(%1)").arg(type);
-        emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, type), Kernel::ErrorMessage);
         return QList<NodeWrapper*>();
     }
-    QSet<NodeWrapper*> precessors;
-    for (const auto &edge : m_node->inEdges(typePtr)) {
-        if (edge->type()->direction() == EdgeType::Unidirectional) {
-            precessors.insert(m_documentWrapper->nodeWrapper(edge->from()));
-            continue;
-        } else {
-            if (m_node == edge->from()) {
-                precessors.insert(m_documentWrapper->nodeWrapper(edge->to()));
-            } else {
-                precessors.insert(m_documentWrapper->nodeWrapper(edge->from()));
-            }
-        }
+    return nodeWrappers(m_documentWrapper->synchronized([this, typePtr]() { return neighborNodes(m_node->edges(typePtr)); }));
+}
+
+QList<NodeWrapper*> NodeWrapper::predecessors() const
+{
+    return nodeWrappers(m_documentWrapper->synchronized([this]() { return predecessorNodes(m_node->inEdges()); }));
+}
+
+QList<NodeWrapper*> NodeWrapper::predecessors(int type) const
+{
+    EdgeTypePtr typePtr = edgeType(type, QString("node.predecessors(%1)").arg(type));
+    if (!typePtr) {
+        return QList<NodeWrapper*>();
     }
-    return precessors.values();
+    return nodeWrappers(m_documentWrapper->synchronized([this, typePtr]() { return predecessorNodes(m_node->inEdges(typePtr)); }));
 }
 
 QList<NodeWrapper*> NodeWrapper::successors() const
 {
-    QSet<NodeWrapper*> successors;
-    for (const auto &edge : m_node->outEdges()) {
-        if (edge->type()->direction() == EdgeType::Unidirectional) {
-            successors.insert(m_documentWrapper->nodeWrapper(edge->to()));
-            continue;
-        } else {
-            if (m_node == edge->from()) {
-                successors.insert(m_documentWrapper->nodeWrapper(edge->to()));
-            } else {
-                successors.insert(m_documentWrapper->nodeWrapper(edge->from()));
-            }
-        }
-    }
-    return successors.values();
+    return nodeWrappers(m_documentWrapper->synchronized([this]() { return successorNodes(m_node->outEdges()); }));
 }
 
 QList<NodeWrapper*> NodeWrapper::successors(int type) const
 {
-    EdgeTypePtr typePtr;
-    for (const auto &typeTest : m_node->document()->edgeTypes()) {
-        if (typeTest->id() == type) {
-            typePtr = typeTest;
-            break;
-        }
-    }
+    EdgeTypePtr typePtr = edgeType(type, QString("node.successors(%1)").arg(type));
     if (!typePtr) {
-        QString command = QString("node.successors(%1)").arg(type);
-        emit message(i18nc("@info:shell", "%1: edge type ID %2 not registered", command, type), Kernel::ErrorMessage);
         return QList<NodeWrapper*>();
     }
-    QSet<NodeWrapper*> successors;
-    for (const auto &edge : m_node->outEdges(typePtr)) {
-        if (edge->type()->direction() == EdgeType::Unidirectional) {
-            successors.insert(m_documentWrapper->nodeWrapper(edge->to()));
-            continue;
-        } else {
-            if (m_node == edge->from()) {
-                successors.insert(m_documentWrapper->nodeWrapper(edge->to()));
-            } else {
-                successors.insert(m_documentWrapper->nodeWrapper(edge->from()));
-            }
-        }
-    }
-    return successors.values();
+    return nodeWrappers(m_documentWrapper->synchronized([this, typePtr]() { return successorNodes(m_node->outEdges(typePtr)); }));
 }
 
 QScriptValue NodeWrapper::distance(const QString &lengthProperty, QList< NodeWrapper* > targets)
 {
-    //TODO at a later point in time:
-    //     factor this algorithm out into a self-containted graph algorithm class
-
-    // Implementation of Floyd-Warshall Algorithm:
-    // asymptotic runtime: O(n^3), n = number of nodes
-    //
-    // 1 let D be a |V| × |V| matrix of minimum distances initialized to ∞ (infinity)
-    // 2 foreach(vertex v)
-    // 3    D[v][v] ← 0
-    // 4 foreach (edge (u,v))
-    // 5    D[u][v] := w(u,v)  // the weight of the edge (u,v)
-    // 6 for (k from 1 to |V|)
-    // 7    for (i from 1 to |V|)
-    // 8       for (j from 1 to |V|)
-    // 9          if (D[i][j] > D[i][k] + D[k][j])
-    // 10             D[i][j] := D[i][k] + D[k][j]
-    // 11         end if
-
-    const NodeList nodes = m_node->document()->nodes();
-    const EdgeList edges = m_node->document()->edges();
-    const int n = nodes.length();
-
-    // create fast access mapping of node IDs to positions
-    QMap<int, int> map;
-    for (int i = 0; i < n; ++i) {
-        map.insert(nodes.at(i)->id(), i);
-    }
-
-    // initialize distance matrix D
-    QVector< QVector<qreal> > D(n, QVector<qreal>(n));
-    for (int i = 0; i < n; ++i) {
-    for (int j = 0; j < n; ++j) {
-        if (i == j) {
-            D[i][j] = 0;
-        }
-        else {
-            D[i][j] = std::numeric_limits<qreal>::max();
-        }
-    }
-    }
-
-    // set edges lengths to D
-    for (const auto &edge : edges) {
-        D[map[edge->from()->id()]][map[edge->to()->id()]] = edge->dynamicProperty(lengthProperty).toDouble();
-        if (edge->type()->direction() == EdgeType::Bidirectional) {
-            D[map[edge->to()->id()]][map[edge->from()->id()]] = edge->dynamicProperty(lengthProperty).toDouble();
+    QVector<int> indices;
+    indices.reserve(targets.length());
+    for (const auto &target : targets) {
+        if (!target || target->node()->document() != m_node->document()) {
+            QString command = QString("node.distance(%1, targets)").arg(lengthProperty);
+            emit message(i18nc("@info:shell", "%1: target is not a node of this document", command), Kernel::ErrorMessage);
+            indices.append(-1);
+            continue;
         }
+        indices.append(m_documentWrapper->synchronized([target]() { return target->node()->documentIndex(); }));
     }
 
-    // computation
-    for (int k = 0; k < n; ++k) {
-    for (int i = 0; i < n; ++i) {
-    for (int j = 0; j < n; ++j) {
-        if (D[i][j] > D[i][k] + D[k][j]) {
-            D[i][j] = D[i][k] + D[k][j];
-        }
-    }
-    }
+    // only distances to actual targets are computed, i.e., an empty target list yields no result
+    QVector<int> validIndices = indices;
+    validIndices.removeAll(-1);
+    QVector<qreal> distances;
+    if (!validIndices.isEmpty()) {
+        distances = m_documentWrapper->distances(m_node, lengthProperty, validIndices);
     }
 
-    // compute return statement
     QScriptValue array = m_documentWrapper->engine()->newArray(targets.length());
-    const int from = map[m_node->id()];
-    for (int i = 0; i < targets.length(); ++i) {
-        const qreal distance = D[from][map[targets.at(i)->id()]];
-        array.setProperty(i, distance);
+    for (int i = 0; i < indices.length(); ++i) {
+        if (indices.at(i) < 0 || indices.at(i) >= distances.count()) {
+            array.setProperty(i, QScriptValue());
+            continue;
+        }
+        array.setProperty(i, distances.at(indices.at(i)));
     }
     return array;
 }
@@ -429,12 +347,31 @@ QScriptValue NodeWrapper::distance(const QString &lengthProperty, QList< NodeWra
 bool NodeWrapper::event(QEvent *e)
 {
     if (e->type() == QEvent::DynamicPropertyChange) {
+        if (m_updatingProperties) {
+            return true;
+        }
         QDynamicPropertyChangeEvent *propertyEvent = static_cast<QDynamicPropertyChangeEvent *>(e);
         QString name = QString::fromUtf8(propertyEvent->propertyName());
         QVariant value = property(propertyEvent->propertyName());
+        // assignments are no function calls of the engine, hence they are timed here
+        ScriptProfiler *profiler = ScriptProfiler::profiler(m_documentWrapper->engine());
+        QElapsedTimer timer;
+        if (profiler) {
+            timer.start();
+        }
         // only propagate property to node object if it is registered
-        if (m_node->dynamicProperties().contains(name)) {
+        const bool registered = m_documentWrapper->synchronized([this, name, value]() -> bool {
+            if (!m_node->dynamicProperties().contains(name)) {
+                return false;
+            }
             m_node->setDynamicProperty(name, value);
+            return true;
+        });
+        if (!registered) {
+            m_documentWrapper->scriptPropertyAdded(this);
+        }
+        if (profiler) {
+            profiler->recordCall(QStringLiteral("Node.%1 =").arg(name), timer.nsecsElapsed());
         }
         return true;
     }
@@ -443,13 +380,45 @@ bool NodeWrapper::event(QEvent *e)
 
 void NodeWrapper::updateDynamicProperties()
 {
-    for (const auto &property : m_node->dynamicProperties()) {
-        // property value must not be set to QVariant::Invalid, else the properties are not accessible
-        // from the script engine
-        if (m_node->dynamicProperty(property).isValid()) {
-            setProperty(property.toUtf8(), m_node->dynamicProperty(property));
-        } else {
-            setProperty(property.toUtf8(), QVariant::Int);
+    QStringList properties;
+    QVector<QVariant> values;
+    m_documentWrapper->synchronized([&]() {
+        properties = m_node->dynamicProperties();
+        foreach (const QString &property, properties) {
+            values.append(m_node->dynamicProperty(property));
+        }
+    });
+    for (int i = 0; i < properties.count(); ++i) {
+        updateDynamicProperty(properties.at(i), values.at(i));
+    }
+}
+
+void NodeWrapper::updateDynamicProperty(const QString &property, const QVariant &value)
+{
+    m_updatingProperties = true;
+    // property value must not be set to QVariant::Invalid, else the properties are not accessible
+    // from the script engine
+    if (value.isValid()) {
+        setProperty(property.toUtf8(), value);
+    } else {
+        setProperty(property.toUtf8(), QVariant::Int);
+    }
+    m_updatingProperties = false;
+}
+
+bool NodeWrapper::takeDynamicPropertyChange()
+{
+    return m_dynamicPropertyChanged.fetchAndStoreAcquire(0) != 0;
+}
+
+void NodeWrapper::removeScriptProperties()
+{
+    const QStringList registered = m_documentWrapper->synchronized([&]() { return m_node->dynamicProperties(); });
+    m_updatingProperties = true;
+    foreach (const QByteArray &name, dynamicPropertyNames()) {
+        if (!registered.contains(QString::fromUtf8(name))) {
+            setProperty(name, QVariant());
         }
     }
+    m_updatingProperties = false;
 }
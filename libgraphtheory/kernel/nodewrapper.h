@@ -28,8 +28,11 @@
 #include "graphdocument.h"
 #include "documentwrapper.h"
 
+#include <QAtomicInt>
 #include <QObject>
+#include <QScriptValue>
 #include <QColor>
+#include <QSet>
 
 class QEvent;
 
@@ -58,6 +61,11 @@ public:
 
     NodePtr node() const;
 
+    /**
+     * @return script object of this wrapper, which is created once and then reused
+     */
+    QScriptValue scriptValue() const;
+
     /**
      * If the id value is invalid, -1 is returned.
      *
@@ -185,6 +193,24 @@ public:
     /** reimplemented from QObject **/
     virtual bool event(QEvent *e) Q_DECL_OVERRIDE;
 
+    /**
+     * Set the script visible value of dynamic property @p property to @p value without writing
+     * it back to the node, e.g. after the node value was changed by the document.
+     */
+    void updateDynamicProperty(const QString &property, const QVariant &value);
+
+    /**
+     * Remove all dynamic properties that scripts assigned to this wrapper but that are not
+     * registered at the node, such that they do not leak into subsequent script executions.
+     */
+    void removeScriptProperties();
+
+    /**
+     * @return true if a dynamic property value of the node changed since the last call, e.g. by
+     * the user between two script executions
+     */
+    bool takeDynamicPropertyChange();
+
 public Q_SLOTS:
     void updateDynamicProperties();
 
@@ -197,8 +223,18 @@ Q_SIGNALS:
 
 private:
     Q_DISABLE_COPY(NodeWrapper)
+    EdgeTypePtr edgeType(int type, const QString &command) const;
+    QList<GraphTheory::EdgeWrapper*> edgeWrappers(const EdgeList &edges) const;
+    QList<GraphTheory::NodeWrapper*> nodeWrappers(const QSet<NodePtr> &nodes) const;
+    QSet<NodePtr> neighborNodes(const EdgeList &edges) const;
+    QSet<NodePtr> predecessorNodes(const EdgeList &inEdges) const;
+    QSet<NodePtr> successorNodes(const EdgeList &outEdges) const;
+
     const NodePtr m_node;
     const DocumentWrapper *m_documentWrapper;
+    mutable QScriptValue m_scriptValue;
+    bool m_updatingProperties; //!< true while values are copied from the node
+    QAtomicInt m_dynamicPropertyChanged; //!< set in the thread of the document
 };
 }
 
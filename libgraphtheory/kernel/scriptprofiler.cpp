@@ -0,0 +1,176 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "scriptprofiler.h"
+#include <KLocalizedString>
+#include <QScriptContext>
+#include <QScriptContextInfo>
+#include <QScriptEngine>
+#include <algorithm>
+
+using namespace GraphTheory;
+
+ScriptProfiler::ScriptProfiler(QScriptEngine *engine)
+    : QScriptEngineAgent(engine)
+    , m_scriptId(-1)
+    , m_line(-1)
+    , m_lineStart(0)
+{
+    m_timer.start();
+}
+
+ScriptProfiler::~ScriptProfiler()
+{
+
+}
+
+void ScriptProfiler::scriptLoad(qint64 id, const QString &program, const QString &fileName, int baseLineNumber)
+{
+    Q_UNUSED(program);
+    Q_UNUSED(fileName);
+    Q_UNUSED(baseLineNumber);
+    if (m_scriptId < 0) {
+        m_scriptId = id;
+    }
+}
+
+ScriptProfiler * ScriptProfiler::profiler(QScriptEngine *engine)
+{
+    return dynamic_cast<ScriptProfiler *>(engine->agent());
+}
+
+void ScriptProfiler::recordCall(const QString &name, qint64 nanoseconds)
+{
+    Entry &entry = m_calls[name];
+    entry.time += nanoseconds;
+    ++entry.count;
+}
+
+void ScriptProfiler::chargeLine()
+{
+    const qint64 now = m_timer.nsecsElapsed();
+    if (m_line >= 0) {
+        m_lines[m_line].time += now - m_lineStart;
+    }
+    m_lineStart = now;
+}
+
+void ScriptProfiler::positionChange(qint64 scriptId, int lineNumber, int columnNumber)
+{
+    Q_UNUSED(columnNumber);
+    // programs that were loaded by an earlier evaluation are not announced by scriptLoad()
+    if (m_scriptId < 0) {
+        m_scriptId = scriptId;
+    }
+    if (scriptId != m_scriptId) {
+        return;
+    }
+    chargeLine();
+    m_line = lineNumber;
+    ++m_lines[lineNumber].count;
+}
+
+QString ScriptProfiler::nativeCallName() const
+{
+    QScriptContext *context = engine()->currentContext();
+    const QScriptContextInfo info(context);
+    if (info.functionType() != QScriptContextInfo::QtFunction
+        && info.functionType() != QScriptContextInfo::QtPropertyFunction)
+    {
+        return QString();
+    }
+    // GraphTheory::DocumentWrapper and GraphTheory::AlgorithmsModule are shown as Document and Algorithms
+    QString object;
+    if (QObject *qobject = context->thisObject().toQObject()) {
+        object = QString::fromLatin1(qobject->metaObject()->className());
+        object.remove(QStringLiteral("GraphTheory::"));
+        object.remove(QStringLiteral("Wrapper"));
+        object.remove(QStringLiteral("Module"));
+    }
+    if (info.functionType() == QScriptContextInfo::QtPropertyFunction) {
+        return QStringLiteral("%1.%2").arg(object, info.functionName());
+    }
+    return QStringLiteral("%1.%2()").arg(object, info.functionName());
+}
+
+void ScriptProfiler::functionEntry(qint64 scriptId)
+{
+    // script functions are only tracked to keep entries and exits balanced
+    Call call;
+    call.start = m_timer.nsecsElapsed();
+    if (scriptId == -1) {
+        call.name = nativeCallName();
+    }
+    m_callStack.append(call);
+}
+
+void ScriptProfiler::functionExit(qint64 scriptId, const QScriptValue &returnValue)
+{
+    Q_UNUSED(scriptId);
+    Q_UNUSED(returnValue);
+    if (m_callStack.isEmpty()) {
+        return;
+    }
+    const Call call = m_callStack.takeLast();
+    if (!call.name.isEmpty()) {
+        Entry &entry = m_calls[call.name];
+        entry.time += m_timer.nsecsElapsed() - call.start;
+        ++entry.count;
+    }
+    // the evaluated program returned
+    if (m_callStack.isEmpty()) {
+        chargeLine();
+        m_line = -1;
+    }
+}
+
+QStringList ScriptProfiler::report(int maxEntries) const
+{
+    auto byTime = [](const QPair<qint64, QString> &a, const QPair<qint64, QString> &b) {
+        return a.first > b.first;
+    };
+    auto milliseconds = [](qint64 nanoseconds) {
+        return QString::number(nanoseconds / 1.0e6, 'f', 1);
+    };
+
+    QStringList report;
+    report.append(i18nc("@info:shell", "<b>Lines with highest execution time:</b>"));
+    QVector<QPair<qint64, QString>> lines;
+    for (auto iter = m_lines.constBegin(); iter != m_lines.constEnd(); ++iter) {
+        lines.append(qMakePair(iter->time, i18nc("@info:shell time of script line", "line %1: %2 ms, %3 executions",
+            iter.key(), milliseconds(iter->time), iter->count)));
+    }
+    std::sort(lines.begin(), lines.end(), byTime);
+    for (int i = 0; i < lines.count() && i < maxEntries; ++i) {
+        report.append(lines.at(i).second);
+    }
+
+    report.append(i18nc("@info:shell", "<b>Script API calls with highest execution time:</b>"));
+    QVector<QPair<qint64, QString>> calls;
+    for (auto iter = m_calls.constBegin(); iter != m_calls.constEnd(); ++iter) {
+        calls.append(qMakePair(iter->time, i18nc("@info:shell time of script API method", "%1: %2 ms, %3 calls",
+            iter.key(), milliseconds(iter->time), iter->count)));
+    }
+    std::sort(calls.begin(), calls.end(), byTime);
+    for (int i = 0; i < calls.count() && i < maxEntries; ++i) {
+        report.append(calls.at(i).second);
+    }
+    return report;
+}
@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCRIPTPROFILER_H
+#define SCRIPTPROFILER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QScriptEngineAgent>
+#include <QStringList>
+#include <QVector>
+
+class QScriptEngine;
+
+namespace GraphTheory
+{
+
+/**
+ * \class ScriptProfiler
+ * Engine agent that measures where the time of a script execution is spent. It records the wall
+ * time and number of executions per line of the evaluated script and the time and number of calls
+ * per native method of the script API, e.g. Document.nodes() or Node.neighbors(). Assignments to
+ * dynamic properties of nodes and edges are recorded by the wrappers as calls named like
+ * "Node.weight =", since they are written to the document's thread. Times of lines and calls
+ * include the time of all nested calls.
+ */
+class ScriptProfiler : public QScriptEngineAgent
+{
+public:
+    explicit ScriptProfiler(QScriptEngine *engine);
+    virtual ~ScriptProfiler();
+
+    /**
+     * @return human readable summary of the recorded data, lines and calls are each sorted by
+     *         descending time and limited to @p maxEntries entries
+     */
+    QStringList report(int maxEntries = 10) const;
+
+    /**
+     * @return profiler attached to @p engine or null if the engine is not profiled
+     */
+    static ScriptProfiler * profiler(QScriptEngine *engine);
+
+    /**
+     * Record a call of @p name that took @p nanoseconds. This is used for script API work that
+     * is no function call of the engine, e.g. assignments to dynamic properties.
+     */
+    void recordCall(const QString &name, qint64 nanoseconds);
+
+    /** reimplemented from QScriptEngineAgent **/
+    virtual void scriptLoad(qint64 id, const QString &program, const QString &fileName, int baseLineNumber) Q_DECL_OVERRIDE;
+    virtual void positionChange(qint64 scriptId, int lineNumber, int columnNumber) Q_DECL_OVERRIDE;
+    virtual void functionEntry(qint64 scriptId) Q_DECL_OVERRIDE;
+    virtual void functionExit(qint64 scriptId, const QScriptValue &returnValue) Q_DECL_OVERRIDE;
+
+private:
+    struct Entry {
+        Entry() : time(0), count(0) {}
+        qint64 time; // nanoseconds
+        int count;
+    };
+    struct Call {
+        QString name; // empty if the called function is not recorded
+        qint64 start;
+    };
+    /** charge the time since the last position change to the current line **/
+    void chargeLine();
+    /** @return name under which a native call in the current context is recorded **/
+    QString nativeCallName() const;
+
+    QElapsedTimer m_timer;
+    qint64 m_scriptId; //!< first loaded or executed script, only its lines are recorded
+    int m_line;
+    qint64 m_lineStart;
+    QHash<int, Entry> m_lines;
+    QHash<QString, Entry> m_calls;
+    QVector<Call> m_callStack;
+};
+}
+
+#endif
@@ -23,7 +23,6 @@
 #include "graphdocument.h"
 
 #include <KLocalizedString>
-#include <QSignalMapper>
 #include <QDebug>
 
 using namespace GraphTheory;
@@ -31,33 +30,20 @@ using namespace GraphTheory;
 class GraphTheory::EdgeModelPrivate {
 public:
     EdgeModelPrivate()
-        : m_signalMapper(new QSignalMapper)
     {
     }
 
     ~EdgeModelPrivate()
     {
-        m_signalMapper->deleteLater();
-    }
-
-    void updateMappings()
-    {
-        int edges = m_document->edges().count();
-        for (int i = 0; i < edges; i++) {
-            m_signalMapper->setMapping(m_document->edges().at(i).data(), i);
-        }
     }
 
     GraphDocumentPtr m_document;
-    QSignalMapper *m_signalMapper;
 };
 
 EdgeModel::EdgeModel(QObject *parent)
     : QAbstractListModel(parent)
     , d(new EdgeModelPrivate)
 {
-    connect(d->m_signalMapper, static_cast<void (QSignalMapper::*)(int)>(&QSignalMapper::mapped),
-        this, &EdgeModel::emitEdgeChanged);
 }
 
 EdgeModel::~EdgeModel()
@@ -94,6 +80,12 @@ void EdgeModel::setDocument(GraphDocumentPtr document)
             this, &EdgeModel::onEdgesAboutToBeRemoved);
         connect(d->m_document.data(), &GraphDocument::edgesRemoved,
             this, &EdgeModel::onEdgesRemoved);
+        connect(d->m_document.data(), &GraphDocument::edgeMoved,
+            this, &EdgeModel::onEdgeMoved);
+        connect(d->m_document.data(), &GraphDocument::bulkUpdateAboutToBegin,
+            this, &EdgeModel::beginResetModel);
+        connect(d->m_document.data(), &GraphDocument::bulkUpdateFinished,
+            this, &EdgeModel::endResetModel);
     }
     endResetModel();
 }
@@ -142,7 +134,6 @@ void EdgeModel::onEdgeAboutToBeAdded(EdgePtr edge, int index)
 
 void EdgeModel::onEdgeAdded()
 {
-    d->updateMappings();
     endInsertRows();
 }
 
@@ -156,6 +147,13 @@ void EdgeModel::onEdgesRemoved()
     endRemoveRows();
 }
 
+void EdgeModel::onEdgeMoved(int from, int to)
+{
+    Q_UNUSED(from);
+    // the row keeps its position but now provides another edge object
+    emitEdgeChanged(to);
+}
+
 void EdgeModel::emitEdgeChanged(int row)
 {
     emit edgeChanged(row);
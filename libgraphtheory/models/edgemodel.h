@@ -26,8 +26,6 @@
 
 #include <QAbstractListModel>
 
-class QSignalMapper;
-
 namespace GraphTheory
 {
 class GraphDocument;
@@ -62,6 +60,7 @@ private Q_SLOTS:
     void onEdgeAdded();
     void onEdgesAboutToBeRemoved(int first, int last);
     void onEdgesRemoved();
+    void onEdgeMoved(int from, int to);
     void emitEdgeChanged(int row);
 
 private:
@@ -20,6 +20,8 @@
 
 #include "edgepropertymodel.h"
 #include "edge.h"
+#include "edgetype.h"
+#include "graphdocument.h"
 #include "edgetypestyle.h"
 #include <KLocalizedString>
 #include <QDebug>
@@ -72,6 +74,7 @@ void EdgePropertyModel::setEdge(Edge *edge)
     beginResetModel();
     if (d->m_edge) {
         d->m_edge.data()->disconnect(this);
+        d->m_edge->from()->document().data()->disconnect(this);
     }
     d->m_edge = edge->self();
     if (d->m_edge) {
@@ -85,6 +88,12 @@ void EdgePropertyModel::setEdge(Edge *edge)
             this, &EdgePropertyModel::onDynamicPropertyRemoved);
         connect(d->m_edge.data(), &Edge::dynamicPropertyChanged,
             this, &EdgePropertyModel::onDynamicPropertyChanged);
+        connect(d->m_edge->from()->document().data(), &GraphDocument::edgePropertiesChanged, this, [=](const QString &property) {
+            const int index = d->m_edge->type()->dynamicPropertyIndex(property);
+            if (index >= 0) {
+                onDynamicPropertyChanged(index);
+            }
+        } );
         connect(d->m_edge.data(), &Edge::styleChanged,[=]() {
             QVector<int> changedRoles;
             changedRoles.append(VisibilityRole);
@@ -119,7 +128,7 @@ QVariant EdgePropertyModel::data(const QModelIndex &index, int role) const
     case NameRole:
         return property;
     case ValueRole:
-        return d->m_edge->dynamicProperty(property);
+        return d->m_edge->dynamicProperty(index.row());
     case VisibilityRole:
         return d->m_edge->type()->style()->isPropertyNamesVisible();
     default:
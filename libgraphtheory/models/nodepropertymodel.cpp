@@ -20,6 +20,8 @@
 
 #include "nodepropertymodel.h"
 #include "node.h"
+#include "nodetype.h"
+#include "graphdocument.h"
 #include "nodetypestyle.h"
 #include <KLocalizedString>
 #include <QDebug>
@@ -72,6 +74,7 @@ void NodePropertyModel::setNode(Node* node)
     beginResetModel();
     if (d->m_node) {
         d->m_node.data()->disconnect(this);
+        d->m_node->document().data()->disconnect(this);
     }
     d->m_node = node->self();
     if (d->m_node) {
@@ -85,6 +88,12 @@ void NodePropertyModel::setNode(Node* node)
             this, &NodePropertyModel::onDynamicPropertyRemoved);
         connect(d->m_node.data(), &Node::dynamicPropertyChanged,
             this, &NodePropertyModel::onDynamicPropertyChanged);
+        connect(d->m_node->document().data(), &GraphDocument::nodePropertiesChanged, this, [=](const QString &property) {
+            const int index = d->m_node->type()->dynamicPropertyIndex(property);
+            if (index >= 0) {
+                onDynamicPropertyChanged(index);
+            }
+        } );
         connect(d->m_node.data(), &Node::styleChanged,[=]() {
             QVector<int> changedRoles;
             changedRoles.append(VisibilityRole);
@@ -119,7 +128,7 @@ QVariant NodePropertyModel::data(const QModelIndex &index, int role) const
     case NameRole:
         return property;
     case ValueRole:
-        return d->m_node->dynamicProperty(property);
+        return d->m_node->dynamicProperty(index.row());
     case VisibilityRole:
         return d->m_node->type()->style()->isPropertyNamesVisible();
     default:
@@ -0,0 +1,472 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spatialindex.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+
+using namespace GraphTheory;
+
+namespace
+{
+qreal distanceToSegment(const QPointF &point, const QPointF &from, const QPointF &to)
+{
+    const QPointF segment = to - from;
+    const qreal lengthSquared = segment.x() * segment.x() + segment.y() * segment.y();
+    qreal t = 0;
+    if (lengthSquared > 0) {
+        t = qBound(qreal(0), QPointF::dotProduct(point - from, segment) / lengthSquared, qreal(1));
+    }
+    const QPointF delta = point - (from + segment * t);
+    return std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+}
+
+/**
+ * \return true if the segment from @p from to @p to intersects @p rect, computed by clipping the
+ *         segment parameter range against the four borders of @p rect
+ */
+bool intersects(const QPointF &from, const QPointF &to, const QRectF &rect)
+{
+    const qreal dx = to.x() - from.x();
+    const qreal dy = to.y() - from.y();
+    const qreal p[4] = { -dx, dx, -dy, dy };
+    const qreal q[4] = { from.x() - rect.left(), rect.right() - from.x(), from.y() - rect.top(), rect.bottom() - from.y() };
+    qreal t0 = 0;
+    qreal t1 = 1;
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0) {
+            if (q[i] < 0) {
+                return false;
+            }
+        } else if (p[i] < 0) {
+            t0 = qMax(t0, q[i] / p[i]);
+        } else {
+            t1 = qMin(t1, q[i] / p[i]);
+        }
+    }
+    return t0 <= t1;
+}
+}
+
+class GraphTheory::SpatialIndexPrivate {
+public:
+    explicit SpatialIndexPrivate(SpatialIndex *q)
+        : q(q)
+        , m_cellSize(64)
+        , m_stale(false)
+    {
+    }
+
+    qint64 cell(qreal coordinate) const
+    {
+        return std::floor(coordinate / m_cellSize);
+    }
+
+    static quint64 key(qint64 column, qint64 row)
+    {
+        return (quint64(column) << 32) ^ quint64(row & 0xffffffff);
+    }
+
+    /**
+     * \return true if the cells overlapping @p rect are more than @p count, in which case
+     *         scanning all @p count elements is cheaper than visiting the cells
+     */
+    bool exceedsCells(const QRectF &rect, int count) const
+    {
+        return (qreal(cell(rect.right()) - cell(rect.left()) + 1)) * (cell(rect.bottom()) - cell(rect.top()) + 1) > count;
+    }
+
+    void insertNode(Node *node);
+    void removeNode(Node *node);
+    void insertEdge(Edge *edge);
+    void removeEdge(Edge *edge);
+    void updateNode(Node *node);
+    void clear();
+    void rebuild();
+
+    /**
+     * Rebuild the index if the document changed without element signals, i.e. by a bulk update.
+     */
+    void ensureCurrent()
+    {
+        if (m_stale) {
+            rebuild();
+        }
+    }
+
+    SpatialIndex *q;
+    GraphDocumentPtr m_document;
+    qreal m_cellSize;
+    bool m_stale; //!< if true, elements may have been added or removed without signals
+    // indexed nodes and edges in document order, removed elements are replaced by null
+    // pointers until the document removes their list entries
+    QVector<Node*> m_nodes;
+    QVector<Edge*> m_edges;
+    QHash<quint64, QVector<Node*> > m_nodeGrid;
+    QHash<Node*, quint64> m_nodeCells;
+    // elements removed during bulk updates may be deleted before the index is rebuilt, hence
+    // their connections are released by handle instead of via the node
+    QHash<Node*, QMetaObject::Connection> m_nodeConnections;
+    QHash<quint64, QVector<Edge*> > m_edgeGrid;
+    QHash<Edge*, QVector<quint64> > m_edgeCells;
+};
+
+void SpatialIndexPrivate::insertNode(Node *node)
+{
+    const quint64 nodeKey = key(cell(node->x()), cell(node->y()));
+    m_nodeCells.insert(node, nodeKey);
+    m_nodeGrid[nodeKey].append(node);
+    m_nodeConnections.insert(node, QObject::connect(node, &Node::positionChanged, q, [this, node]() {
+        if (!m_stale) {
+            updateNode(node);
+        }
+    }));
+}
+
+void SpatialIndexPrivate::removeNode(Node *node)
+{
+    if (!m_nodeCells.contains(node)) {
+        return;
+    }
+    QObject::disconnect(m_nodeConnections.take(node));
+    const quint64 nodeKey = m_nodeCells.take(node);
+    QVector<Node*> &nodes = m_nodeGrid[nodeKey];
+    nodes.removeOne(node);
+    if (nodes.isEmpty()) {
+        m_nodeGrid.remove(nodeKey);
+    }
+}
+
+void SpatialIndexPrivate::clear()
+{
+    foreach (const QMetaObject::Connection &connection, m_nodeConnections) {
+        QObject::disconnect(connection);
+    }
+    m_nodeConnections.clear();
+    m_nodes.clear();
+    m_edges.clear();
+    m_nodeGrid.clear();
+    m_nodeCells.clear();
+    m_edgeGrid.clear();
+    m_edgeCells.clear();
+}
+
+void SpatialIndexPrivate::rebuild()
+{
+    clear();
+    // a rebuild during a bulk update does not see the changes that follow it
+    m_stale = m_document && m_document->isBulkUpdate();
+    if (!m_document) {
+        return;
+    }
+    foreach (const NodePtr &node, m_document->nodes()) {
+        m_nodes.append(node.data());
+        insertNode(node.data());
+    }
+    foreach (const EdgePtr &edge, m_document->edges()) {
+        m_edges.append(edge.data());
+        insertEdge(edge.data());
+    }
+}
+
+void SpatialIndexPrivate::insertEdge(Edge *edge)
+{
+    // visit the cells crossed by the segment column by column
+    QPointF from(edge->from()->x(), edge->from()->y());
+    QPointF to(edge->to()->x(), edge->to()->y());
+    if (from.x() > to.x()) {
+        std::swap(from, to);
+    }
+    QVector<quint64> &cells = m_edgeCells[edge];
+    const qint64 last = cell(to.x());
+    for (qint64 column = cell(from.x()); column <= last; ++column) {
+        qreal top = from.y();
+        qreal bottom = to.y();
+        if (to.x() > from.x()) {
+            const qreal slope = (to.y() - from.y()) / (to.x() - from.x());
+            top = from.y() + (qMax(from.x(), column * m_cellSize) - from.x()) * slope;
+            bottom = from.y() + (qMin(to.x(), (column + 1) * m_cellSize) - from.x()) * slope;
+        }
+        const qint64 lastRow = cell(qMax(top, bottom));
+        for (qint64 row = cell(qMin(top, bottom)); row <= lastRow; ++row) {
+            cells.append(key(column, row));
+            m_edgeGrid[cells.last()].append(edge);
+        }
+    }
+}
+
+void SpatialIndexPrivate::removeEdge(Edge *edge)
+{
+    foreach (quint64 edgeKey, m_edgeCells.take(edge)) {
+        QVector<Edge*> &edges = m_edgeGrid[edgeKey];
+        edges.removeOne(edge);
+        if (edges.isEmpty()) {
+            m_edgeGrid.remove(edgeKey);
+        }
+    }
+}
+
+void SpatialIndexPrivate::updateNode(Node *node)
+{
+    const quint64 nodeKey = key(cell(node->x()), cell(node->y()));
+    if (m_nodeCells.value(node) != nodeKey) {
+        QVector<Node*> &nodes = m_nodeGrid[m_nodeCells.value(node)];
+        nodes.removeOne(node);
+        if (nodes.isEmpty()) {
+            m_nodeGrid.remove(m_nodeCells.value(node));
+        }
+        m_nodeCells.insert(node, nodeKey);
+        m_nodeGrid[nodeKey].append(node);
+    }
+    foreach (const EdgePtr &edge, node->edges()) {
+        if (m_edgeCells.contains(edge.data())) {
+            removeEdge(edge.data());
+            insertEdge(edge.data());
+        }
+    }
+}
+
+SpatialIndex::SpatialIndex(QObject *parent)
+    : QObject(parent)
+    , d(new SpatialIndexPrivate(this))
+{
+}
+
+SpatialIndex::~SpatialIndex()
+{
+
+}
+
+void SpatialIndex::setDocument(GraphDocumentPtr document)
+{
+    if (d->m_document == document) {
+        return;
+    }
+    if (d->m_document) {
+        d->m_document.data()->disconnect(this);
+    }
+    d->m_document = document;
+    if (d->m_document) {
+        connect(d->m_document.data(), &GraphDocument::nodeAboutToBeAdded, this, &SpatialIndex::onNodeAboutToBeAdded);
+        connect(d->m_document.data(), &GraphDocument::nodesAboutToBeRemoved, this, &SpatialIndex::onNodesAboutToBeRemoved);
+        connect(d->m_document.data(), &GraphDocument::nodeMoved, this, &SpatialIndex::onNodeMoved);
+        connect(d->m_document.data(), &GraphDocument::edgeAboutToBeAdded, this, &SpatialIndex::onEdgeAboutToBeAdded);
+        connect(d->m_document.data(), &GraphDocument::edgesAboutToBeRemoved, this, &SpatialIndex::onEdgesAboutToBeRemoved);
+        connect(d->m_document.data(), &GraphDocument::edgeMoved, this, &SpatialIndex::onEdgeMoved);
+        connect(d->m_document.data(), &GraphDocument::nodePositionsChanged, this, &SpatialIndex::rebuild);
+        connect(d->m_document.data(), &GraphDocument::bulkUpdateAboutToBegin, this, [this]() {
+            // the index is rebuilt on the next query, which keeps it usable during bulk updates
+            d->m_stale = true;
+        });
+        connect(d->m_document.data(), &GraphDocument::bulkUpdateFinished, this, &SpatialIndex::rebuild);
+        connect(d->m_document.data(), &GraphDocument::aboutToBeDestroyed, this, [this]() {
+            // all elements are removed next, which needs not to be followed
+            d->m_document.data()->disconnect(this);
+            clear();
+        });
+    }
+    rebuild();
+}
+
+void SpatialIndex::setCellSize(qreal size)
+{
+    if (size <= 0 || d->m_cellSize == size) {
+        return;
+    }
+    d->m_cellSize = size;
+    rebuild();
+}
+
+qreal SpatialIndex::cellSize() const
+{
+    return d->m_cellSize;
+}
+
+QList<int> SpatialIndex::nodesIn(const QRectF &rect) const
+{
+    d->ensureCurrent();
+    QList<int> result;
+    if (!d->m_document) {
+        return result;
+    }
+    const QRectF area = rect.normalized();
+    auto contains = [&area](const Node *node) {
+        return node->x() >= area.left() && node->x() <= area.right()
+            && node->y() >= area.top() && node->y() <= area.bottom();
+    };
+    if (d->exceedsCells(area, d->m_nodeCells.count())) {
+        foreach (Node *node, d->m_nodeCells.keys()) {
+            if (contains(node)) {
+                result.append(node->documentIndex());
+            }
+        }
+    } else {
+        for (qint64 column = d->cell(area.left()); column <= d->cell(area.right()); ++column) {
+            for (qint64 row = d->cell(area.top()); row <= d->cell(area.bottom()); ++row) {
+                foreach (Node *node, d->m_nodeGrid.value(SpatialIndexPrivate::key(column, row))) {
+                    if (contains(node)) {
+                        result.append(node->documentIndex());
+                    }
+                }
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+int SpatialIndex::nodeAt(const QPointF &point, qreal radius) const
+{
+    d->ensureCurrent();
+    int result = -1;
+    qreal best = radius;
+    for (qint64 column = d->cell(point.x() - radius); column <= d->cell(point.x() + radius); ++column) {
+        for (qint64 row = d->cell(point.y() - radius); row <= d->cell(point.y() + radius); ++row) {
+            foreach (Node *node, d->m_nodeGrid.value(SpatialIndexPrivate::key(column, row))) {
+                const QPointF delta = QPointF(node->x(), node->y()) - point;
+                const qreal distance = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+                if (distance <= best) {
+                    best = distance;
+                    result = node->documentIndex();
+                }
+            }
+        }
+    }
+    return result;
+}
+
+QList<int> SpatialIndex::edgesIn(const QRectF &rect) const
+{
+    d->ensureCurrent();
+    QList<int> result;
+    if (!d->m_document) {
+        return result;
+    }
+    const QRectF area = rect.normalized();
+    QSet<Edge*> candidates;
+    if (d->exceedsCells(area, d->m_edgeCells.count())) {
+        candidates = d->m_edgeCells.keys().toSet();
+    } else {
+        for (qint64 column = d->cell(area.left()); column <= d->cell(area.right()); ++column) {
+            for (qint64 row = d->cell(area.top()); row <= d->cell(area.bottom()); ++row) {
+                foreach (Edge *edge, d->m_edgeGrid.value(SpatialIndexPrivate::key(column, row))) {
+                    candidates.insert(edge);
+                }
+            }
+        }
+    }
+    foreach (Edge *edge, candidates) {
+        const QPointF from(edge->from()->x(), edge->from()->y());
+        const QPointF to(edge->to()->x(), edge->to()->y());
+        if (intersects(from, to, area)) {
+            result.append(edge->documentIndex());
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+int SpatialIndex::edgeAt(const QPointF &point, qreal tolerance) const
+{
+    d->ensureCurrent();
+    if (!d->m_document) {
+        return -1;
+    }
+    Edge *result = nullptr;
+    qreal best = tolerance;
+    for (qint64 column = d->cell(point.x() - tolerance); column <= d->cell(point.x() + tolerance); ++column) {
+        for (qint64 row = d->cell(point.y() - tolerance); row <= d->cell(point.y() + tolerance); ++row) {
+            foreach (Edge *edge, d->m_edgeGrid.value(SpatialIndexPrivate::key(column, row))) {
+                const QPointF from(edge->from()->x(), edge->from()->y());
+                const QPointF to(edge->to()->x(), edge->to()->y());
+                const qreal distance = distanceToSegment(point, from, to);
+                if (distance <= best) {
+                    best = distance;
+                    result = edge;
+                }
+            }
+        }
+    }
+    return result ? result->documentIndex() : -1;
+}
+
+void SpatialIndex::rebuild()
+{
+    d->rebuild();
+}
+
+void SpatialIndex::clear()
+{
+    d->clear();
+}
+
+void SpatialIndex::onNodeAboutToBeAdded(NodePtr node, int index)
+{
+    d->m_nodes.insert(index, node.data());
+    d->insertNode(node.data());
+}
+
+void SpatialIndex::onNodesAboutToBeRemoved(int first, int last)
+{
+    for (int i = first; i <= last; ++i) {
+        if (d->m_nodes.at(i)) {
+            d->removeNode(d->m_nodes.at(i));
+        }
+    }
+    d->m_nodes.remove(first, last - first + 1);
+}
+
+void SpatialIndex::onNodeMoved(int from, int to)
+{
+    // the moved node replaces the removed one, its old entry is removed next
+    d->removeNode(d->m_nodes.at(to));
+    d->m_nodes[to] = d->m_nodes.at(from);
+    d->m_nodes[from] = nullptr;
+}
+
+void SpatialIndex::onEdgeAboutToBeAdded(EdgePtr edge, int index)
+{
+    d->m_edges.insert(index, edge.data());
+    d->insertEdge(edge.data());
+}
+
+void SpatialIndex::onEdgesAboutToBeRemoved(int first, int last)
+{
+    for (int i = first; i <= last; ++i) {
+        if (d->m_edges.at(i)) {
+            d->removeEdge(d->m_edges.at(i));
+        }
+    }
+    d->m_edges.remove(first, last - first + 1);
+}
+
+void SpatialIndex::onEdgeMoved(int from, int to)
+{
+    d->removeEdge(d->m_edges.at(to));
+    d->m_edges[to] = d->m_edges.at(from);
+    d->m_edges[from] = nullptr;
+}
@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include "graphtheory_export.h"
+#include "typenames.h"
+
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QRectF>
+
+namespace GraphTheory
+{
+class SpatialIndexPrivate;
+
+/**
+ * \class SpatialIndex
+ * Uniform grid over the node positions and edge segments of a document, which answers the
+ * geometric queries of the graph view without visiting every node or edge. Nodes are stored in
+ * the cell that contains their position, edges in all cells that their segment crosses. The index
+ * follows all changes of the document, including position changes of single nodes.
+ *
+ * Results are given as indices in GraphDocument::nodes() and GraphDocument::edges(), the latter
+ * are also the rows of EdgeModel.
+ */
+class GRAPHTHEORY_EXPORT SpatialIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SpatialIndex(QObject *parent = 0);
+    virtual ~SpatialIndex();
+    void setDocument(GraphDocumentPtr document);
+
+    /**
+     * Set the width and height of grid cells to @p size, default is 64. The cell size should be
+     * of the order of typical query sizes; the index is rebuilt.
+     */
+    void setCellSize(qreal size);
+    qreal cellSize() const;
+
+    /**
+     * \return indices of all nodes whose positions lie inside @p rect
+     */
+    Q_INVOKABLE QList<int> nodesIn(const QRectF &rect) const;
+
+    /**
+     * \return index of the node closest to @p point with distance at most @p radius, -1 if
+     *         there is no such node
+     */
+    Q_INVOKABLE int nodeAt(const QPointF &point, qreal radius) const;
+
+    /**
+     * \return indices of all edges whose segments intersect @p rect
+     */
+    Q_INVOKABLE QList<int> edgesIn(const QRectF &rect) const;
+
+    /**
+     * \return index of the edge whose segment is closest to @p point with distance at most
+     *         @p tolerance, -1 if there is no such edge
+     */
+    Q_INVOKABLE int edgeAt(const QPointF &point, qreal tolerance) const;
+
+private Q_SLOTS:
+    void rebuild();
+    void clear();
+    void onNodeAboutToBeAdded(NodePtr node, int index);
+    void onNodesAboutToBeRemoved(int first, int last);
+    void onNodeMoved(int from, int to);
+    void onEdgeAboutToBeAdded(EdgePtr edge, int index);
+    void onEdgesAboutToBeRemoved(int first, int last);
+    void onEdgeMoved(int from, int to);
+
+private:
+    Q_DISABLE_COPY(SpatialIndex)
+    const QScopedPointer<SpatialIndexPrivate> d;
+};
+}
+
+#endif
@@ -0,0 +1,407 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "forcedirectedlayout.h"
+#include "layoutobserver.h"
+#include "layoututils_p.h"
+
+#include <QVarLengthArray>
+#include <QtConcurrentMap>
+#include <cmath>
+#include <limits>
+
+using namespace GraphTheory;
+
+namespace
+{
+// graphs with fewer nodes are processed sequentially, since threads would not pay off
+const int parallelNodeCount = 2000;
+const int blockSize = 512;
+// cells are not split below this depth, hence coincident nodes end up in a common leaf
+const int maxDepth = 32;
+// relative strength of repulsive forces and step length factor as proposed by Yifan Hu,
+// "Efficient and high quality force-directed graph drawing", Mathematica Journal 10 (2005)
+const qreal repulsion = 0.2;
+const qreal stepFactor = 0.9;
+// angle between subsequent nodes of spirals
+const qreal goldenAngle = 2.39996322972865332;
+
+struct QuadTreeCell
+{
+    QPointF center;
+    qreal halfWidth;
+    QPointF massCenter; //!< sum of all body positions while building, afterwards their mean
+    int mass;           //!< number of bodies in this cell
+    int firstChild;     //!< index of the first of four consecutive children, -1 for leaves
+    int body;           //!< first body of a leaf, -1 if the cell is empty or no leaf
+};
+
+/**
+ * Quadtree over all node positions, each node is a body of mass 1.
+ */
+class QuadTree
+{
+public:
+    explicit QuadTree(const QVector<QPointF> &positions);
+
+    /**
+     * \return the repulsive force on @p body, which is @p strength divided by the distance for
+     *         each other body, where cells that satisfy the opening criterion @p theta are
+     *         approximated by their center of mass
+     */
+    QPointF force(int body, qreal strength, qreal theta, qreal minDistance) const;
+
+private:
+    QuadTreeCell createCell(const QPointF &center, qreal halfWidth) const;
+    int quadrant(int cell, const QPointF &position) const;
+    void split(int cell);
+    void insert(int body);
+
+    const QVector<QPointF> &m_positions;
+    QVector<QuadTreeCell> m_cells;
+};
+
+}
+
+QuadTree::QuadTree(const QVector<QPointF> &positions)
+    : m_positions(positions)
+{
+    const QRectF box = LayoutUtils::boundingBox(positions);
+    const qreal halfWidth = qMax(qMax(box.width(), box.height()) / 2, qreal(1));
+    m_cells.reserve(4 * positions.count() + 1);
+    m_cells.append(createCell(box.center(), halfWidth * (1 + 1e-6)));
+    for (int body = 0; body < positions.count(); ++body) {
+        insert(body);
+    }
+    for (int cell = 0; cell < m_cells.count(); ++cell) {
+        if (m_cells.at(cell).mass > 0) {
+            m_cells[cell].massCenter /= m_cells.at(cell).mass;
+        }
+    }
+}
+
+QuadTreeCell QuadTree::createCell(const QPointF &center, qreal halfWidth) const
+{
+    QuadTreeCell cell;
+    cell.center = center;
+    cell.halfWidth = halfWidth;
+    cell.massCenter = QPointF(0, 0);
+    cell.mass = 0;
+    cell.firstChild = -1;
+    cell.body = -1;
+    return cell;
+}
+
+int QuadTree::quadrant(int cell, const QPointF &position) const
+{
+    const QPointF &center = m_cells.at(cell).center;
+    return (position.x() >= center.x() ? 1 : 0) + (position.y() >= center.y() ? 2 : 0);
+}
+
+void QuadTree::split(int cell)
+{
+    const int firstChild = m_cells.count();
+    const QPointF center = m_cells.at(cell).center;
+    const qreal halfWidth = m_cells.at(cell).halfWidth / 2;
+    for (int quadrant = 0; quadrant < 4; ++quadrant) {
+        const QPointF offset((quadrant & 1) ? halfWidth : -halfWidth, (quadrant & 2) ? halfWidth : -halfWidth);
+        m_cells.append(createCell(center + offset, halfWidth));
+    }
+    // the body of the former leaf moves into the matching child
+    const int body = m_cells.at(cell).body;
+    QuadTreeCell &child = m_cells[firstChild + quadrant(cell, m_positions.at(body))];
+    child.body = body;
+    child.mass = 1;
+    child.massCenter = m_positions.at(body);
+    m_cells[cell].firstChild = firstChild;
+    m_cells[cell].body = -1;
+}
+
+void QuadTree::insert(int body)
+{
+    const QPointF position = m_positions.at(body);
+    int cell = 0;
+    for (int depth = 0; ; ++depth) {
+        if (m_cells.at(cell).firstChild < 0) {
+            if (m_cells.at(cell).mass == 0 || depth == maxDepth) {
+                QuadTreeCell &leaf = m_cells[cell];
+                if (leaf.mass == 0) {
+                    leaf.body = body;
+                }
+                ++leaf.mass;
+                leaf.massCenter += position;
+                return;
+            }
+            split(cell);
+        }
+        QuadTreeCell &inner = m_cells[cell];
+        ++inner.mass;
+        inner.massCenter += position;
+        cell = inner.firstChild + quadrant(cell, position);
+    }
+}
+
+QPointF QuadTree::force(int body, qreal strength, qreal theta, qreal minDistance) const
+{
+    const QPointF position = m_positions.at(body);
+    const qreal thetaSquared = theta * theta;
+    QPointF force(0, 0);
+    QVarLengthArray<int, 128> stack;
+    stack.append(0);
+    while (!stack.isEmpty()) {
+        const QuadTreeCell &cell = m_cells.at(stack.last());
+        stack.removeLast();
+        const int mass = (cell.body == body) ? cell.mass - 1 : cell.mass;
+        if (mass <= 0) {
+            continue;
+        }
+        QPointF delta = position - cell.massCenter;
+        qreal distanceSquared = delta.x() * delta.x() + delta.y() * delta.y();
+        // open cells whose width is not small compared to their distance
+        if (cell.firstChild >= 0 && 4 * cell.halfWidth * cell.halfWidth >= thetaSquared * distanceSquared) {
+            for (int quadrant = 0; quadrant < 4; ++quadrant) {
+                stack.append(cell.firstChild + quadrant);
+            }
+            continue;
+        }
+        if (distanceSquared < minDistance * minDistance) {
+            // coincident nodes are pushed apart in a direction that only depends on the node
+            delta = QPointF(std::cos(body * goldenAngle), std::sin(body * goldenAngle)) * minDistance;
+            distanceSquared = minDistance * minDistance;
+        }
+        force += delta * (strength * mass / distanceSquared);
+    }
+    return force;
+}
+
+class GraphTheory::ForceDirectedLayoutPrivate
+{
+public:
+    ForceDirectedLayoutPrivate()
+        : m_maxIterations(500)
+        , m_theta(1.2)
+        , m_tolerance(0.01)
+        , m_initialStep(1)
+        , m_idealEdgeLength(0)
+        , m_observer(nullptr)
+    {
+    }
+
+    int m_maxIterations;
+    qreal m_theta;
+    qreal m_tolerance;
+    qreal m_initialStep;
+    qreal m_idealEdgeLength;
+    QRectF m_boundingRect;
+    LayoutObserver *m_observer;
+};
+
+ForceDirectedLayout::ForceDirectedLayout()
+    : d(new ForceDirectedLayoutPrivate)
+{
+}
+
+ForceDirectedLayout::~ForceDirectedLayout()
+{
+}
+
+void ForceDirectedLayout::setMaxIterations(int iterations)
+{
+    d->m_maxIterations = iterations;
+}
+
+int ForceDirectedLayout::maxIterations() const
+{
+    return d->m_maxIterations;
+}
+
+void ForceDirectedLayout::setTheta(qreal theta)
+{
+    d->m_theta = theta;
+}
+
+qreal ForceDirectedLayout::theta() const
+{
+    return d->m_theta;
+}
+
+void ForceDirectedLayout::setTolerance(qreal tolerance)
+{
+    d->m_tolerance = tolerance;
+}
+
+qreal ForceDirectedLayout::tolerance() const
+{
+    return d->m_tolerance;
+}
+
+void ForceDirectedLayout::setInitialStep(qreal step)
+{
+    d->m_initialStep = step;
+}
+
+qreal ForceDirectedLayout::initialStep() const
+{
+    return d->m_initialStep;
+}
+
+void ForceDirectedLayout::setIdealEdgeLength(qreal length)
+{
+    d->m_idealEdgeLength = length;
+}
+
+qreal ForceDirectedLayout::idealEdgeLength() const
+{
+    return d->m_idealEdgeLength;
+}
+
+void ForceDirectedLayout::setBoundingRect(const QRectF &rect)
+{
+    d->m_boundingRect = rect;
+}
+
+QRectF ForceDirectedLayout::boundingRect() const
+{
+    return d->m_boundingRect;
+}
+
+void ForceDirectedLayout::setObserver(LayoutObserver *observer)
+{
+    d->m_observer = observer;
+}
+
+LayoutObserver * ForceDirectedLayout::observer() const
+{
+    return d->m_observer;
+}
+
+int ForceDirectedLayout::apply(QVector<QPointF> &positions, const QVector<QPair<int, int> > &edges) const
+{
+    const int n = positions.count();
+    if (n == 0) {
+        return 0;
+    }
+    const QRectF start = LayoutUtils::boundingBox(positions);
+    qreal k = d->m_idealEdgeLength;
+    if (k <= 0) {
+        k = d->m_boundingRect.isValid() ? std::sqrt(d->m_boundingRect.width() * d->m_boundingRect.height() / n) : 50;
+    }
+    if (start.width() < 1e-3 * k && start.height() < 1e-3 * k) {
+        for (int i = 0; i < n; ++i) {
+            positions[i] = start.center() + QPointF(std::cos(i * goldenAngle), std::sin(i * goldenAngle)) * k * std::sqrt(qreal(i));
+        }
+    }
+
+    // adjacency lists in compressed sparse row form, each edge is stored at both end nodes
+    QVector<int> offsets(n + 1, 0);
+    foreach (const auto &edge, edges) {
+        if (edge.first != edge.second && edge.first >= 0 && edge.first < n && edge.second >= 0 && edge.second < n) {
+            ++offsets[edge.first + 1];
+            ++offsets[edge.second + 1];
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        offsets[i + 1] += offsets.at(i);
+    }
+    QVector<int> neighbors(offsets.at(n));
+    QVector<int> fill = offsets;
+    foreach (const auto &edge, edges) {
+        if (edge.first != edge.second && edge.first >= 0 && edge.first < n && edge.second >= 0 && edge.second < n) {
+            neighbors[fill[edge.first]++] = edge.second;
+            neighbors[fill[edge.second]++] = edge.first;
+        }
+    }
+
+    QVector<int> blocks;
+    for (int first = 0; first < n; first += blockSize) {
+        blocks.append(first);
+    }
+    const qreal strength = repulsion * k * k;
+    const qreal minDistance = 1e-3 * k;
+    QVector<QPointF> forces(n);
+    qreal step = d->m_initialStep * k;
+    qreal energy = std::numeric_limits<qreal>::max();
+    int progress = 0;
+    int iteration = 0;
+    while (iteration < d->m_maxIterations && n > 1) {
+        ++iteration;
+        const QuadTree tree(positions);
+        const QPointF *position = positions.constData();
+        QPointF *force = forces.data();
+        auto accumulate = [&](int first) {
+            const int last = qMin(first + blockSize, n);
+            for (int i = first; i < last; ++i) {
+                force[i] = tree.force(i, strength, d->m_theta, minDistance);
+                // attraction of distance squared divided by the ideal edge length
+                for (int arc = offsets.at(i); arc < offsets.at(i + 1); ++arc) {
+                    const QPointF delta = position[neighbors.at(arc)] - position[i];
+                    force[i] += delta * (std::sqrt(delta.x() * delta.x() + delta.y() * delta.y()) / k);
+                }
+            }
+        };
+        if (n >= parallelNodeCount) {
+            QtConcurrent::blockingMap(blocks, accumulate);
+        } else {
+            foreach (int first, blocks) {
+                accumulate(first);
+            }
+        }
+
+        // every node moves by the current step length in direction of its force
+        qreal newEnergy = 0;
+        qreal displacement = 0;
+        for (int i = 0; i < n; ++i) {
+            const qreal forceSquared = force[i].x() * force[i].x() + force[i].y() * force[i].y();
+            if (forceSquared > 0) {
+                positions[i] += force[i] * (step / std::sqrt(forceSquared));
+                displacement += step;
+            }
+            newEnergy += forceSquared;
+        }
+
+        // adaptive cooling: grow the step after several improvements in a row, shrink otherwise
+        if (newEnergy < energy) {
+            if (++progress >= 5) {
+                progress = 0;
+                step /= stepFactor;
+            }
+        } else {
+            progress = 0;
+            step *= stepFactor;
+        }
+        energy = newEnergy;
+        if (displacement / n < d->m_tolerance * k) {
+            break;
+        }
+        if (d->m_observer) {
+            if (d->m_observer->isCanceled()) {
+                break;
+            }
+            if (d->m_observer->isUpdateDue()) {
+                QVector<QPointF> snapshot = positions;
+                LayoutUtils::fitLayout(snapshot, d->m_boundingRect, start.center());
+                d->m_observer->update(snapshot);
+            }
+        }
+    }
+
+    LayoutUtils::fitLayout(positions, d->m_boundingRect, start.center());
+    return iteration;
+}
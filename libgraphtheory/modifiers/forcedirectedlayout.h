@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FORCEDIRECTEDLAYOUT_H
+#define FORCEDIRECTEDLAYOUT_H
+
+#include "graphtheory_export.h"
+
+#include <QPair>
+#include <QPointF>
+#include <QRectF>
+#include <QScopedPointer>
+#include <QVector>
+
+namespace GraphTheory
+{
+class ForceDirectedLayoutPrivate;
+class LayoutObserver;
+
+/** \brief spring-electrical force directed layout with Barnes-Hut approximation
+ *
+ * Nodes repel each other and edges pull their end nodes together, where the ideal distance of
+ * adjacent nodes is given by idealEdgeLength(). Repulsive forces are approximated by the
+ * Barnes-Hut scheme on a quadtree, which costs O(n log n) instead of O(n^2) per iteration, and are
+ * accumulated in parallel for large graphs. The step length is adapted to the progress of the
+ * layout energy, and the layout stops as soon as the mean node displacement of an iteration
+ * falls below tolerance() times the ideal edge length.
+ *
+ * The layout only works on positions and node index pairs, such that it can be used for graphs
+ * that do not belong to a document yet.
+ */
+class GRAPHTHEORY_EXPORT ForceDirectedLayout
+{
+public:
+    ForceDirectedLayout();
+    ~ForceDirectedLayout();
+
+    /**
+     * Set maximal number of iterations to @p iterations, default is 500.
+     */
+    void setMaxIterations(int iterations);
+    int maxIterations() const;
+
+    /**
+     * Set the Barnes-Hut opening criterion to @p theta, default is 1.2. A quadtree cell is
+     * approximated by its center of mass if its width divided by its distance is below @p theta;
+     * 0 computes exact forces.
+     */
+    void setTheta(qreal theta);
+    qreal theta() const;
+
+    /**
+     * Set the convergence tolerance relative to the ideal edge length to @p tolerance, default is
+     * 0.01.
+     */
+    void setTolerance(qreal tolerance);
+    qreal tolerance() const;
+
+    /**
+     * Set the step length of the first iteration relative to the ideal edge length to @p step,
+     * default is 1. Smaller values preserve more of the start positions, which is useful to
+     * refine an existing layout.
+     */
+    void setInitialStep(qreal step);
+    qreal initialStep() const;
+
+    /**
+     * Set the ideal distance of adjacent nodes to @p length. If @p length is 0, which is the
+     * default, the length is derived from the area of boundingRect() or is 50 if no bounding
+     * rectangle is set.
+     */
+    void setIdealEdgeLength(qreal length);
+    qreal idealEdgeLength() const;
+
+    /**
+     * Set the area @p rect into which the final layout is scaled and centered. By default, no
+     * bounding rectangle is set and the layout keeps its natural size around the center of the
+     * start positions.
+     */
+    void setBoundingRect(const QRectF &rect);
+    QRectF boundingRect() const;
+
+    /**
+     * Set @p observer that is informed after every iteration and may cancel the layout, default
+     * is none. The observer is not owned by the layout.
+     */
+    void setObserver(LayoutObserver *observer);
+    LayoutObserver * observer() const;
+
+    /**
+     * Compute the layout of the graph with nodes 0 to @p positions.count() - 1 and undirected
+     * @p edges, given as pairs of node indices. Self-loops are ignored.
+     *
+     * \param positions start positions, which are replaced by the computed positions; if all
+     *        start positions coincide, the nodes are first placed on a spiral
+     * \param edges pairs of node indices
+     * \return number of performed iterations
+     */
+    int apply(QVector<QPointF> &positions, const QVector<QPair<int, int> > &edges) const;
+
+private:
+    Q_DISABLE_COPY(ForceDirectedLayout)
+    const QScopedPointer<ForceDirectedLayoutPrivate> d;
+};
+}
+
+#endif
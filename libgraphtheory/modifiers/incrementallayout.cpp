@@ -0,0 +1,241 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "incrementallayout.h"
+
+#include <QHash>
+#include <QtMath>
+#include <cmath>
+
+using namespace GraphTheory;
+
+namespace
+{
+// relative strength of repulsive forces as used by ForceDirectedLayout
+const qreal repulsion = 0.2;
+// repulsive forces are only computed between nodes closer than this multiple of the edge length
+const qreal cutoff = 2;
+const qreal initialStep = 0.3;
+const qreal stepFactor = 0.9;
+// angle between subsequent nodes of spirals
+const qreal goldenAngle = 2.39996322972865332;
+// opening angle of the fan on which new neighbors of a placed node are spread
+const qreal fanAngle = 2.0943951023931954;
+
+quint64 cellKey(qint64 column, qint64 row)
+{
+    return (quint64(column) << 32) ^ quint64(row & 0xffffffff);
+}
+}
+
+class GraphTheory::IncrementalLayoutPrivate
+{
+public:
+    IncrementalLayoutPrivate()
+        : m_iterations(30)
+        , m_idealEdgeLength(50)
+    {
+    }
+
+    int m_iterations;
+    qreal m_idealEdgeLength;
+};
+
+IncrementalLayout::IncrementalLayout()
+    : d(new IncrementalLayoutPrivate)
+{
+}
+
+IncrementalLayout::~IncrementalLayout()
+{
+}
+
+void IncrementalLayout::setIterations(int iterations)
+{
+    d->m_iterations = iterations;
+}
+
+int IncrementalLayout::iterations() const
+{
+    return d->m_iterations;
+}
+
+void IncrementalLayout::setIdealEdgeLength(qreal length)
+{
+    d->m_idealEdgeLength = length;
+}
+
+qreal IncrementalLayout::idealEdgeLength() const
+{
+    return d->m_idealEdgeLength;
+}
+
+void IncrementalLayout::apply(QVector<QPointF> &positions, const QVector<QPair<int, int> > &edges, const QVector<bool> &pinned) const
+{
+    const int n = positions.count();
+    const qreal k = d->m_idealEdgeLength;
+    if (n == 0 || pinned.count() != n || k <= 0) {
+        return;
+    }
+
+    // adjacency lists in compressed sparse row form, each edge is stored at both end nodes
+    QVector<int> offsets(n + 1, 0);
+    foreach (const auto &edge, edges) {
+        if (edge.first != edge.second && edge.first >= 0 && edge.first < n && edge.second >= 0 && edge.second < n) {
+            ++offsets[edge.first + 1];
+            ++offsets[edge.second + 1];
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        offsets[i + 1] += offsets.at(i);
+    }
+    QVector<int> neighbors(offsets.at(n));
+    QVector<int> fill = offsets;
+    foreach (const auto &edge, edges) {
+        if (edge.first != edge.second && edge.first >= 0 && edge.first < n && edge.second >= 0 && edge.second < n) {
+            neighbors[fill[edge.first]++] = edge.second;
+            neighbors[fill[edge.second]++] = edge.first;
+        }
+    }
+
+    // breadth-first placement starting at the pinned nodes: nodes with a single placed neighbor
+    // are spread on a fan that points away from the neighbors of that node, other nodes are placed
+    // close to the barycenter of their placed neighbors
+    QVector<bool> placed = pinned;
+    QVector<int> queue;
+    queue.reserve(n);
+    QVector<int> movable;
+    for (int i = 0; i < n; ++i) {
+        if (pinned.at(i)) {
+            queue.append(i);
+        } else {
+            movable.append(i);
+        }
+    }
+    if (movable.isEmpty()) {
+        return;
+    }
+    QVector<int> unplaced;
+    int head = 0;
+    for (int anchor = -1; anchor < n; ++anchor) {
+        // unreachable components are anchored at their first node
+        if (anchor >= 0) {
+            if (placed.at(anchor)) {
+                continue;
+            }
+            placed[anchor] = true;
+            queue.append(anchor);
+        }
+        for (; head < queue.count(); ++head) {
+            const int node = queue.at(head);
+            const QPointF position = positions.at(node);
+            QPointF outward(0, 0);
+            unplaced.clear();
+            for (int arc = offsets.at(node); arc < offsets.at(node + 1); ++arc) {
+                const int next = neighbors.at(arc);
+                if (placed.at(next)) {
+                    outward += position - positions.at(next);
+                } else {
+                    unplaced.append(next);
+                }
+            }
+            const bool fan = outward.x() != 0 || outward.y() != 0;
+            const qreal direction = fan ? std::atan2(outward.y(), outward.x()) : 0;
+            for (int i = 0; i < unplaced.count(); ++i) {
+                const int next = unplaced.at(i);
+                if (placed.at(next)) {
+                    continue;
+                }
+                QPointF barycenter(0, 0);
+                int count = 0;
+                for (int arc = offsets.at(next); arc < offsets.at(next + 1); ++arc) {
+                    if (placed.at(neighbors.at(arc))) {
+                        barycenter += positions.at(neighbors.at(arc));
+                        ++count;
+                    }
+                }
+                if (count == 1) {
+                    const qreal angle = fan ? direction + fanAngle * ((i + qreal(0.5)) / unplaced.count() - qreal(0.5))
+                                            : 2 * M_PI * i / unplaced.count();
+                    positions[next] = position + QPointF(std::cos(angle), std::sin(angle)) * k;
+                } else {
+                    const qreal angle = next * goldenAngle;
+                    positions[next] = barycenter / count + QPointF(std::cos(angle), std::sin(angle)) * (0.25 * k);
+                }
+                placed[next] = true;
+                queue.append(next);
+            }
+        }
+    }
+
+    // local force iterations that only move the nodes that are not pinned, where repulsive forces
+    // are restricted to nodes in neighboring cells of a uniform grid
+    const qreal cellSize = cutoff * k;
+    const qreal strength = repulsion * k * k;
+    QVector<QPointF> forces(movable.count());
+    QHash<quint64, QVector<int> > cells;
+    qreal step = initialStep * k;
+    for (int iteration = 0; iteration < d->m_iterations; ++iteration) {
+        cells.clear();
+        for (int i = 0; i < n; ++i) {
+            cells[cellKey(std::floor(positions.at(i).x() / cellSize), std::floor(positions.at(i).y() / cellSize))].append(i);
+        }
+        for (int m = 0; m < movable.count(); ++m) {
+            const int i = movable.at(m);
+            const QPointF position = positions.at(i);
+            QPointF force(0, 0);
+            const qint64 column = std::floor(position.x() / cellSize);
+            const qint64 row = std::floor(position.y() / cellSize);
+            for (qint64 c = column - 1; c <= column + 1; ++c) {
+                for (qint64 r = row - 1; r <= row + 1; ++r) {
+                    foreach (int j, cells.value(cellKey(c, r))) {
+                        const QPointF delta = position - positions.at(j);
+                        const qreal distanceSquared = delta.x() * delta.x() + delta.y() * delta.y();
+                        if (j == i || distanceSquared >= cellSize * cellSize) {
+                            continue;
+                        }
+                        if (distanceSquared > 0) {
+                            force += delta * (strength / distanceSquared);
+                        } else {
+                            // coincident nodes are separated in a deterministic direction
+                            force += QPointF(std::cos(i * goldenAngle), std::sin(i * goldenAngle)) * k;
+                        }
+                    }
+                }
+            }
+            // attraction of distance squared divided by the ideal edge length
+            for (int arc = offsets.at(i); arc < offsets.at(i + 1); ++arc) {
+                const QPointF delta = positions.at(neighbors.at(arc)) - position;
+                force += delta * (std::sqrt(delta.x() * delta.x() + delta.y() * delta.y()) / k);
+            }
+            forces[m] = force;
+        }
+
+        // nodes move in direction of their force by at most the current step length
+        for (int m = 0; m < movable.count(); ++m) {
+            const QPointF &force = forces.at(m);
+            const qreal length = std::sqrt(force.x() * force.x() + force.y() * force.y());
+            if (length > 0) {
+                positions[movable.at(m)] += force * (qMin(step, length) / length);
+            }
+        }
+        step *= stepFactor;
+    }
+}
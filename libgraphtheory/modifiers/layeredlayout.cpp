@@ -0,0 +1,611 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "layeredlayout.h"
+#include "layoututils_p.h"
+
+#include <QSet>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <limits>
+
+using namespace GraphTheory;
+
+namespace
+{
+typedef QPair<int, int> IndexPair;
+
+/**
+ * Adjacency lists in compressed sparse row form: the targets of vertex v are stored at
+ * targets[offsets[v]] to targets[offsets[v + 1] - 1].
+ */
+struct Adjacency
+{
+    Adjacency(int vertexCount, const QVector<IndexPair> &arcs)
+        : offsets(vertexCount + 1, 0)
+        , targets(arcs.count())
+    {
+        foreach (const IndexPair &arc, arcs) {
+            ++offsets[arc.first + 1];
+        }
+        for (int v = 0; v < vertexCount; ++v) {
+            offsets[v + 1] += offsets.at(v);
+        }
+        QVector<int> fill = offsets;
+        foreach (const IndexPair &arc, arcs) {
+            targets[fill[arc.first]++] = arc.second;
+        }
+    }
+
+    int degree(int v) const
+    {
+        return offsets.at(v + 1) - offsets.at(v);
+    }
+
+    QVector<int> offsets;
+    QVector<int> targets;
+};
+
+QVector<IndexPair> reversed(const QVector<IndexPair> &arcs)
+{
+    QVector<IndexPair> result(arcs.count());
+    for (int i = 0; i < arcs.count(); ++i) {
+        result[i] = qMakePair(arcs.at(i).second, arcs.at(i).first);
+    }
+    return result;
+}
+
+/**
+ * \return valid edges without self-loops, where the back edges of a depth-first search are reversed
+ */
+QVector<IndexPair> acyclicEdges(int nodeCount, const QVector<IndexPair> &edges)
+{
+    QVector<IndexPair> arcs;
+    arcs.reserve(edges.count());
+    foreach (const IndexPair &edge, edges) {
+        if (edge.first != edge.second && edge.first >= 0 && edge.first < nodeCount
+            && edge.second >= 0 && edge.second < nodeCount) {
+            arcs.append(edge);
+        }
+    }
+
+    // arcs are identified by their index, such that the search can reverse them
+    QVector<IndexPair> arcIndices(arcs.count());
+    for (int i = 0; i < arcs.count(); ++i) {
+        arcIndices[i] = qMakePair(arcs.at(i).first, i);
+    }
+    const Adjacency outgoing(nodeCount, arcIndices);
+
+    enum State { Unvisited, Active, Finished };
+    QVector<State> state(nodeCount, Unvisited);
+    QVector<IndexPair> stack; // vertex and its next outgoing arc
+    for (int source = 0; source < nodeCount; ++source) {
+        if (state.at(source) != Unvisited) {
+            continue;
+        }
+        state[source] = Active;
+        stack.append(qMakePair(source, outgoing.offsets.at(source)));
+        while (!stack.isEmpty()) {
+            IndexPair &top = stack.last();
+            if (top.second == outgoing.offsets.at(top.first + 1)) {
+                state[top.first] = Finished;
+                stack.removeLast();
+                continue;
+            }
+            const int arc = outgoing.targets.at(top.second++);
+            const int target = arcs.at(arc).second;
+            if (state.at(target) == Unvisited) {
+                state[target] = Active;
+                stack.append(qMakePair(target, outgoing.offsets.at(target)));
+            } else if (state.at(target) == Active) {
+                arcs[arc] = qMakePair(target, arcs.at(arc).first);
+            }
+        }
+    }
+    return arcs;
+}
+
+/**
+ * \return layer of each node, such that every arc points to a higher layer
+ */
+QVector<int> assignLayers(int nodeCount, const QVector<IndexPair> &arcs)
+{
+    const Adjacency outgoing(nodeCount, arcs);
+    const Adjacency incoming(nodeCount, reversed(arcs));
+
+    // topological order
+    QVector<int> order;
+    order.reserve(nodeCount);
+    QVector<int> indegree(nodeCount);
+    for (int v = 0; v < nodeCount; ++v) {
+        indegree[v] = incoming.degree(v);
+        if (indegree.at(v) == 0) {
+            order.append(v);
+        }
+    }
+    for (int i = 0; i < order.count(); ++i) {
+        const int v = order.at(i);
+        for (int arc = outgoing.offsets.at(v); arc < outgoing.offsets.at(v + 1); ++arc) {
+            if (--indegree[outgoing.targets.at(arc)] == 0) {
+                order.append(outgoing.targets.at(arc));
+            }
+        }
+    }
+
+    // longest path from the sources
+    QVector<int> layer(nodeCount, 0);
+    foreach (int v, order) {
+        for (int arc = outgoing.offsets.at(v); arc < outgoing.offsets.at(v + 1); ++arc) {
+            const int w = outgoing.targets.at(arc);
+            layer[w] = qMax(layer.at(w), layer.at(v) + 1);
+        }
+    }
+
+    // moving nodes with more outgoing than incoming arcs down shortens more arcs than it stretches
+    for (int i = order.count() - 1; i >= 0; --i) {
+        const int v = order.at(i);
+        if (outgoing.degree(v) <= incoming.degree(v)) {
+            continue;
+        }
+        int lowest = std::numeric_limits<int>::max();
+        for (int arc = outgoing.offsets.at(v); arc < outgoing.offsets.at(v + 1); ++arc) {
+            lowest = qMin(lowest, layer.at(outgoing.targets.at(arc)));
+        }
+        layer[v] = qMax(layer.at(v), lowest - 1);
+    }
+    return layer;
+}
+
+/**
+ * Layered graph whose segments only connect subsequent layers: the vertices are the nodes followed
+ * by dummy nodes that split long arcs.
+ */
+struct LayeredGraph
+{
+    LayeredGraph(int nodeCount, const QVector<IndexPair> &arcs, const QVector<int> &nodeLayers)
+        : nodeCount(nodeCount)
+        , layer(nodeLayers)
+    {
+        QVector<IndexPair> segments;
+        segments.reserve(arcs.count());
+        foreach (const IndexPair &arc, arcs) {
+            int previous = arc.first;
+            for (int l = layer.at(arc.first) + 1; l < layer.at(arc.second); ++l) {
+                const int dummy = layer.count();
+                layer.append(l);
+                segments.append(qMakePair(previous, dummy));
+                previous = dummy;
+            }
+            segments.append(qMakePair(previous, arc.second));
+        }
+        const Adjacency lowerAdjacency(layer.count(), segments);
+        const Adjacency upperAdjacency(layer.count(), reversed(segments));
+        lowerOffsets = lowerAdjacency.offsets;
+        lower = lowerAdjacency.targets;
+        upperOffsets = upperAdjacency.offsets;
+        upper = upperAdjacency.targets;
+
+        int layerCount = 0;
+        foreach (int l, layer) {
+            layerCount = qMax(layerCount, l + 1);
+        }
+        layers.resize(layerCount);
+        position.resize(layer.count());
+        for (int v = 0; v < layer.count(); ++v) {
+            position[v] = layers.at(layer.at(v)).count();
+            layers[layer.at(v)].append(v);
+        }
+    }
+
+    bool isDummy(int v) const
+    {
+        return v >= nodeCount;
+    }
+
+    /**
+     * \return number of crossings of segments between layer @p l and the next layer
+     */
+    qint64 crossings(int l) const
+    {
+        // count inversions of lower end positions with a Fenwick tree
+        const int size = layers.at(l + 1).count();
+        QVector<int> tree(size + 1, 0);
+        qint64 inserted = 0;
+        qint64 result = 0;
+        QVarLengthArray<int, 16> ends;
+        foreach (int u, layers.at(l)) {
+            ends.clear();
+            for (int arc = lowerOffsets.at(u); arc < lowerOffsets.at(u + 1); ++arc) {
+                ends.append(position.at(lower.at(arc)));
+            }
+            std::sort(ends.begin(), ends.end());
+            foreach (int end, ends) {
+                int atMost = 0;
+                for (int i = end + 1; i > 0; i -= i & -i) {
+                    atMost += tree.at(i);
+                }
+                result += inserted - atMost;
+                for (int i = end + 1; i <= size; i += i & -i) {
+                    ++tree[i];
+                }
+                ++inserted;
+            }
+        }
+        return result;
+    }
+
+    qint64 crossings() const
+    {
+        qint64 result = 0;
+        for (int l = 0; l + 1 < layers.count(); ++l) {
+            result += crossings(l);
+        }
+        return result;
+    }
+
+    /**
+     * Sort layer @p l by the barycenters of the neighbors in the layer above if @p byUpper is
+     * true, otherwise in the layer below. Vertices without such neighbors keep their position.
+     */
+    void sortLayer(int l, bool byUpper)
+    {
+        const QVector<int> &offsets = byUpper ? upperOffsets : lowerOffsets;
+        const QVector<int> &neighbors = byUpper ? upper : lower;
+        QVector<QPair<qreal, int> > keys;
+        keys.reserve(layers.at(l).count());
+        foreach (int v, layers.at(l)) {
+            qreal key = position.at(v);
+            if (offsets.at(v + 1) > offsets.at(v)) {
+                qreal sum = 0;
+                for (int arc = offsets.at(v); arc < offsets.at(v + 1); ++arc) {
+                    sum += position.at(neighbors.at(arc));
+                }
+                key = sum / (offsets.at(v + 1) - offsets.at(v));
+            }
+            keys.append(qMakePair(key, v));
+        }
+        std::stable_sort(keys.begin(), keys.end(), [](const QPair<qreal, int> &a, const QPair<qreal, int> &b) {
+            return a.first < b.first;
+        });
+        for (int i = 0; i < keys.count(); ++i) {
+            layers[l][i] = keys.at(i).second;
+            position[keys.at(i).second] = i;
+        }
+    }
+
+    void setLayers(const QVector<QVector<int> > &newLayers)
+    {
+        layers = newLayers;
+        foreach (const QVector<int> &vertices, layers) {
+            for (int i = 0; i < vertices.count(); ++i) {
+                position[vertices.at(i)] = i;
+            }
+        }
+    }
+
+    int nodeCount;
+    QVector<int> layer;
+    QVector<int> position;
+    QVector<QVector<int> > layers;
+    QVector<int> upperOffsets;
+    QVector<int> upper;
+    QVector<int> lowerOffsets;
+    QVector<int> lower;
+};
+
+/**
+ * Reduce crossings by alternating down and up sweeps of barycentric ordering.
+ */
+void orderLayers(LayeredGraph &graph, int sweepLimit)
+{
+    qint64 best = graph.crossings();
+    QVector<QVector<int> > bestLayers = graph.layers;
+    int stale = 0;
+    for (int sweep = 0; sweep < sweepLimit && best > 0 && stale < 2; ++sweep) {
+        for (int l = 1; l < graph.layers.count(); ++l) {
+            graph.sortLayer(l, true);
+        }
+        for (int l = graph.layers.count() - 2; l >= 0; --l) {
+            graph.sortLayer(l, false);
+        }
+        const qint64 crossings = graph.crossings();
+        if (crossings < best) {
+            best = crossings;
+            bestLayers = graph.layers;
+            stale = 0;
+        } else {
+            ++stale;
+        }
+    }
+    graph.setLayers(bestLayers);
+}
+
+quint64 segmentKey(int upper, int lower)
+{
+    return (quint64(upper) << 32) | quint64(lower);
+}
+
+/**
+ * \return segments that are crossed by inner segments, i.e., segments between two dummy nodes
+ *         (type 1 conflicts of Brandes and Köpf)
+ */
+QSet<quint64> markConflicts(const LayeredGraph &graph)
+{
+    QSet<quint64> conflicts;
+    for (int l = 0; l + 1 < graph.layers.count(); ++l) {
+        const QVector<int> &lowerLayer = graph.layers.at(l + 1);
+        int k0 = 0;
+        int next = 0;
+        for (int l1 = 0; l1 < lowerLayer.count(); ++l1) {
+            const int v = lowerLayer.at(l1);
+            int innerUpper = -1;
+            if (graph.isDummy(v) && graph.upperOffsets.at(v + 1) > graph.upperOffsets.at(v)
+                && graph.isDummy(graph.upper.at(graph.upperOffsets.at(v)))) {
+                innerUpper = graph.upper.at(graph.upperOffsets.at(v));
+            }
+            if (l1 + 1 < lowerLayer.count() && innerUpper < 0) {
+                continue;
+            }
+            const int k1 = innerUpper >= 0 ? graph.position.at(innerUpper) : graph.layers.at(l).count() - 1;
+            for (; next <= l1; ++next) {
+                const int u = lowerLayer.at(next);
+                for (int arc = graph.upperOffsets.at(u); arc < graph.upperOffsets.at(u + 1); ++arc) {
+                    const int w = graph.upper.at(arc);
+                    const int k = graph.position.at(w);
+                    if ((k < k0 || k > k1) && !(graph.isDummy(u) && graph.isDummy(w))) {
+                        conflicts.insert(segmentKey(w, u));
+                    }
+                }
+            }
+            k0 = k1;
+        }
+    }
+    return conflicts;
+}
+
+/**
+ * Align vertices with median neighbors into vertical blocks and place the blocks as far left as
+ * possible. The four extremal alignments of Brandes and Köpf are obtained by mirroring the layered
+ * graph vertically (@p down) and horizontally (@p right).
+ * \return horizontal coordinate of each vertex
+ */
+QVector<qreal> alignedCoordinates(const LayeredGraph &graph, const QSet<quint64> &conflicts,
+                                  bool down, bool right, qreal distance)
+{
+    const int vertexCount = graph.layer.count();
+    const int layerCount = graph.layers.count();
+    auto viewPosition = [&](int v) {
+        return right ? graph.layers.at(graph.layer.at(v)).count() - 1 - graph.position.at(v) : graph.position.at(v);
+    };
+    auto viewLayer = [&](int i) -> const QVector<int> & {
+        return graph.layers.at(down ? layerCount - 1 - i : i);
+    };
+    auto viewVertex = [&](const QVector<int> &vertices, int k) {
+        return vertices.at(right ? vertices.count() - 1 - k : k);
+    };
+    const QVector<int> &offsets = down ? graph.lowerOffsets : graph.upperOffsets;
+    const QVector<int> &neighbors = down ? graph.lower : graph.upper;
+
+    // vertical alignment with the median neighbors in the previous layer
+    QVector<int> root(vertexCount);
+    QVector<int> align(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        root[v] = v;
+        align[v] = v;
+    }
+    QVarLengthArray<int, 16> sorted;
+    for (int i = 0; i < layerCount; ++i) {
+        const QVector<int> &vertices = viewLayer(i);
+        int r = -1;
+        for (int k = 0; k < vertices.count(); ++k) {
+            const int v = viewVertex(vertices, k);
+            const int degree = offsets.at(v + 1) - offsets.at(v);
+            if (degree == 0) {
+                continue;
+            }
+            sorted.clear();
+            for (int arc = offsets.at(v); arc < offsets.at(v + 1); ++arc) {
+                sorted.append(neighbors.at(arc));
+            }
+            std::sort(sorted.begin(), sorted.end(), [&](int a, int b) {
+                return viewPosition(a) < viewPosition(b);
+            });
+            for (int m = (degree - 1) / 2; m <= degree / 2; ++m) {
+                if (align.at(v) != v) {
+                    continue;
+                }
+                const int u = sorted.at(m);
+                const quint64 key = down ? segmentKey(v, u) : segmentKey(u, v);
+                if (!conflicts.contains(key) && r < viewPosition(u)) {
+                    align[u] = v;
+                    root[v] = root.at(u);
+                    align[v] = root.at(v);
+                    r = viewPosition(u);
+                }
+            }
+        }
+    }
+
+    // horizontal compaction: longest path in the graph of blocks, where each block must be placed
+    // right of the blocks of its left neighbors
+    QVector<IndexPair> constraints;
+    constraints.reserve(vertexCount);
+    for (int i = 0; i < layerCount; ++i) {
+        const QVector<int> &vertices = viewLayer(i);
+        for (int k = 1; k < vertices.count(); ++k) {
+            constraints.append(qMakePair(root.at(viewVertex(vertices, k - 1)), root.at(viewVertex(vertices, k))));
+        }
+    }
+    const Adjacency blocks(vertexCount, constraints);
+    QVector<int> indegree(vertexCount, 0);
+    foreach (const IndexPair &constraint, constraints) {
+        ++indegree[constraint.second];
+    }
+    QVector<int> order;
+    order.reserve(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        if (root.at(v) == v && indegree.at(v) == 0) {
+            order.append(v);
+        }
+    }
+    QVector<qreal> x(vertexCount, 0);
+    for (int i = 0; i < order.count(); ++i) {
+        const int block = order.at(i);
+        for (int arc = blocks.offsets.at(block); arc < blocks.offsets.at(block + 1); ++arc) {
+            const int next = blocks.targets.at(arc);
+            x[next] = qMax(x.at(next), x.at(block) + distance);
+            if (--indegree[next] == 0) {
+                order.append(next);
+            }
+        }
+    }
+    QVector<qreal> result(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        result[v] = right ? -x.at(root.at(v)) : x.at(root.at(v));
+    }
+    return result;
+}
+
+/**
+ * \return balanced horizontal coordinates of Brandes and Köpf: the four extremal alignments are
+ *         aligned to the narrowest one and each vertex is placed at the average of its median
+ *         coordinates
+ */
+QVector<qreal> balancedCoordinates(const LayeredGraph &graph, qreal distance)
+{
+    const int vertexCount = graph.layer.count();
+    const QSet<quint64> conflicts = markConflicts(graph);
+    QVector<QVector<qreal> > layouts;
+    QVector<qreal> minima;
+    QVector<qreal> maxima;
+    for (int direction = 0; direction < 4; ++direction) {
+        const QVector<qreal> x = alignedCoordinates(graph, conflicts, direction / 2 == 1, direction % 2 == 1, distance);
+        layouts.append(x);
+        minima.append(*std::min_element(x.constBegin(), x.constEnd()));
+        maxima.append(*std::max_element(x.constBegin(), x.constEnd()));
+    }
+    int narrowest = 0;
+    for (int direction = 1; direction < 4; ++direction) {
+        if (maxima.at(direction) - minima.at(direction) < maxima.at(narrowest) - minima.at(narrowest)) {
+            narrowest = direction;
+        }
+    }
+    for (int direction = 0; direction < 4; ++direction) {
+        // left alignments are aligned at the left border, right alignments at the right border
+        const qreal shift = direction % 2 == 0 ? minima.at(narrowest) - minima.at(direction)
+                                               : maxima.at(narrowest) - maxima.at(direction);
+        for (int v = 0; v < vertexCount; ++v) {
+            layouts[direction][v] += shift;
+        }
+    }
+    QVector<qreal> x(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        qreal values[4] = { layouts.at(0).at(v), layouts.at(1).at(v), layouts.at(2).at(v), layouts.at(3).at(v) };
+        std::sort(values, values + 4);
+        x[v] = (values[1] + values[2]) / 2;
+    }
+    return x;
+}
+}
+
+class GraphTheory::LayeredLayoutPrivate
+{
+public:
+    LayeredLayoutPrivate()
+        : m_layerDistance(100)
+        , m_nodeDistance(60)
+        , m_sweepLimit(12)
+    {
+    }
+
+    qreal m_layerDistance;
+    qreal m_nodeDistance;
+    int m_sweepLimit;
+    QRectF m_boundingRect;
+};
+
+LayeredLayout::LayeredLayout()
+    : d(new LayeredLayoutPrivate)
+{
+}
+
+LayeredLayout::~LayeredLayout()
+{
+}
+
+void LayeredLayout::setLayerDistance(qreal distance)
+{
+    d->m_layerDistance = distance;
+}
+
+qreal LayeredLayout::layerDistance() const
+{
+    return d->m_layerDistance;
+}
+
+void LayeredLayout::setNodeDistance(qreal distance)
+{
+    d->m_nodeDistance = distance;
+}
+
+qreal LayeredLayout::nodeDistance() const
+{
+    return d->m_nodeDistance;
+}
+
+void LayeredLayout::setSweepLimit(int sweeps)
+{
+    d->m_sweepLimit = sweeps;
+}
+
+int LayeredLayout::sweepLimit() const
+{
+    return d->m_sweepLimit;
+}
+
+void LayeredLayout::setBoundingRect(const QRectF &rect)
+{
+    d->m_boundingRect = rect;
+}
+
+QRectF LayeredLayout::boundingRect() const
+{
+    return d->m_boundingRect;
+}
+
+int LayeredLayout::apply(QVector<QPointF> &positions, const QVector<QPair<int, int> > &edges) const
+{
+    const int n = positions.count();
+    if (n == 0) {
+        return 0;
+    }
+    const QPointF center = LayoutUtils::boundingBox(positions).center();
+
+    const QVector<IndexPair> arcs = acyclicEdges(n, edges);
+    LayeredGraph graph(n, arcs, assignLayers(n, arcs));
+    orderLayers(graph, d->m_sweepLimit);
+    const QVector<qreal> x = balancedCoordinates(graph, d->m_nodeDistance);
+
+    for (int v = 0; v < n; ++v) {
+        positions[v] = QPointF(x.at(v), graph.layer.at(v) * d->m_layerDistance);
+    }
+    LayoutUtils::fitLayout(positions, d->m_boundingRect, center);
+    return graph.layers.count();
+}
@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LAYEREDLAYOUT_H
+#define LAYEREDLAYOUT_H
+
+#include "graphtheory_export.h"
+
+#include <QPair>
+#include <QPointF>
+#include <QRectF>
+#include <QScopedPointer>
+#include <QVector>
+
+namespace GraphTheory
+{
+class LayeredLayoutPrivate;
+
+/** \brief layered layout for directed graphs in the style of Sugiyama
+ *
+ * The layout places nodes on horizontal layers such that edges point downwards, and proceeds in
+ * the classic phases:
+ * - cycles are broken by reversing the back edges of a depth-first search,
+ * - nodes are assigned to layers by the longest path from the sources, after which nodes with
+ *   more outgoing than incoming edges are moved down next to their successors,
+ * - edges that span several layers are split by dummy nodes and the nodes of each layer are
+ *   ordered by barycentric sweeps to reduce edge crossings,
+ * - horizontal coordinates are assigned by the method of Brandes and Köpf, which aligns long
+ *   edges vertically and balances four extremal alignments.
+ *
+ * All phases run in time linear in the number of nodes, edges and dummy nodes, except for
+ * the ordering sweeps that additionally sort each layer.
+ */
+class GRAPHTHEORY_EXPORT LayeredLayout
+{
+public:
+    LayeredLayout();
+    ~LayeredLayout();
+
+    /**
+     * Set the vertical distance of subsequent layers to @p distance, default is 100.
+     */
+    void setLayerDistance(qreal distance);
+    qreal layerDistance() const;
+
+    /**
+     * Set the minimal horizontal distance of nodes in the same layer to @p distance, default
+     * is 60.
+     */
+    void setNodeDistance(qreal distance);
+    qreal nodeDistance() const;
+
+    /**
+     * Set the maximal number of down and up sweeps for crossing minimization to @p sweeps,
+     * default is 12. The sweeps also stop as soon as two sweeps in a row do not reduce the number
+     * of crossings.
+     */
+    void setSweepLimit(int sweeps);
+    int sweepLimit() const;
+
+    /**
+     * Set the area @p rect into which the final layout is scaled and centered. By default, no
+     * bounding rectangle is set and the layout keeps its natural size around the center of the
+     * start positions.
+     */
+    void setBoundingRect(const QRectF &rect);
+    QRectF boundingRect() const;
+
+    /**
+     * Compute the layout of the graph with nodes 0 to @p positions.count() - 1 and directed
+     * @p edges, given as pairs of source and target node index. Self-loops are ignored.
+     *
+     * \param positions start positions, which are replaced by the computed positions
+     * \param edges pairs of node indices
+     * \return number of layers
+     */
+    int apply(QVector<QPointF> &positions, const QVector<QPair<int, int> > &edges) const;
+
+private:
+    Q_DISABLE_COPY(LayeredLayout)
+    const QScopedPointer<LayeredLayoutPrivate> d;
+};
+}
+
+#endif
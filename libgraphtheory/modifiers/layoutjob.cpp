@@ -0,0 +1,284 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "layoutjob.h"
+#include "layoutobserver.h"
+#include "forcedirectedlayout.h"
+#include "multilevellayout.h"
+#include "graphdocument.h"
+#include "node.h"
+#include "edge.h"
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrentRun>
+
+using namespace GraphTheory;
+
+class GraphTheory::LayoutJobPrivate : public LayoutObserver
+{
+public:
+    LayoutJobPrivate(LayoutJob *q, LayoutJob::Algorithm algorithm, const NodeList &nodes)
+        : q(q)
+        , m_algorithm(algorithm)
+        , m_nodes(nodes)
+        , m_updateInterval(33)
+        , m_started(false)
+        , m_running(false)
+        , m_updatePending(false)
+        , m_updated(false)
+    {
+    }
+
+    bool isCanceled() const Q_DECL_OVERRIDE
+    {
+        return m_canceled.load();
+    }
+
+    bool isUpdateDue() const Q_DECL_OVERRIDE
+    {
+        return m_updateInterval > 0 && m_updateTimer.elapsed() >= m_updateInterval;
+    }
+
+    void update(const QVector<QPointF> &positions) Q_DECL_OVERRIDE
+    {
+        m_updateTimer.restart();
+        QMutexLocker locker(&m_updateMutex);
+        m_update = positions;
+        // the document is updated only once for several updates that arrive in between
+        if (!m_updatePending) {
+            m_updatePending = true;
+            QMetaObject::invokeMethod(q, "applyUpdate", Qt::QueuedConnection);
+        }
+    }
+
+    /**
+     * Compute the layout of m_positions, called in the worker thread.
+     */
+    void run()
+    {
+        m_updateTimer.start();
+        if (m_algorithm == LayoutJob::Multilevel) {
+            MultilevelLayout layout;
+            layout.setBoundingRect(m_layoutRect);
+            layout.setObserver(this);
+            layout.apply(m_positions, m_edges);
+        } else {
+            ForceDirectedLayout layout;
+            layout.setBoundingRect(m_layoutRect);
+            layout.setObserver(this);
+            layout.apply(m_positions, m_edges);
+        }
+    }
+
+    /**
+     * Write @p positions of m_nodes to their document with a single update.
+     */
+    void write(const QVector<QPointF> &positions)
+    {
+        if (!m_document) {
+            return;
+        }
+        QVector<QPointF> documentPositions = m_document->nodePositions();
+        for (int i = 0; i < m_nodes.count(); ++i) {
+            if (m_nodes.at(i)->isValid()) {
+                documentPositions[m_nodes.at(i)->documentIndex()] = positions.at(i);
+            }
+        }
+        m_document->setNodePositions(documentPositions);
+    }
+
+    /**
+     * Release all graph objects, such that the job does not keep a destroyed document alive.
+     */
+    void release()
+    {
+        m_canceled.store(1);
+        m_nodes.clear();
+        m_document.reset();
+    }
+
+    LayoutJob *q;
+    LayoutJob::Algorithm m_algorithm;
+    NodeList m_nodes;
+    GraphDocumentPtr m_document;
+    QRectF m_boundingRect;
+    QRectF m_layoutRect;
+    int m_updateInterval;
+    QVector<QPointF> m_start;
+    QVector<QPointF> m_positions;
+    QVector<QPair<int, int> > m_edges;
+    bool m_started;
+    bool m_running;
+    QAtomicInt m_canceled;
+    QFuture<void> m_future;
+    QFutureWatcher<void> m_watcher;
+    QElapsedTimer m_updateTimer;
+    QMutex m_updateMutex;
+    QVector<QPointF> m_update;
+    bool m_updatePending;
+    bool m_updated;
+};
+
+LayoutJob::LayoutJob(LayoutJob::Algorithm algorithm, const NodeList &nodes, QObject *parent)
+    : QObject(parent)
+    , d(new LayoutJobPrivate(this, algorithm, nodes))
+{
+    connect(&d->m_watcher, &QFutureWatcherBase::finished, this, &LayoutJob::finish);
+    if (!nodes.isEmpty()) {
+        d->m_document = nodes.first()->document();
+        connect(d->m_document.data(), &GraphDocument::aboutToBeDestroyed, this, [=]() {
+            d->release();
+        });
+    }
+}
+
+LayoutJob::~LayoutJob()
+{
+    d->m_canceled.store(1);
+    d->m_future.waitForFinished();
+}
+
+LayoutJob::Algorithm LayoutJob::algorithm() const
+{
+    return d->m_algorithm;
+}
+
+void LayoutJob::setBoundingRect(const QRectF &rect)
+{
+    d->m_boundingRect = rect;
+}
+
+QRectF LayoutJob::boundingRect() const
+{
+    return d->m_boundingRect;
+}
+
+void LayoutJob::setUpdateInterval(int msec)
+{
+    d->m_updateInterval = msec;
+}
+
+int LayoutJob::updateInterval() const
+{
+    return d->m_updateInterval;
+}
+
+void LayoutJob::start()
+{
+    if (d->m_started) {
+        return;
+    }
+    d->m_started = true;
+    d->m_running = true;
+    if (d->m_nodes.isEmpty() || d->isCanceled()) {
+        QMetaObject::invokeMethod(this, "finish", Qt::QueuedConnection);
+        return;
+    }
+
+    // copy positions and the edges between the nodes
+    const int n = d->m_nodes.count();
+    d->m_start.resize(n);
+    QRectF box(d->m_nodes.first()->x(), d->m_nodes.first()->y(), 0, 0);
+    QHash<NodePtr, int> indices;
+    indices.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const NodePtr &node = d->m_nodes.at(i);
+        d->m_start[i] = QPointF(node->x(), node->y());
+        box.setLeft(qMin(box.left(), node->x()));
+        box.setRight(qMax(box.right(), node->x()));
+        box.setTop(qMin(box.top(), node->y()));
+        box.setBottom(qMax(box.bottom(), node->y()));
+        indices.insert(node, i);
+    }
+    for (int i = 0; i < n; ++i) {
+        foreach (const EdgePtr &edge, d->m_nodes.at(i)->edges()) {
+            const int to = indices.value(edge->to(), -1);
+            if (edge->from() == d->m_nodes.at(i) && to >= 0) {
+                d->m_edges.append(qMakePair(i, to));
+            }
+        }
+    }
+    d->m_positions = d->m_start;
+
+    // nodes that are all placed at the same spot, e.g. by scripts, get the natural layout size
+    d->m_layoutRect = d->m_boundingRect;
+    if (!d->m_layoutRect.isValid() && (box.width() >= 10 || box.height() >= 10)) {
+        d->m_layoutRect = box;
+    }
+
+    d->m_future = QtConcurrent::run([=]() { d->run(); });
+    d->m_watcher.setFuture(d->m_future);
+}
+
+void LayoutJob::cancel()
+{
+    d->m_canceled.store(1);
+}
+
+void LayoutJob::waitForFinished()
+{
+    d->m_future.waitForFinished();
+    finish();
+}
+
+bool LayoutJob::isRunning() const
+{
+    return d->m_running;
+}
+
+bool LayoutJob::isCanceled() const
+{
+    return d->isCanceled();
+}
+
+void LayoutJob::applyUpdate()
+{
+    QVector<QPointF> positions;
+    {
+        QMutexLocker locker(&d->m_updateMutex);
+        positions = d->m_update;
+        d->m_update.clear();
+        d->m_updatePending = false;
+    }
+    if (!d->m_running || d->isCanceled() || positions.count() != d->m_nodes.count()) {
+        return;
+    }
+    d->write(positions);
+    d->m_updated = true;
+}
+
+void LayoutJob::finish()
+{
+    if (!d->m_running) {
+        return;
+    }
+    d->m_running = false;
+    if (!d->isCanceled()) {
+        d->write(d->m_positions);
+    } else if (d->m_updated) {
+        d->write(d->m_start);
+    }
+    emit finished();
+}
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LAYOUTJOB_H
+#define LAYOUTJOB_H
+
+#include "graphtheory_export.h"
+#include "typenames.h"
+
+#include <QObject>
+#include <QRectF>
+#include <QScopedPointer>
+
+namespace GraphTheory
+{
+class LayoutJobPrivate;
+
+/** \brief computes a layout of graph nodes in a worker thread
+ *
+ * The job copies the positions of its nodes and the edges between them when it is started and
+ * computes the layout on this copy, such that the document stays responsive. While the layout
+ * runs, intermediate positions are written to the document at most every updateInterval()
+ * milliseconds. The final positions are written with a single batched update, see
+ * GraphDocument::setNodePositions(). Nodes that are removed in the meantime are skipped.
+ *
+ * A job must be started from the thread of the document. It is canceled if the document is
+ * destroyed.
+ */
+class GRAPHTHEORY_EXPORT LayoutJob : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Algorithm {
+        ForceDirected,  //!< ForceDirectedLayout
+        Multilevel      //!< MultilevelLayout
+    };
+
+    /**
+     * Create job that arranges @p nodes, which must belong to the same document, by @p algorithm.
+     */
+    LayoutJob(Algorithm algorithm, const NodeList &nodes, QObject *parent = nullptr);
+    ~LayoutJob();
+
+    Algorithm algorithm() const;
+
+    /**
+     * Set the area @p rect into which the layout is fitted. By default, the layout is fitted into
+     * the current bounding box of the nodes, unless they are all close together.
+     */
+    void setBoundingRect(const QRectF &rect);
+    QRectF boundingRect() const;
+
+    /**
+     * Set minimal time between intermediate position updates to @p msec milliseconds, default is
+     * 33, i.e., at most 30 updates per second. If @p msec is 0, only the final positions are
+     * written.
+     */
+    void setUpdateInterval(int msec);
+    int updateInterval() const;
+
+    /**
+     * Start the layout in a worker thread. A job can only be started once.
+     */
+    void start();
+
+    /**
+     * Stop the layout. Positions are restored if intermediate positions were already written and
+     * finished() is emitted when the worker thread has stopped.
+     */
+    void cancel();
+
+    /**
+     * Block until the layout is finished and its positions are written.
+     */
+    void waitForFinished();
+
+    bool isRunning() const;
+    bool isCanceled() const;
+
+Q_SIGNALS:
+    /**
+     * Emitted when the final positions are written or the job is canceled.
+     */
+    void finished();
+
+private Q_SLOTS:
+    void applyUpdate();
+    void finish();
+
+private:
+    Q_DISABLE_COPY(LayoutJob)
+    const QScopedPointer<LayoutJobPrivate> d;
+};
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LAYOUTOBSERVER_H
+#define LAYOUTOBSERVER_H
+
+#include "graphtheory_export.h"
+
+#include <QPointF>
+#include <QVector>
+
+namespace GraphTheory
+{
+
+/** \brief interface to follow and cancel iterative layouts
+ *
+ * The methods are called from the thread that computes the layout, after every iteration.
+ */
+class GRAPHTHEORY_EXPORT LayoutObserver
+{
+public:
+    virtual ~LayoutObserver() {}
+
+    /**
+     * \return true if the layout shall stop, it then ends with the positions of the current
+     *         iteration
+     */
+    virtual bool isCanceled() const = 0;
+
+    /**
+     * \return true if the positions of the current iteration shall be passed to update()
+     */
+    virtual bool isUpdateDue() const = 0;
+
+    /**
+     * Receive intermediate @p positions of all nodes, already fitted into the bounding
+     * rectangle of the layout.
+     */
+    virtual void update(const QVector<QPointF> &positions) = 0;
+};
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LAYOUTUTILS_P_H
+#define LAYOUTUTILS_P_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+#include <limits>
+
+namespace GraphTheory
+{
+namespace LayoutUtils
+{
+/**
+ * \return smallest rectangle that contains all @p positions, which must not be empty
+ */
+inline QRectF boundingBox(const QVector<QPointF> &positions)
+{
+    qreal left = positions.first().x();
+    qreal right = left;
+    qreal top = positions.first().y();
+    qreal bottom = top;
+    foreach (const QPointF &position, positions) {
+        left = qMin(left, position.x());
+        right = qMax(right, position.x());
+        top = qMin(top, position.y());
+        bottom = qMax(bottom, position.y());
+    }
+    return QRectF(left, top, right - left, bottom - top);
+}
+
+/**
+ * Fit @p positions into @p boundingRect if it is valid, otherwise move their center to @p center.
+ */
+inline void fitLayout(QVector<QPointF> &positions, const QRectF &boundingRect, const QPointF &center)
+{
+    const QRectF result = boundingBox(positions);
+    if (boundingRect.isValid()) {
+        qreal scale = 1;
+        if (result.width() > 0 || result.height() > 0) {
+            scale = qMin(result.width() > 0 ? boundingRect.width() / result.width() : std::numeric_limits<qreal>::max(),
+                         result.height() > 0 ? boundingRect.height() / result.height() : std::numeric_limits<qreal>::max());
+        }
+        for (int i = 0; i < positions.count(); ++i) {
+            positions[i] = boundingRect.center() + (positions.at(i) - result.center()) * scale;
+        }
+    } else {
+        const QPointF offset = center - result.center();
+        for (int i = 0; i < positions.count(); ++i) {
+            positions[i] += offset;
+        }
+    }
+}
+}
+}
+
+#endif
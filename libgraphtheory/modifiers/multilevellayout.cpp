@@ -0,0 +1,444 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "multilevellayout.h"
+#include "forcedirectedlayout.h"
+#include "layoutobserver.h"
+#include "layoututils_p.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace GraphTheory;
+
+namespace
+{
+// levels at which a matching keeps more than this share of nodes are coarsened by an independent set
+const qreal maxMatchingShare = 0.75;
+// coarsening stops at levels that keep more than this share of nodes, e.g. for isolated nodes
+const qreal maxLevelShare = 0.9;
+// step length of refinement iterations relative to the ideal edge length of the level
+const qreal refinementStep = 0.2;
+// distance of merged nodes after prolongation relative to the ideal edge length of the level
+const qreal prolongationOffset = 0.1;
+// angle between subsequent nodes of spirals
+const qreal goldenAngle = 2.39996322972865332;
+
+typedef QPair<int, int> IndexPair;
+
+struct Level
+{
+    int nodeCount;
+    QVector<IndexPair> edges;
+    QVector<int> parent; //!< node of the next coarser level into which each node is merged
+};
+
+/**
+ * Adjacency lists in compressed sparse row form, each edge is stored at both end nodes.
+ */
+struct Adjacency
+{
+    Adjacency(int nodeCount, const QVector<IndexPair> &edges)
+        : offsets(nodeCount + 1, 0)
+    {
+        foreach (const IndexPair &edge, edges) {
+            if (isValid(edge, nodeCount)) {
+                ++offsets[edge.first + 1];
+                ++offsets[edge.second + 1];
+            }
+        }
+        for (int i = 0; i < nodeCount; ++i) {
+            offsets[i + 1] += offsets.at(i);
+        }
+        neighbors.resize(offsets.at(nodeCount));
+        QVector<int> fill = offsets;
+        foreach (const IndexPair &edge, edges) {
+            if (isValid(edge, nodeCount)) {
+                neighbors[fill[edge.first]++] = edge.second;
+                neighbors[fill[edge.second]++] = edge.first;
+            }
+        }
+    }
+
+    static bool isValid(const IndexPair &edge, int nodeCount)
+    {
+        return edge.first != edge.second
+            && edge.first >= 0 && edge.first < nodeCount
+            && edge.second >= 0 && edge.second < nodeCount;
+    }
+
+    int nodeCount() const
+    {
+        return offsets.count() - 1;
+    }
+
+    int degree(int node) const
+    {
+        return offsets.at(node + 1) - offsets.at(node);
+    }
+
+    /**
+     * \return all nodes ordered by degree, nodes of equal degree keep their order
+     */
+    QVector<int> degreeOrder(bool ascending) const
+    {
+        QVector<int> order(nodeCount());
+        for (int i = 0; i < order.count(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return ascending ? degree(a) < degree(b) : degree(a) > degree(b);
+        });
+        return order;
+    }
+
+    QVector<int> offsets;
+    QVector<int> neighbors;
+};
+
+/**
+ * Merge the end nodes of a maximal matching, where nodes of small degree are matched first and
+ * with their neighbor of smallest degree, such that hubs do not swallow the matching.
+ * \return number of coarse nodes
+ */
+int matchEdges(const Adjacency &adjacency, QVector<int> &parent)
+{
+    parent.fill(-1);
+    int count = 0;
+    foreach (int node, adjacency.degreeOrder(true)) {
+        if (parent.at(node) >= 0) {
+            continue;
+        }
+        int partner = -1;
+        for (int arc = adjacency.offsets.at(node); arc < adjacency.offsets.at(node + 1); ++arc) {
+            const int neighbor = adjacency.neighbors.at(arc);
+            if (parent.at(neighbor) < 0 && (partner < 0 || adjacency.degree(neighbor) < adjacency.degree(partner))) {
+                partner = neighbor;
+            }
+        }
+        parent[node] = count;
+        if (partner >= 0) {
+            parent[partner] = count;
+        }
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * Select a maximal independent set greedily by decreasing degree and merge every other node into
+ * its first selected neighbor.
+ * \return number of coarse nodes
+ */
+int selectIndependentSet(const Adjacency &adjacency, QVector<int> &parent)
+{
+    parent.fill(-1);
+    int count = 0;
+    foreach (int node, adjacency.degreeOrder(false)) {
+        if (parent.at(node) >= 0) {
+            continue;
+        }
+        parent[node] = count;
+        for (int arc = adjacency.offsets.at(node); arc < adjacency.offsets.at(node + 1); ++arc) {
+            const int neighbor = adjacency.neighbors.at(arc);
+            if (parent.at(neighbor) < 0) {
+                parent[neighbor] = count;
+            }
+        }
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * \return edges between distinct coarse nodes, each only once
+ */
+QVector<IndexPair> coarseEdges(const Level &level)
+{
+    QVector<IndexPair> edges;
+    edges.reserve(level.edges.count());
+    foreach (const IndexPair &edge, level.edges) {
+        if (!Adjacency::isValid(edge, level.nodeCount)) {
+            continue;
+        }
+        const int from = level.parent.at(edge.first);
+        const int to = level.parent.at(edge.second);
+        if (from != to) {
+            edges.append(qMakePair(qMin(from, to), qMax(from, to)));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    return edges;
+}
+
+/**
+ * \return positions of the input graph, where each node is placed at its ancestor in @p level
+ */
+QVector<QPointF> finestPositions(const QVector<Level> &levels, int level, const QVector<QPointF> &positions)
+{
+    QVector<QPointF> current = positions;
+    for (int fine = level - 1; fine >= 0; --fine) {
+        QVector<QPointF> prolongated(levels.at(fine).nodeCount);
+        for (int i = 0; i < prolongated.count(); ++i) {
+            prolongated[i] = current.at(levels.at(fine).parent.at(i));
+        }
+        current = prolongated;
+    }
+    return current;
+}
+
+/**
+ * Forwards the progress of coarse levels to an observer of the input graph.
+ */
+class LevelObserver : public LayoutObserver
+{
+public:
+    LevelObserver(LayoutObserver *observer, const QVector<Level> &levels, const QRectF &boundingRect)
+        : m_observer(observer)
+        , m_levels(levels)
+        , m_boundingRect(boundingRect)
+        , m_level(0)
+    {
+    }
+
+    void setLevel(int level)
+    {
+        m_level = level;
+    }
+
+    bool isCanceled() const Q_DECL_OVERRIDE
+    {
+        return m_observer->isCanceled();
+    }
+
+    bool isUpdateDue() const Q_DECL_OVERRIDE
+    {
+        return m_observer->isUpdateDue();
+    }
+
+    void update(const QVector<QPointF> &positions) Q_DECL_OVERRIDE
+    {
+        QVector<QPointF> snapshot = finestPositions(m_levels, m_level, positions);
+        if (m_boundingRect.isValid()) {
+            LayoutUtils::fitLayout(snapshot, m_boundingRect, m_boundingRect.center());
+        }
+        m_observer->update(snapshot);
+    }
+
+private:
+    LayoutObserver *m_observer;
+    const QVector<Level> &m_levels;
+    QRectF m_boundingRect;
+    int m_level;
+};
+}
+
+class GraphTheory::MultilevelLayoutPrivate
+{
+public:
+    MultilevelLayoutPrivate()
+        : m_coarsening(MultilevelLayout::EdgeMatching)
+        , m_coarsestNodeCount(50)
+        , m_refinementIterations(30)
+        , m_idealEdgeLength(0)
+        , m_observer(nullptr)
+    {
+    }
+
+    MultilevelLayout::Coarsening m_coarsening;
+    int m_coarsestNodeCount;
+    int m_refinementIterations;
+    qreal m_idealEdgeLength;
+    QRectF m_boundingRect;
+    LayoutObserver *m_observer;
+};
+
+MultilevelLayout::MultilevelLayout()
+    : d(new MultilevelLayoutPrivate)
+{
+}
+
+MultilevelLayout::~MultilevelLayout()
+{
+}
+
+void MultilevelLayout::setCoarsening(MultilevelLayout::Coarsening coarsening)
+{
+    d->m_coarsening = coarsening;
+}
+
+MultilevelLayout::Coarsening MultilevelLayout::coarsening() const
+{
+    return d->m_coarsening;
+}
+
+void MultilevelLayout::setCoarsestNodeCount(int count)
+{
+    d->m_coarsestNodeCount = count;
+}
+
+int MultilevelLayout::coarsestNodeCount() const
+{
+    return d->m_coarsestNodeCount;
+}
+
+void MultilevelLayout::setRefinementIterations(int iterations)
+{
+    d->m_refinementIterations = iterations;
+}
+
+int MultilevelLayout::refinementIterations() const
+{
+    return d->m_refinementIterations;
+}
+
+void MultilevelLayout::setIdealEdgeLength(qreal length)
+{
+    d->m_idealEdgeLength = length;
+}
+
+qreal MultilevelLayout::idealEdgeLength() const
+{
+    return d->m_idealEdgeLength;
+}
+
+void MultilevelLayout::setBoundingRect(const QRectF &rect)
+{
+    d->m_boundingRect = rect;
+}
+
+QRectF MultilevelLayout::boundingRect() const
+{
+    return d->m_boundingRect;
+}
+
+void MultilevelLayout::setObserver(LayoutObserver *observer)
+{
+    d->m_observer = observer;
+}
+
+LayoutObserver * MultilevelLayout::observer() const
+{
+    return d->m_observer;
+}
+
+int MultilevelLayout::apply(QVector<QPointF> &positions, const QVector<QPair<int, int> > &edges) const
+{
+    const int n = positions.count();
+    if (n == 0) {
+        return 0;
+    }
+    qreal k = d->m_idealEdgeLength;
+    if (k <= 0) {
+        k = d->m_boundingRect.isValid() ? std::sqrt(d->m_boundingRect.width() * d->m_boundingRect.height() / n) : 50;
+    }
+
+    // coarsen until the graph is small enough or cannot be reduced anymore
+    QVector<Level> levels(1);
+    levels[0].nodeCount = n;
+    levels[0].edges = edges;
+    while (levels.last().nodeCount > d->m_coarsestNodeCount) {
+        const Level &fine = levels.last();
+        const Adjacency adjacency(fine.nodeCount, fine.edges);
+        QVector<int> parent(fine.nodeCount);
+        int count = fine.nodeCount;
+        if (d->m_coarsening == EdgeMatching) {
+            count = matchEdges(adjacency, parent);
+        }
+        if (count > maxMatchingShare * fine.nodeCount) {
+            count = selectIndependentSet(adjacency, parent);
+        }
+        if (count > maxLevelShare * fine.nodeCount) {
+            break;
+        }
+        levels.last().parent = parent;
+        Level coarse;
+        coarse.nodeCount = count;
+        coarse.edges = coarseEdges(levels.last());
+        levels.append(coarse);
+    }
+
+    // ideal edge lengths grow with the coarsening, such that every level covers about the same area
+    QVector<qreal> lengths(levels.count());
+    lengths[0] = k;
+    for (int level = 1; level < levels.count(); ++level) {
+        lengths[level] = lengths.at(level - 1) * std::sqrt(qreal(levels.at(level - 1).nodeCount) / levels.at(level).nodeCount);
+    }
+
+    // coarse nodes start at the center of their merged nodes
+    QVector<QPointF> current = positions;
+    for (int level = 0; level + 1 < levels.count(); ++level) {
+        const Level &fine = levels.at(level);
+        QVector<QPointF> coarse(levels.at(level + 1).nodeCount);
+        QVector<int> mass(coarse.count(), 0);
+        for (int i = 0; i < fine.nodeCount; ++i) {
+            coarse[fine.parent.at(i)] += current.at(i);
+            ++mass[fine.parent.at(i)];
+        }
+        for (int i = 0; i < coarse.count(); ++i) {
+            coarse[i] /= mass.at(i);
+        }
+        current = coarse;
+    }
+
+    LevelObserver levelObserver(d->m_observer, levels, d->m_boundingRect);
+    ForceDirectedLayout layout;
+    layout.setIdealEdgeLength(lengths.last());
+    if (levels.count() == 1) {
+        layout.setBoundingRect(d->m_boundingRect);
+        layout.setObserver(d->m_observer);
+    } else if (d->m_observer) {
+        levelObserver.setLevel(levels.count() - 1);
+        layout.setObserver(&levelObserver);
+    }
+    layout.apply(current, levels.last().edges);
+
+    // prolongate each level to the next finer one and refine it
+    layout.setMaxIterations(d->m_refinementIterations);
+    layout.setInitialStep(refinementStep);
+    for (int level = levels.count() - 2; level >= 0; --level) {
+        if (d->m_observer && d->m_observer->isCanceled()) {
+            positions = finestPositions(levels, level + 1, current);
+            LayoutUtils::fitLayout(positions, d->m_boundingRect, LayoutUtils::boundingBox(positions).center());
+            return levels.count();
+        }
+        const Level &fine = levels.at(level);
+        QVector<QPointF> prolongated(fine.nodeCount);
+        QVector<int> children(current.count(), 0);
+        for (int i = 0; i < fine.nodeCount; ++i) {
+            const int parent = fine.parent.at(i);
+            const int child = children[parent]++;
+            prolongated[i] = current.at(parent)
+                + QPointF(std::cos(child * goldenAngle), std::sin(child * goldenAngle)) * (prolongationOffset * lengths.at(level) * std::sqrt(qreal(child)));
+        }
+        current = prolongated;
+        layout.setIdealEdgeLength(lengths.at(level));
+        if (level == 0) {
+            layout.setBoundingRect(d->m_boundingRect);
+            layout.setObserver(d->m_observer);
+        } else {
+            levelObserver.setLevel(level);
+        }
+        layout.apply(current, fine.edges);
+    }
+    positions = current;
+    return levels.count();
+}
@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MULTILEVELLAYOUT_H
+#define MULTILEVELLAYOUT_H
+
+#include "graphtheory_export.h"
+
+#include <QPair>
+#include <QPointF>
+#include <QRectF>
+#include <QScopedPointer>
+#include <QVector>
+
+namespace GraphTheory
+{
+class MultilevelLayoutPrivate;
+class LayoutObserver;
+
+/** \brief multilevel force directed layout for very large graphs
+ *
+ * The graph is repeatedly coarsened by merging nodes until only a few nodes remain. The coarsest
+ * graph is laid out by a ForceDirectedLayout, then each level is prolongated to the next finer one
+ * by placing every node next to the node it was merged into, and refined by a few force directed
+ * iterations. Since the global structure is already resolved on the coarse levels, this converges
+ * much faster than a single level layout and does not get stuck in folded layouts of large sparse
+ * graphs.
+ *
+ * As ForceDirectedLayout, the layout only works on positions and node index pairs.
+ */
+class GRAPHTHEORY_EXPORT MultilevelLayout
+{
+public:
+    enum Coarsening {
+        EdgeMatching,   //!< merge the end nodes of a maximal matching
+        IndependentSet  //!< merge every node into a neighbor of a maximal independent set
+    };
+
+    MultilevelLayout();
+    ~MultilevelLayout();
+
+    /**
+     * Set the scheme that merges nodes of one level to @p coarsening, default is EdgeMatching.
+     * Levels at which the matching hardly reduces the graph, e.g. at the center of a star, are
+     * always coarsened by an independent set.
+     */
+    void setCoarsening(Coarsening coarsening);
+    Coarsening coarsening() const;
+
+    /**
+     * Stop coarsening as soon as a level has at most @p count nodes, default is 50.
+     */
+    void setCoarsestNodeCount(int count);
+    int coarsestNodeCount() const;
+
+    /**
+     * Set the maximal number of force directed iterations for refining each level except the
+     * coarsest one to @p iterations, default is 30.
+     */
+    void setRefinementIterations(int iterations);
+    int refinementIterations() const;
+
+    /**
+     * Set the ideal distance of adjacent nodes in the final layout to @p length. If @p length is 0,
+     * which is the default, the length is derived from the area of boundingRect() or is 50 if no
+     * bounding rectangle is set.
+     */
+    void setIdealEdgeLength(qreal length);
+    qreal idealEdgeLength() const;
+
+    /**
+     * Set the area @p rect into which the final layout is scaled and centered. By default, no
+     * bounding rectangle is set and the layout keeps its natural size around the center of the
+     * start positions.
+     */
+    void setBoundingRect(const QRectF &rect);
+    QRectF boundingRect() const;
+
+    /**
+     * Set @p observer that is informed after every iteration of every level and may cancel the
+     * layout, default is none. Intermediate positions of coarse levels are reported for the input
+     * graph, where merged nodes share a position. The observer is not owned by the layout.
+     */
+    void setObserver(LayoutObserver *observer);
+    LayoutObserver * observer() const;
+
+    /**
+     * Compute the layout of the graph with nodes 0 to @p positions.count() - 1 and undirected
+     * @p edges, given as pairs of node indices. Self-loops are ignored.
+     *
+     * \param positions start positions, which are replaced by the computed positions; nodes of
+     *        the coarsest level start at the centers of their merged nodes
+     * \param edges pairs of node indices
+     * \return number of levels, including the input graph
+     */
+    int apply(QVector<QPointF> &positions, const QVector<QPair<int, int> > &edges) const;
+
+private:
+    Q_DISABLE_COPY(MultilevelLayout)
+    const QScopedPointer<MultilevelLayoutPrivate> d;
+};
+}
+
+#endif
@@ -19,15 +19,19 @@
  */
 
 #include "topology.h"
+#include "layoutjob.h"
+#include "layeredlayout.h"
+#include "incrementallayout.h"
 #include "graphdocument.h"
 #include "edge.h"
 #include "logging_p.h"
 
+#include <QHash>
 #include <QList>
 #include <QPair>
+#include <QPointF>
 #include <QVector>
 
-#include <boost/graph/fruchterman_reingold.hpp>
 #include <boost/graph/circle_layout.hpp>
 #include <boost/graph/random_layout.hpp>
 #include <boost/graph/adjacency_list.hpp>
@@ -73,70 +77,97 @@ void Topology::applyMinCutTreeAlignment(NodeList nodes)
         return;
     }
 
-    PositionVec position_vec(nodes.count());
+    // minimize cuts by force directed layout
+    LayoutJob job(LayoutJob::ForceDirected, nodes);
+    job.setUpdateInterval(0);
+    job.start();
+    job.waitForFinished();
+}
 
-    // set box inside which we may reposition
-    QList<qreal> xList;
-    QList<qreal> yList;
-    foreach(NodePtr node, nodes) {
-        xList << node->x();
-        yList << node->y();
+void Topology::applyMultilevelAlignment(NodeList nodes)
+{
+    if (nodes.count() < 3) {
+        return;
     }
-    qSort(xList.begin(), xList.end());
-    qSort(yList.begin(), yList.end());
+    LayoutJob job(LayoutJob::Multilevel, nodes);
+    job.setUpdateInterval(0);
+    job.start();
+    job.waitForFinished();
+}
 
-    // do not perform algorithm if graph is very dense:
-    // this prevents very long algorithm computations and possible threading issues
-    if (xList.last() - xList.first() < 10 && yList.last() - yList.first() < 10 ) {
-        qCDebug(GRAPHTHEORY_GENERAL) << "Aborting min cut alignment: nodes are already close to each other.";
+void Topology::applyLayeredAlignment(NodeList nodes)
+{
+    if (nodes.isEmpty()) {
         return;
     }
-
-    topology_type topology(xList.first(), yList.first(), xList.last(), yList.last());
-
-    // create IDs for all nodes
-    QMap<NodePtr, int> node_mapping;
-    QMap<QPair<int, int>, EdgePtr > edge_mapping; // to map all edges back afterwards
-    int counter = 0;
-    foreach(NodePtr node, nodes) {
-        node_mapping[node] = counter++;
+    GraphDocumentPtr document = nodes.first()->document();
+    QVector<QPointF> documentPositions = document->nodePositions();
+    QVector<QPointF> positions(nodes.count());
+    QHash<NodePtr, int> indices;
+    indices.reserve(nodes.count());
+    for (int i = 0; i < nodes.count(); ++i) {
+        positions[i] = documentPositions.at(nodes.at(i)->documentIndex());
+        indices.insert(nodes.at(i), i);
     }
-
-    QVector<BoostEdge> edges(nodes.first()->document()->edges().count());
-
-    counter = 0;
-    foreach(EdgePtr edge, nodes.first()->document()->edges()) {
-        edges[counter++] = BoostEdge(node_mapping[edge->from()], node_mapping[edge->to()]);
+    QVector<QPair<int, int> > edges;
+    for (int i = 0; i < nodes.count(); ++i) {
+        foreach (const EdgePtr &edge, nodes.at(i)->edges()) {
+            const int to = indices.value(edge->to(), -1);
+            if (edge->from() == nodes.at(i) && to >= 0) {
+                edges.append(qMakePair(i, to));
+            }
+        }
     }
 
-    // setup the graph
-    Graph graph(
-        edges.begin(),
-        edges.end(),
-        nodes.count()
-    );
+    LayeredLayout layout;
+    layout.apply(positions, edges);
+    for (int i = 0; i < nodes.count(); ++i) {
+        documentPositions[nodes.at(i)->documentIndex()] = positions.at(i);
+    }
+    document->setNodePositions(documentPositions);
+}
 
-    PositionMap positionMap(position_vec.begin(), get(boost::vertex_index, graph));
-    counter = 0;
-    foreach(NodePtr node, nodes) {
-        positionMap[counter][0] = node->x();
-        positionMap[counter][1] = node->y();
-        counter++;
+void Topology::applyIncrementalAlignment(NodeList nodes)
+{
+    if (nodes.isEmpty()) {
+        return;
     }
 
-    // minimize cuts by Fruchtman-Reingold layout algorithm
-    boost::fruchterman_reingold_force_directed_layout< topology_type, Graph, PositionMap >
-    (graph,
-     positionMap,
-     topology,
-     boost::cooling(boost::linear_cooling<double>(100))
-    );
+    // local graph of the given nodes followed by their pinned neighbors outside of the set
+    NodeList local = nodes;
+    QHash<NodePtr, int> indices;
+    indices.reserve(nodes.count());
+    for (int i = 0; i < nodes.count(); ++i) {
+        indices.insert(nodes.at(i), i);
+    }
+    QVector<QPair<int, int> > edges;
+    for (int i = 0; i < nodes.count(); ++i) {
+        foreach (const EdgePtr &edge, nodes.at(i)->edges()) {
+            const NodePtr other = edge->from() == nodes.at(i) ? edge->to() : edge->from();
+            int j = indices.value(other, -1);
+            if (j < 0) {
+                j = local.count();
+                indices.insert(other, j);
+                local.append(other);
+            } else if (j < nodes.count() && edge->from() != nodes.at(i)) {
+                // edges between two given nodes are visited twice
+                continue;
+            }
+            edges.append(qMakePair(i, j));
+        }
+    }
+    QVector<QPointF> positions(local.count());
+    QVector<bool> pinned(local.count());
+    for (int i = 0; i < local.count(); ++i) {
+        positions[i] = QPointF(local.at(i)->x(), local.at(i)->y());
+        pinned[i] = i >= nodes.count();
+    }
 
-    // put nodes at whiteboard as generated
-    foreach(NodePtr node, nodes) {
-        Vertex v = boost::vertex(node_mapping[node], graph);
-        node->setX(positionMap[v][0]);
-        node->setY(positionMap[v][1]);
+    IncrementalLayout layout;
+    layout.apply(positions, edges, pinned);
+    for (int i = 0; i < nodes.count(); ++i) {
+        nodes.at(i)->setX(positions.at(i).x());
+        nodes.at(i)->setY(positions.at(i).y());
     }
 }
 
@@ -198,20 +229,19 @@ void Topology::applyCircleAlignment(NodeList nodes, qreal radius)
                                                     radius);
 
     // put nodes at whiteboard as generated
+    GraphDocumentPtr document = nodes.first()->document();
+    QVector<QPointF> positions = document->nodePositions();
     foreach(NodePtr node, nodes) {
         Vertex v = boost::vertex(node_mapping[node], graph);
-        node->setX(positionMap[v][0]);
-        node->setY(positionMap[v][1]);
+        positions[node->documentIndex()] = QPointF(positionMap[v][0], positionMap[v][1]);
     }
+    document->setNodePositions(positions);
 }
 
 
 void Topology::directedGraphDefaultTopology(GraphDocumentPtr document)
 {
-    //TODO: port to graphviz layout functions
-    qCDebug(GRAPHTHEORY_GENERAL) << "Temporary implementation, should be replaced soon.";
-    applyCircleAlignment(document->nodes(), 300);
-    applyMinCutTreeAlignment(document->nodes());
+    applyLayeredAlignment(document->nodes());
 }
 
 
@@ -34,6 +34,8 @@ namespace GraphTheory
  * Methods of this class either can be applied to graphs to
  * make unique changes or connected to specific re-format signals to
  * apply a given topology after every change of the structure.
+ * All methods block until the layout is finished; use LayoutJob to
+ * compute force directed layouts in the background.
  */
 class GRAPHTHEORY_EXPORT Topology
 {
@@ -41,18 +43,56 @@ public:
     Topology();
     virtual ~Topology();
 
-    /** \brief applies Fruchterman-Reingold cut minimization
+    /** \brief applies force directed cut minimization
      *
-     * For the given node set this algorithm applies the Boost implementation
-     * of the Frutherman-Reingold force directed layout algorithm to minimize
-     * crossing edges. Data must be element of the same graph. The
-     * crossings of all present edges contained in this graph are
-     * minimized. This method directly modifies the node.
+     * For the given node set this algorithm applies the ForceDirectedLayout
+     * to minimize crossing edges. Data must be element of the same graph. The
+     * crossings of all edges between nodes of the set are minimized and the
+     * result is fitted into the current bounding box of the nodes. This method
+     * directly modifies the node.
      * \param nodeList is the list of all nodes
      * \return void
      */
     void applyMinCutTreeAlignment(NodeList nodes);
 
+    /** \brief applies multilevel force directed layout
+     *
+     * For the given node set this algorithm applies the MultilevelLayout, which
+     * resolves the global structure on coarsened graphs before refining the layout
+     * of the given nodes. Use this instead of applyMinCutTreeAlignment() for large
+     * sparse graphs. As for applyMinCutTreeAlignment(), only edges between nodes of
+     * the set are considered and the result is fitted into the current bounding box
+     * of the nodes. This method directly modifies the node.
+     * \param nodeList is the list of all nodes
+     * \return void
+     */
+    void applyMultilevelAlignment(NodeList nodes);
+
+    /** \brief applies incremental layout to node set
+     *
+     * Only the given nodes are moved, all other nodes of the document keep their
+     * positions. The given nodes are placed next to their neighbors and refined
+     * by a few local force iterations, see IncrementalLayout. Only the given nodes
+     * and their direct neighbors are visited, hence the cost does not depend on the
+     * size of the document. Use this method to arrange nodes that were added to an
+     * existing layout. This method directly modifies the node.
+     * \param nodeList is the list of nodes to move
+     * \return void
+     */
+    void applyIncrementalAlignment(NodeList nodes);
+
+    /** \brief applies layered layout to node set
+     *
+     * For the given node set this algorithm applies the LayeredLayout, which
+     * places the nodes on horizontal layers such that edges point downwards
+     * wherever the graph is acyclic. Only edges between nodes of the set are
+     * considered. The layout keeps its natural size and is centered at the
+     * current center of the nodes. This method directly modifies the node.
+     * \param nodeList is the list of all nodes
+     * \return void
+     */
+    void applyLayeredAlignment(NodeList nodes);
+
     /** \brief applies Circle topology to node set
      *
      * For the given node set this algorithm applies the Boost implementation
@@ -65,10 +105,10 @@ public:
      */
     void applyCircleAlignment(NodeList nodes, qreal radius=0);
 
-    /** \brief applies a default topology for undirected graphs
+    /** \brief applies a default topology for directed graphs
      *
-     * Use this method to apply a best-fit topology to an undirected graph (though the
-     * graph need not to be of type "Graph") only based on the node connections.
+     * Use this method to apply a best-fit topology to a directed graph only based on
+     * the node connections, which is the layered layout of applyLayeredAlignment().
      * I.e., no possible present coordinates are respected.
      */
     void directedGraphDefaultTopology(GraphDocumentPtr document);
@@ -27,11 +27,12 @@
 
 #include <QPointF>
 #include <QColor>
+#include <QVector>
 
 using namespace GraphTheory;
 
 // initialize number of edge objects
-uint Node::objectCounter = 0;
+QAtomicInteger<uint> Node::objectCounter(0);
 
 class GraphTheory::NodePrivate {
 public:
@@ -41,6 +42,7 @@ public:
         , m_y(0)
         , m_color(Qt::white)
         , m_id(-1)
+        , m_documentIndex(-1)
     {
     }
 
@@ -53,10 +55,13 @@ public:
     NodeTypePtr m_type;
     EdgeList m_edges;
     bool m_valid;
+    // position and color are kept in document buffers while the node is contained in a document
     qreal m_x;
     qreal m_y;
     QColor m_color;
     int m_id;
+    int m_documentIndex;
+    QVector<QVariant> m_dynamicValues;
 };
 
 Node::Node()
@@ -118,6 +123,23 @@ GraphDocumentPtr Node::document() const
     return d->m_document;
 }
 
+int Node::documentIndex() const
+{
+    return d->m_documentIndex;
+}
+
+void Node::setDocumentIndex(int index)
+{
+    // keep position and color when leaving the document buffers
+    if (index < 0 && d->m_documentIndex >= 0) {
+        const QPointF position = d->m_document->nodePosition(d->m_documentIndex);
+        d->m_x = position.x();
+        d->m_y = position.y();
+        d->m_color = d->m_document->nodeColor(d->m_documentIndex);
+    }
+    d->m_documentIndex = index;
+}
+
 NodeTypePtr Node::type() const
 {
     Q_ASSERT(d->m_type);
@@ -133,6 +155,16 @@ void Node::setType(NodeTypePtr type)
     if (d->m_type) {
         d->m_type->disconnect(this);
         d->m_type->style()->disconnect(this);
+
+        // move values to the slots of the new type, properties unknown to it are dropped
+        QVector<QVariant> values(type->dynamicProperties().count());
+        for (int i = 0; i < d->m_dynamicValues.count(); ++i) {
+            const int index = type->dynamicPropertyIndex(d->m_type->dynamicProperties().at(i));
+            if (index >= 0) {
+                values[index] = d->m_dynamicValues.at(i);
+            }
+        }
+        d->m_dynamicValues = values;
     }
     d->m_type = type;
     connect(type.data(), &NodeType::dynamicPropertyAboutToBeAdded,
@@ -141,10 +173,10 @@ void Node::setType(NodeTypePtr type)
         this, &Node::dynamicPropertyAdded);
     connect(type.data(), &NodeType::dynamicPropertiesAboutToBeRemoved,
         this, &Node::dynamicPropertiesAboutToBeRemoved);
+    connect(type.data(), &NodeType::dynamicPropertiesAboutToBeRemoved,
+        this, &Node::removeDynamicPropertyValues);
     connect(type.data(), &NodeType::dynamicPropertyRemoved,
         this, &Node::dynamicPropertyRemoved);
-    connect(type.data(), &NodeType::dynamicPropertyRemoved,
-        this, &Node::updateDynamicProperty);
     connect(type.data(), &NodeType::dynamicPropertyRenamed,
         this, &Node::renameDynamicProperty);
     connect(type->style(), &NodeTypeStyle::changed,
@@ -244,55 +276,92 @@ void Node::setId(int id)
     if (id == d->m_id) {
         return;
     }
+    const int oldId = d->m_id;
     d->m_id = id;
+    if (d->m_document) {
+        d->m_document->updateId(d->q, oldId);
+    }
     emit idChanged(id);
 }
 
 qreal Node::x() const
 {
-    return d->m_x;
+    if (d->m_documentIndex < 0) {
+        return d->m_x;
+    }
+    return d->m_document->nodePosition(d->m_documentIndex).x();
 }
 
 void Node::setX(qreal x)
 {
-    if (x == d->m_x) {
+    QPointF position = d->m_documentIndex < 0 ? QPointF(d->m_x, d->m_y) : d->m_document->nodePosition(d->m_documentIndex);
+    if (x == position.x()) {
         return;
     }
-    d->m_x = x;
-    emit positionChanged(QPointF(x, d->m_y));
+    position.setX(x);
+    if (d->m_documentIndex < 0) {
+        d->m_x = x;
+    } else {
+        d->m_document->setNodePosition(d->m_documentIndex, position);
+    }
+    emit positionChanged(position);
 }
 
 qreal Node::y() const
 {
-    return d->m_y;
+    if (d->m_documentIndex < 0) {
+        return d->m_y;
+    }
+    return d->m_document->nodePosition(d->m_documentIndex).y();
 }
 
 void Node::setY(qreal y)
 {
-    if (y == d->m_y) {
+    QPointF position = d->m_documentIndex < 0 ? QPointF(d->m_x, d->m_y) : d->m_document->nodePosition(d->m_documentIndex);
+    if (y == position.y()) {
         return;
     }
-    d->m_y = y;
-    emit positionChanged(QPointF(d->m_x, y));
+    position.setY(y);
+    if (d->m_documentIndex < 0) {
+        d->m_y = y;
+    } else {
+        d->m_document->setNodePosition(d->m_documentIndex, position);
+    }
+    emit positionChanged(position);
 }
 
 QColor Node::color() const
 {
-    return d->m_color;
+    if (d->m_documentIndex < 0) {
+        return d->m_color;
+    }
+    return d->m_document->nodeColor(d->m_documentIndex);
 }
 
 void Node::setColor(const QColor &color)
 {
-    if (color == d->m_color) {
+    if (color == Node::color()) {
         return;
     }
-    d->m_color = color;
+    if (d->m_documentIndex < 0) {
+        d->m_color = color;
+    } else {
+        d->m_document->setNodeColor(d->m_documentIndex, color);
+    }
     emit colorChanged(color);
 }
 
 QVariant Node::dynamicProperty(const QString &property) const
 {
-    return Node::property(("_graph_" + property).toLatin1());
+    if (!d->m_type) {
+        return QVariant();
+    }
+    return dynamicProperty(d->m_type->dynamicPropertyIndex(property));
+}
+
+QVariant Node::dynamicProperty(int index) const
+{
+    return d->m_dynamicValues.value(index);
 }
 
 QStringList Node::dynamicProperties() const
@@ -307,28 +376,56 @@ void Node::setDynamicProperty(const QString &property, const QVariant &value)
 {
     if (!d->m_type) {
         qCWarning(GRAPHTHEORY_GENERAL) << "No type registered, aborting to set property.";
+        return;
     }
-    if (value.isValid() && !d->m_type->dynamicProperties().contains(property)) {
-        qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+    const int index = d->m_type->dynamicPropertyIndex(property);
+    if (index < 0) {
+        if (value.isValid()) {
+            qCWarning(GRAPHTHEORY_GENERAL) << "Dynamic property not registered at type, aborting to set property.";
+        }
+        return;
+    }
+    setDynamicProperty(index, value);
+}
+
+void Node::setDynamicProperty(int index, const QVariant &value)
+{
+    Q_ASSERT(d->m_type);
+    Q_ASSERT(index >= 0 && index < d->m_type->dynamicProperties().count());
+    if (!storeDynamicProperty(index, value)) {
+        return;
+    }
+    emit dynamicPropertyChanged(index);
+}
+
+bool Node::storeDynamicProperty(int index, const QVariant &value)
+{
+    if (index < 0 || index >= d->m_type->dynamicProperties().count()) {
+        return false;
+    }
+    // slots are only allocated up to the last set property
+    if (index >= d->m_dynamicValues.count()) {
+        if (!value.isValid()) {
+            return false;
+        }
+        d->m_dynamicValues.resize(index + 1);
     }
-    setProperty(("_graph_" + property).toLatin1(), value);
-    emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(property));
+    d->m_dynamicValues[index] = value;
+    return true;
 }
 
-void Node::updateDynamicProperty(const QString &property)
+void Node::removeDynamicPropertyValues(int first, int last)
 {
-    // remove property if not registered at type
-    if (!d->m_type->dynamicProperties().contains(property)) {
-        setDynamicProperty(property, QVariant::Invalid);
+    if (first < d->m_dynamicValues.count()) {
+        d->m_dynamicValues.remove(first, qMin(last, d->m_dynamicValues.count() - 1) - first + 1);
     }
-    emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(property));
 }
 
 void Node::renameDynamicProperty(const QString &oldProperty, const QString &newProperty)
 {
-    setDynamicProperty(newProperty, dynamicProperty(oldProperty));
-    setDynamicProperty(oldProperty, QVariant::Invalid);
-    emit dynamicPropertyChanged(d->m_type->dynamicProperties().indexOf(newProperty));
+    Q_UNUSED(oldProperty);
+    // values are stored by slot, which is preserved by renaming
+    emit dynamicPropertyChanged(d->m_type->dynamicPropertyIndex(newProperty));
 }
 
 void Node::setQpointer(NodePtr q)
@@ -26,6 +26,7 @@
 #include "graphdocument.h"
 
 #include <QObject>
+#include <QAtomicInteger>
 #include <QColor>
 
 class QPointF;
@@ -82,6 +83,14 @@ public:
      */
     GraphDocumentPtr document() const;
 
+    /**
+     * The document index is the position of the node in GraphDocument::nodes(). It is maintained
+     * by the document and may change whenever another node is removed from the document.
+     *
+     * @return position of the node in its document or -1 if node is not contained in document
+     */
+    int documentIndex() const;
+
     /**
      * Return the NodeType of the node. This value is always valid.
      *
@@ -176,6 +185,15 @@ public:
      */
     QVariant dynamicProperty(const QString &property) const;
 
+    /**
+     * Access dynamic property by its slot @p index as given by NodeType::dynamicPropertyIndex().
+     * Use this method instead of the name based lookup when accessing the same property for
+     * many elements.
+     *
+     * @return return value of dynamic property, value is QVariant::Invalid if it is not set
+     */
+    QVariant dynamicProperty(int index) const;
+
     /**
      * @return list of dynamic properties registered at node type
      */
@@ -183,8 +201,9 @@ public:
 
     /**
      * Set dynamic property with identifier @c property. If @c value is
-     * QVariant::Invalid, the dynamic property is unset. Internally, this
-     * method use the QObject::setProperty mechanism but prefixes properties to avoid name clashes.
+     * QVariant::Invalid, the dynamic property is unset. The property must be registered at the
+     * node type, otherwise the value is not stored. Values are kept in one slot per registered
+     * property, see NodeType::dynamicPropertyIndex().
      *
      * @param property is the identifier for the new property
      * @param value is the value of this property
@@ -192,7 +211,16 @@ public:
     void setDynamicProperty(const QString &property, const QVariant &value);
 
     /**
-     * Rename dynamic property from identifier @c oldProperty to @c newProperty.
+     * Set dynamic property with slot @p index as given by NodeType::dynamicPropertyIndex().
+     *
+     * @param index is the slot of the property
+     * @param value is the value of this property
+     */
+    void setDynamicProperty(int index, const QVariant &value);
+
+    /**
+     * Notify about renaming of dynamic property from identifier @c oldProperty to @c newProperty
+     * at the type. The value is preserved, since its slot does not change by renaming.
      *
      * @param oldProperty the former value of the property
      * @param newProperty the new value of the property
@@ -206,7 +234,7 @@ public:
      */
     static uint objects()
     {
-        return objectCounter;
+        return objectCounter.load();
     }
 
 Q_SIGNALS:
@@ -229,7 +257,7 @@ Q_SIGNALS:
     void dynamicPropertiesChanged();
 
 private Q_SLOTS:
-    void updateDynamicProperty(const QString &property);
+    void removeDynamicPropertyValues(int first, int last);
 
 protected:
     Node();
@@ -238,7 +266,12 @@ private:
     Q_DISABLE_COPY(Node)
     const QScopedPointer<NodePrivate> d;
     void setQpointer(NodePtr q);
-    static uint objectCounter;
+    void setDocumentIndex(int index);
+    /** store value of dynamic property slot @p index without notification, @return true if stored **/
+    bool storeDynamicProperty(int index, const QVariant &value);
+    static QAtomicInteger<uint> objectCounter;
+
+    friend class GraphDocument;
 };
 }
 
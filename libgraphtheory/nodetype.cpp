@@ -22,11 +22,12 @@
 #include "nodetypestyle.h"
 #include "graphdocument.h"
 #include <QDebug>
+#include <QHash>
 
 using namespace GraphTheory;
 
 // initialize number of node type objects
-uint NodeType::objectCounter = 0;
+QAtomicInteger<uint> NodeType::objectCounter(0);
 
 class GraphTheory::NodeTypePrivate {
 public:
@@ -49,6 +50,7 @@ public:
     NodeTypeStyle *m_style;
     GraphDocumentPtr m_document;
     QStringList m_dynamicProperties;
+    QHash<QString, int> m_dynamicPropertyIndices;
     QString m_name;
     bool m_valid;
 };
@@ -129,7 +131,11 @@ void NodeType::setId(int id)
     if (id == d->m_id) {
         return;
     }
+    const int oldId = d->m_id;
     d->m_id = id;
+    if (d->m_document) {
+        d->m_document->updateId(d->q, oldId);
+    }
     emit idChanged(id);
 }
 
@@ -143,37 +149,49 @@ QStringList NodeType::dynamicProperties() const
     return d->m_dynamicProperties;
 }
 
+int NodeType::dynamicPropertyIndex(const QString &property) const
+{
+    return d->m_dynamicPropertyIndices.value(property, -1);
+}
+
 void NodeType::addDynamicProperty(const QString& property)
 {
-    if (d->m_dynamicProperties.contains(property)) {
+    if (d->m_dynamicPropertyIndices.contains(property)) {
         return;
     }
     emit dynamicPropertyAboutToBeAdded(property, d->m_dynamicProperties.count());
+    d->m_dynamicPropertyIndices.insert(property, d->m_dynamicProperties.count());
     d->m_dynamicProperties.append(property);
     emit dynamicPropertyAdded();
 }
 
 void NodeType::removeDynamicProperty(const QString& property)
 {
-    if (!d->m_dynamicProperties.contains(property)) {
+    if (!d->m_dynamicPropertyIndices.contains(property)) {
         return;
     }
-    int index = d->m_dynamicProperties.indexOf(property);
+    const int index = d->m_dynamicPropertyIndices.value(property);
     emit dynamicPropertiesAboutToBeRemoved(index, index);
     d->m_dynamicProperties.removeAt(index);
+    d->m_dynamicPropertyIndices.remove(property);
+    // all following properties move by one slot
+    for (int i = index; i < d->m_dynamicProperties.count(); ++i) {
+        d->m_dynamicPropertyIndices[d->m_dynamicProperties.at(i)] = i;
+    }
     emit dynamicPropertyRemoved(property);
 }
 
 void NodeType::renameDynamicProperty(const QString& oldProperty, const QString& newProperty)
 {
-    Q_ASSERT(d->m_dynamicProperties.contains(oldProperty));
-    Q_ASSERT(!d->m_dynamicProperties.contains(newProperty));
+    Q_ASSERT(d->m_dynamicPropertyIndices.contains(oldProperty));
+    Q_ASSERT(!d->m_dynamicPropertyIndices.contains(newProperty));
 
-    if (!d->m_dynamicProperties.contains(oldProperty) || d->m_dynamicProperties.contains(newProperty)) {
+    if (!d->m_dynamicPropertyIndices.contains(oldProperty) || d->m_dynamicPropertyIndices.contains(newProperty)) {
         return;
     }
-    int index = d->m_dynamicProperties.indexOf(oldProperty);
+    const int index = d->m_dynamicPropertyIndices.take(oldProperty);
     d->m_dynamicProperties[index] = newProperty;
+    d->m_dynamicPropertyIndices.insert(newProperty, index);
     emit dynamicPropertyRenamed(oldProperty, newProperty);
     emit dynamicPropertyChanged(index);
 }
@@ -25,6 +25,7 @@
 #include "typenames.h"
 
 #include <QObject>
+#include <QAtomicInteger>
 #include <QSharedPointer>
 
 class QStringList;
@@ -109,6 +110,15 @@ public:
      */
     QStringList dynamicProperties() const;
 
+    /**
+     * Dynamic properties are stored at the nodes in dense slots that correspond to the position
+     * of the property in dynamicProperties(). The lookup is performed in constant time, such
+     * that it can be done once before accessing the property of many elements by index.
+     *
+     * @return index of dynamic property @p property or -1 if it is not registered
+     */
+    int dynamicPropertyIndex(const QString &property) const;
+
     /**
      * Add dynamic property @c property to list of dynamic properties.
      * Signal dynamicPropertyAdded(@c property) is emitted afterwards
@@ -135,7 +145,7 @@ public:
      */
     static uint objects()
     {
-        return objectCounter;
+        return objectCounter.load();
     }
 
 Q_SIGNALS:
@@ -156,7 +166,7 @@ private:
     Q_DISABLE_COPY(NodeType)
     const QScopedPointer<NodeTypePrivate> d;
     void setQpointer(NodeTypePtr q);
-    static uint objectCounter;
+    static QAtomicInteger<uint> objectCounter;
 };
 }
 
@@ -130,29 +130,149 @@ Item {
             height: sceneScrollView.height - 20
             z: -10 // must lie behind everything else
             property variant origin: Qt.point(0, 0) // coordinate of global origin (0,0) in scene
-            signal deleteSelected();
-            signal startMoveSelected();
-            signal finishMoveSelected();
-            signal updateSelection();
-            signal createEdgeUpdateFromNode();
-            signal createEdgeUpdateToNode();
+            property var __movedNodes: [] // nodes moved by current mouse move, and their start positions
+            property var __moveStartPositions: []
+            readonly property real __nodeRadius: 16 // radius of drawn nodes for hit-testing
+            function updateSelection()
+            {
+                // query selected nodes from the spatial index, which works on global coordinates
+                var rect = Qt.rect(Math.min(selectionRect.from.x, selectionRect.to.x) + origin.x,
+                                   Math.min(selectionRect.from.y, selectionRect.to.y) + origin.y,
+                                   Math.abs(selectionRect.from.x - selectionRect.to.x),
+                                   Math.abs(selectionRect.from.y - selectionRect.to.y))
+                nodeLayer.setHighlightedNodes(spatialIndex.nodesIn(rect))
+            }
+            function highlight(index)
+            {
+                nodeLayer.setHighlighted(index, true)
+            }
+            function selectedNodes()
+            {
+                var indices = nodeLayer.highlightedNodes()
+                var nodes = []
+                for (var i = 0; i < indices.length; ++i) {
+                    nodes.push(nodeLayer.node(indices[i]))
+                }
+                return nodes
+            }
+            function nodeAt(point)
+            {
+                return spatialIndex.nodeAt(Qt.point(point.x + origin.x, point.y + origin.y), __nodeRadius)
+            }
+            function createEdgeUpdateFromNode()
+            {
+                var index = nodeAt(sceneAction.lastMousePressed)
+                if (index >= 0) {
+                    highlight(index)
+                    addEdgeAction.from = nodeLayer.node(index)
+                }
+            }
+            function createEdgeUpdateToNode()
+            {
+                var index = nodeAt(sceneAction.lastMouseReleased)
+                if (index >= 0) {
+                    highlight(index)
+                    addEdgeAction.to = nodeLayer.node(index)
+                }
+            }
+            function edgeAt(point)
+            {
+                var index = spatialIndex.edgeAt(Qt.point(point.x + origin.x, point.y + origin.y), 5)
+                return index < 0 ? null : edgeRepeater.itemAt(index).edge
+            }
             function clearSelection()
             {
                 selectionRect.from = Qt.point(0, 0)
                 selectionRect.to = Qt.point(0, 0)
-                updateSelection();
+                nodeLayer.setHighlightedNodes([])
             }
             function setEdgeFromNode()
             {
                 addEdgeAction.to = null
                 createEdgeUpdateFromNode();
             }
+            function deleteSelected()
+            {
+                // collect all selected nodes before deleting any of them, because deleting a
+                // node changes the indices of other nodes
+                var nodes = selectedNodes()
+                for (var i = 0; i < nodes.length; ++i) {
+                    deleteNode(nodes[i])
+                }
+            }
             function selectAll()
             {
                 selectionRect.from = Qt.point(0, 0)
                 selectionRect.to = Qt.point(width,height)
                 updateSelection();
             }
+            function startMoveSelected()
+            {
+                __movedNodes = selectedNodes()
+                __moveStartPositions = []
+                for (var i = 0; i < __movedNodes.length; ++i) {
+                    __moveStartPositions.push(Qt.point(__movedNodes[i].x, __movedNodes[i].y))
+                }
+            }
+            function moveSelected()
+            {
+                var deltaX = sceneAction.lastMousePosition.x - sceneAction.lastMousePressed.x
+                var deltaY = sceneAction.lastMousePosition.y - sceneAction.lastMousePressed.y
+                for (var i = 0; i < __movedNodes.length; ++i) {
+                    __movedNodes[i].x = __moveStartPositions[i].x + deltaX
+                    __movedNodes[i].y = __moveStartPositions[i].y + deltaY
+                }
+            }
+            function finishMoveSelected()
+            {
+                moveSelected()
+                __movedNodes = []
+                __moveStartPositions = []
+            }
+            function fitToNodes()
+            {
+                // enlarge scene such that all nodes keep a margin of 10 to its borders
+                var rect = nodeLayer.nodesRect
+                if (rect.width <= 0) {
+                    return
+                }
+                var left = rect.x - origin.x
+                var top = rect.y - origin.y
+                if (left < 10 || top < 10) {
+                    var deltaX = Math.max(10 - left, 0)
+                    var deltaY = Math.max(10 - top, 0)
+                    origin = Qt.point(origin.x - deltaX, origin.y - deltaY)
+                    width += deltaX
+                    height += deltaY
+                }
+                var right = rect.x + rect.width - origin.x
+                var bottom = rect.y + rect.height - origin.y
+                if (right + 10 > width) {
+                    width = right + 10
+                }
+                if (bottom + 10 > height) {
+                    height = bottom + 10
+                }
+            }
+            function updateNodeLabels()
+            {
+                // the visible part of the scene in global coordinates
+                var flickable = sceneScrollView.flickableItem
+                var rect = Qt.rect(flickable.contentX + origin.x, flickable.contentY + origin.y,
+                                   sceneScrollView.viewport.width, sceneScrollView.viewport.height)
+                var indices = spatialIndex.nodesIn(rect)
+                var labeled = nodeLabels.model
+                if (indices.length == labeled.length) {
+                    var i = 0
+                    while (i < indices.length && indices[i] == labeled[i]) {
+                        ++i
+                    }
+                    if (i == indices.length) { // existing labels follow their nodes
+                        return
+                    }
+                }
+                nodeLabels.model = indices
+            }
 
             MouseArea {
                 id: sceneAction
@@ -173,9 +293,40 @@ Item {
                         return
                     }
                 }
+                onDoubleClicked: {
+                    var index = scene.nodeAt(Qt.point(mouse.x, mouse.y))
+                    if (index >= 0) {
+                        showNodePropertiesDialog(nodeLayer.node(index))
+                        return
+                    }
+                    var edge = scene.edgeAt(Qt.point(mouse.x, mouse.y))
+                    if (edge) {
+                        showEdgePropertiesDialog(edge)
+                    }
+                }
                 onPressed: {
                     lastMousePressed = Qt.point(mouse.x, mouse.y)
                     lastMousePosition = Qt.point(mouse.x, mouse.y)
+                    var index = scene.nodeAt(lastMousePressed)
+                    if (deleteAction.checked) {
+                        if (index >= 0) {
+                            deleteNode(nodeLayer.node(index))
+                            return
+                        }
+                        var edge = scene.edgeAt(lastMousePressed)
+                        if (edge) {
+                            deleteEdge(edge)
+                        }
+                        return
+                    }
+                    // pressing a node moves all selected nodes, or only this one if it is not selected
+                    if (selectMoveAction.checked && index >= 0) {
+                        nodePressed = true
+                        if (!nodeLayer.isHighlighted(index)) {
+                            scene.clearSelection()
+                            scene.highlight(index)
+                        }
+                    }
                 }
                 onPositionChanged: {
                     lastMousePosition = Qt.point(mouse.x, mouse.y)
@@ -189,6 +340,11 @@ Item {
             SelectionRectangle {
                 id: selectionRect
                 visible: false
+                onChanged: {
+                    if (selectMoveAction.checked) {
+                        scene.updateSelection()
+                    }
+                }
             }
 
             Line {
@@ -200,7 +356,9 @@ Item {
                 toY: sceneAction.lastMousePosition.y
             }
 
+            // edges are picked by the scene's mouse area through the spatial index
             Repeater {
+                id: edgeRepeater
                 model: edgeModel
                 EdgeItem {
                     id: edgeItem
@@ -212,182 +370,48 @@ Item {
                         anchors.centerIn: parent
                         edge: model.dataRole
                     }
-
-                    MouseArea {
-                        anchors.fill: parent
-                        propagateComposedEvents: true
-                        onPressed: {
-                            if (deleteAction.checked) {
-                                deleteEdge(edge)
-                                mouse.accepted = true
-                            }
-                        }
-                        onDoubleClicked: {
-                            showEdgePropertiesDialog(edgeItem.edge);
-                        }
-                    }
                 }
             }
 
-            Repeater {
-                model: nodeModel
-                NodeItem {
-                    id: nodeItem
-                    node: model.dataRole
-                    origin: scene.origin
-                    highlighted: addEdgeAction.from == node || addEdgeAction.to == node
-                    property bool __modifyingPosition: false
-                    property variant __moveStartedPosition: Qt.point(0, 0)
-                    Connections {
-                        target: selectionRect
-                        onChanged: {
-                            if (selectMoveAction.checked && selectionRect.contains(x, y)) {
-                                highlighted = true
-                            } else {
-                                highlighted = false
-                            }
-                        }
-                    }
-                    Connections {
-                        target: scene
-                        onUpdateSelection: {
-                            if (selectionRect.contains(x, y)) {
-                                highlighted = true
-                            } else {
-                                highlighted = false
-                            }
-                        }
-                        onDeleteSelected: {
-                            if (highlighted) {
-                                deleteNode(node)
-                            }
-                        }
-                        onStartMoveSelected: {
-                            if (!highlighted) {
-                                return
-                            }
-                            __moveStartedPosition.x = node.x
-                            __moveStartedPosition.y = node.y
-                            node.x = Qt.binding(function() { return __moveStartedPosition.x + sceneAction.lastMousePosition.x - sceneAction.lastMousePressed.x })
-                            node.y = Qt.binding(function() { return __moveStartedPosition.y + sceneAction.lastMousePosition.y - sceneAction.lastMousePressed.y })
-                        }
-                        onFinishMoveSelected: {
-                            if (!highlighted) {
-                                return
-                            }
-                            node.x = __moveStartedPosition.x + sceneAction.lastMousePosition.x - sceneAction.lastMousePressed.x
-                            node.y = __moveStartedPosition.y + sceneAction.lastMousePosition.y - sceneAction.lastMousePressed.y
-                            __moveStartedPosition.x = 0
-                            __moveStartedPosition.y = 0
-                        }
-                        onCreateEdgeUpdateFromNode: {
-                            if (nodeItem.contains(Qt.point(sceneAction.lastMousePressed.x, sceneAction.lastMousePressed.y))) {
-                                node.highlighted = true
-                                addEdgeAction.from = node
-                            }
-                        }
-                        onCreateEdgeUpdateToNode: {
-                            if (nodeItem.contains(Qt.point(sceneAction.lastMouseReleased.x, sceneAction.lastMouseReleased.y))) {
-                                node.highlighted = true
-                                addEdgeAction.to = node
-                            }
-                        }
-                    }
-                    onXChanged: {
-                        if (scene.origin != nodeItem.origin
-                            || nodeItem.__modifyingPosition
-                        ) { // do nothing if item not initialized
-                            return;
-                        }
-                        if (x < 10) {
-                            nodeItem.__modifyingPosition = true;
-                            var delta = Math.max((10 - x), 10)
-                            scene.origin = Qt.point(scene.origin.x - delta, scene.origin.y);
-                            scene.width += delta;
-                            nodeItem.__modifyingPosition = false;
-                            return;
-                        }
-                        if (x + width + 10 > scene.width) {
-                            nodeItem.__modifyingPosition = true;
-                            var delta = Math.max(scene.width - (x + width) + 10, 10);
-                            scene.width += delta;
-                            nodeItem.__modifyingPosition = false;
-                            return;
-                        }
-                    }
-                    onYChanged: {
-                        if (scene.origin != nodeItem.origin
-                            || nodeItem.__modifyingPosition
-                        ) { // do nothing if item not initialized
-                            return;
-                        }
-                        if (y < 10) {
-                            nodeItem.__modifyingPosition = true;
-                            var delta = (10 - y)
-                            scene.origin = Qt.point(scene.origin.x, scene.origin.y - delta);
-                            scene.height += delta;
-                            nodeItem.__modifyingPosition = false;
-                            return;
-                        }
-                        if (y + height + 10 > scene.height) {
-                            nodeItem.__modifyingPosition = true;
-                            var delta = Math.max(scene.height - (y + height) + 10, 10);
-                            scene.height += delta;
-                            nodeItem.__modifyingPosition = false;
-                            return;
-                        }
-                    }
-                    NodePropertyItem {
-                        anchors.centerIn: parent
-                        node: model.dataRole
-                    }
+            // all nodes are drawn by a single item, mouse events are handled by sceneAction
+            NodeLayer {
+                id: nodeLayer
+                anchors.fill: parent
+                origin: scene.origin
+                onNodesRectChanged: scene.fitToNodes()
+            }
 
-                    Drag.active: dragArea.drag.active
-                    MouseArea {
-                        id: dragArea
-                        anchors.fill: parent
-                        propagateComposedEvents: true
-                        drag.target: { // only enable drag when move/select checked
-                            selectMoveAction.checked ? parent : undefined
-                        }
-                        Loader {
-                            id: nodeDialogLoader
-                        }
-                        onDoubleClicked: {
-                            showNodePropertiesDialog(nodeItem.node);
-                            mouse.accepted = true
-                        }
-                        onPressed: {
-                            // never handle undefined actions signals
-                            if (!(selectMoveAction.checked || deleteAction.checked)) {
-                                mouse.accepted = false
-                                return
-                            }
-                            if (deleteAction.checked) {
-                                deleteNode(nodeItem.node)
-                                mouse.accepted = true
-                                return
-                            }
-                            // single-node move action: directly handle it
-                            sceneAction.nodePressed = true
-                            if (selectMoveAction.checked && !nodeItem.highlighted) {
-                                scene.clearSelection()
-                                nodeItem.highlighted = true
-                                mouse.accepted = true
-                                return
-                            }
-                            // multi-node move action: gets handled by state-machine
-                            if (selectMoveAction.checked && nodeItem.highlighted) {
-                                mouse.accepted = false
-                                return
-                            }
-                        }
-                        onReleased: {
-                            sceneAction.nodePressed = false
-                        }
-                    }
+            // labels only exist for nodes in the visible part of the scene
+            Repeater {
+                id: nodeLabels
+                model: [] // document indices of the labeled nodes
+                NodePropertyItem {
+                    node: nodeLayer.node(modelData)
+                    // nodes moved by GraphDocument::setNodePositions() only change the revision
+                    x: node && nodeLayer.positionsRevision >= 0 ? node.x - scene.origin.x : 0
+                    y: node && nodeLayer.positionsRevision >= 0 ? node.y - scene.origin.y : 0
                 }
             }
+            Timer { // collects all changes until the event loop is reached
+                id: nodeLabelsUpdate
+                interval: 0
+                onTriggered: scene.updateNodeLabels()
+            }
+            Connections {
+                target: nodeLayer
+                onNodesChanged: nodeLabelsUpdate.restart()
+            }
+            Connections {
+                target: sceneScrollView.flickableItem
+                onContentXChanged: nodeLabelsUpdate.restart()
+                onContentYChanged: nodeLabelsUpdate.restart()
+            }
+            Connections {
+                target: sceneScrollView.viewport
+                onWidthChanged: nodeLabelsUpdate.restart()
+                onHeightChanged: nodeLabelsUpdate.restart()
+            }
+            onOriginChanged: nodeLabelsUpdate.restart()
         }
     }
 
@@ -469,6 +493,12 @@ Item {
         }
         DSM.State {
             id: smStateMoving
+            DSM.SignalTransition {
+                signal: sceneAction.onPositionChanged
+                onTriggered: {
+                    scene.moveSelected()
+                }
+            }
             DSM.SignalTransition {
                 targetState: smStateIdle
                 signal: sceneAction.onReleased
@@ -494,6 +524,7 @@ Item {
                 signal: sceneAction.onPressed
             }
             onExited: {
+                scene.clearSelection()
                 addEdgeAction.to = null
                 scene.createEdgeUpdateFromNode()
             }
@@ -80,6 +80,7 @@ void EdgeItem::setEdge(Edge *edge)
         d->m_edge->from().data()->disconnect(this);
         d->m_edge->to().data()->disconnect(this);
         d->m_edge->disconnect(this);
+        d->m_edge->from()->document().data()->disconnect(this);
     }
     d->m_edge = edge;
     d->m_visible = edge->type()->style()->isVisible();
@@ -87,6 +88,8 @@ void EdgeItem::setEdge(Edge *edge)
         this, &EdgeItem::updatePosition);
     connect(edge->to().data(), &Node::positionChanged,
         this, &EdgeItem::updatePosition);
+    connect(edge->from()->document().data(), &GraphDocument::nodePositionsChanged,
+        this, &EdgeItem::updatePosition);
     connect(edge, &Edge::typeChanged,
         this, [&](EdgeTypePtr) { update(); });
     connect(edge, &Edge::styleChanged,
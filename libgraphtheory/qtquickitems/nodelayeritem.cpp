@@ -0,0 +1,403 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nodelayeritem.h"
+#include "qsgcirclesnode.h"
+#include "graphdocument.h"
+#include "nodetype.h"
+#include "nodetypestyle.h"
+
+#include <QQmlEngine>
+#include <QSGTransformNode>
+
+using namespace GraphTheory;
+
+class GraphTheory::NodeLayerItemPrivate {
+public:
+    /** drawing state of the node at the same document index **/
+    struct Slot {
+        Slot()
+            : highlighted(false)
+            , dirty(false)
+        {
+        }
+        bool highlighted;
+        bool dirty; //!< true if contained in m_dirtyNodes
+    };
+
+    NodeLayerItemPrivate()
+        : m_origin(0, 0)
+        , m_nodeRadius(16)
+        , m_highlightColor(246, 116, 0, 125) // beware orange, half transparent
+        , m_rebuild(true)
+        , m_drawnCount(0)
+        , m_positionsRevision(0)
+    {
+    }
+
+    ~NodeLayerItemPrivate()
+    {
+    }
+
+    void markDirty(int index)
+    {
+        if (m_rebuild || m_slots.at(index).dirty) {
+            return;
+        }
+        // redrawing everything is cheaper than following many single changes
+        if (m_dirtyNodes.count() > m_slots.count() / 2) {
+            m_rebuild = true;
+            return;
+        }
+        m_slots[index].dirty = true;
+        m_dirtyNodes.append(index);
+    }
+
+    QRectF nodeRect(const QPointF &center) const
+    {
+        return QRectF(center.x() - m_nodeRadius, center.y() - m_nodeRadius, 2 * m_nodeRadius, 2 * m_nodeRadius);
+    }
+
+    /**
+     * Enlarge m_nodesRect to contain a node at @p center.
+     * @return true if the rectangle changed
+     */
+    bool unite(const QPointF &center)
+    {
+        const QRectF rect = nodeRect(center);
+        if (m_nodesRect.isNull()) {
+            m_nodesRect = rect;
+            return true;
+        }
+        if (m_nodesRect.contains(rect)) {
+            return false;
+        }
+        m_nodesRect = m_nodesRect.united(rect);
+        return true;
+    }
+
+    /**
+     * Compute m_nodesRect anew from all node positions.
+     * @return true if the rectangle changed
+     */
+    bool computeNodesRect()
+    {
+        const QRectF previous = m_nodesRect;
+        m_nodesRect = QRectF();
+        if (m_document) {
+            foreach (const QPointF &center, m_document->nodePositions()) {
+                unite(center);
+            }
+        }
+        return m_nodesRect != previous;
+    }
+
+    void drawNode(QSGCirclesNode *circles, int index, const NodePtr &node) const
+    {
+        if (!node->type()->style()->isVisible()) {
+            circles->clearCircle(index);
+            return;
+        }
+        circles->setCircle(index,
+            QPointF(node->x(), node->y()),
+            node->color(),
+            node->type()->style()->color(),
+            m_slots.at(index).highlighted ? m_highlightColor : QColor(Qt::transparent));
+    }
+
+    GraphDocumentPtr m_document;
+    QPointF m_origin;
+    const qreal m_nodeRadius;
+    const QColor m_highlightColor;
+    QRectF m_nodesRect;
+    QVector<Slot> m_slots;
+    QVector<int> m_dirtyNodes; //!< indices of nodes that must be drawn anew
+    bool m_rebuild; //!< if true, all nodes must be drawn anew
+    int m_drawnCount; //!< number of nodes drawn into the current geometry
+    int m_positionsRevision;
+};
+
+NodeLayerItem::NodeLayerItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , d(new NodeLayerItemPrivate)
+{
+    setFlag(QQuickItem::ItemHasContents, true);
+}
+
+NodeLayerItem::~NodeLayerItem()
+{
+
+}
+
+void NodeLayerItem::setDocument(GraphDocumentPtr document)
+{
+    if (d->m_document == document) {
+        return;
+    }
+    if (d->m_document) {
+        d->m_document.data()->disconnect(this);
+        foreach (const NodePtr &node, d->m_document->nodes()) {
+            node->disconnect(this);
+        }
+    }
+    d->m_document = document;
+    if (d->m_document) {
+        connect(d->m_document.data(), &GraphDocument::nodeAboutToBeAdded, this, &NodeLayerItem::onNodeAboutToBeAdded);
+        connect(d->m_document.data(), &GraphDocument::nodesAboutToBeRemoved, this, &NodeLayerItem::onNodesAboutToBeRemoved);
+        connect(d->m_document.data(), &GraphDocument::nodeMoved, this, &NodeLayerItem::onNodeMoved);
+        connect(d->m_document.data(), &GraphDocument::nodePositionsChanged, this, &NodeLayerItem::onNodePositionsChanged);
+        connect(d->m_document.data(), &GraphDocument::bulkUpdateFinished, this, &NodeLayerItem::reset);
+        connect(d->m_document.data(), &GraphDocument::aboutToBeDestroyed, this, [this]() {
+            // all nodes are removed next, which needs not to be followed
+            setDocument(GraphDocumentPtr());
+        });
+    }
+    reset();
+}
+
+QPointF NodeLayerItem::origin() const
+{
+    return d->m_origin;
+}
+
+void NodeLayerItem::setOrigin(const QPointF &origin)
+{
+    if (d->m_origin == origin) {
+        return;
+    }
+    d->m_origin = origin;
+    emit originChanged();
+    update();
+}
+
+QRectF NodeLayerItem::nodesRect() const
+{
+    return d->m_nodesRect;
+}
+
+int NodeLayerItem::positionsRevision() const
+{
+    return d->m_positionsRevision;
+}
+
+Node * NodeLayerItem::node(int index) const
+{
+    if (!d->m_document || index < 0 || index >= d->m_document->nodes().count()) {
+        return 0;
+    }
+    Node *node = d->m_document->nodes().at(index).data();
+    // nodes are owned by their document, never by the QML engine
+    QQmlEngine::setObjectOwnership(node, QQmlEngine::CppOwnership);
+    return node;
+}
+
+bool NodeLayerItem::isHighlighted(int index) const
+{
+    if (index < 0 || index >= d->m_slots.count()) {
+        return false;
+    }
+    return d->m_slots.at(index).highlighted;
+}
+
+void NodeLayerItem::setHighlighted(int index, bool highlighted)
+{
+    if (index < 0 || index >= d->m_slots.count() || d->m_slots.at(index).highlighted == highlighted) {
+        return;
+    }
+    d->m_slots[index].highlighted = highlighted;
+    d->markDirty(index);
+    update();
+}
+
+void NodeLayerItem::setHighlightedNodes(const QList<int> &indices)
+{
+    QVector<bool> highlighted(d->m_slots.count(), false);
+    foreach (int index, indices) {
+        if (index >= 0 && index < highlighted.count()) {
+            highlighted[index] = true;
+        }
+    }
+    // only nodes that change their highlighting are drawn anew
+    bool changed = false;
+    for (int i = 0; i < highlighted.count(); ++i) {
+        if (d->m_slots.at(i).highlighted != highlighted.at(i)) {
+            d->m_slots[i].highlighted = highlighted.at(i);
+            d->markDirty(i);
+            changed = true;
+        }
+    }
+    if (changed) {
+        update();
+    }
+}
+
+QList<int> NodeLayerItem::highlightedNodes() const
+{
+    QList<int> indices;
+    for (int i = 0; i < d->m_slots.count(); ++i) {
+        if (d->m_slots.at(i).highlighted) {
+            indices.append(i);
+        }
+    }
+    return indices;
+}
+
+QSGNode * NodeLayerItem::updatePaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *)
+{
+    // the transformation node maps global coordinates of the geometry into the item,
+    // such that changing the origin does not require to touch the geometry
+    QSGTransformNode *root = static_cast<QSGTransformNode *>(oldNode);
+    if (!root) {
+        root = new QSGTransformNode;
+        root->appendChildNode(new QSGCirclesNode);
+        d->m_rebuild = true;
+    }
+    QSGCirclesNode *circles = static_cast<QSGCirclesNode *>(root->firstChild());
+
+    QMatrix4x4 matrix;
+    matrix.translate(-d->m_origin.x(), -d->m_origin.y());
+    if (root->matrix() != matrix) {
+        root->setMatrix(matrix);
+    }
+
+    const NodeList nodes = d->m_document ? d->m_document->nodes() : NodeList();
+    const int count = nodes.count();
+    if (count != d->m_slots.count()) { // nodes changed during a bulk update that did not finish yet
+        d->m_slots.resize(count);
+        d->m_rebuild = true;
+    }
+
+    // the geometry provides space for additional nodes, such that adding a node only
+    // requires to draw this one
+    if (count > circles->count() || (circles->count() > 64 && 4 * count < circles->count())) {
+        circles->setCount(qMax(64, 2 * count));
+        d->m_drawnCount = 0;
+        d->m_rebuild = true;
+    }
+
+    if (d->m_rebuild) {
+        for (int i = 0; i < count; ++i) {
+            d->drawNode(circles, i, nodes.at(i));
+            d->m_slots[i].dirty = false;
+        }
+    } else {
+        foreach (int index, d->m_dirtyNodes) {
+            if (index < count) {
+                d->drawNode(circles, index, nodes.at(index));
+                d->m_slots[index].dirty = false;
+            }
+        }
+    }
+    for (int i = count; i < d->m_drawnCount; ++i) {
+        circles->clearCircle(i);
+    }
+    if (d->m_rebuild || !d->m_dirtyNodes.isEmpty() || d->m_drawnCount != count) {
+        circles->markCirclesDirty();
+    }
+    d->m_dirtyNodes.clear();
+    d->m_rebuild = false;
+    d->m_drawnCount = count;
+
+    return root;
+}
+
+void NodeLayerItem::reset()
+{
+    const int count = d->m_document ? d->m_document->nodes().count() : 0;
+    d->m_slots.fill(NodeLayerItemPrivate::Slot(), count);
+    d->m_dirtyNodes.clear();
+    d->m_rebuild = true;
+    if (d->m_document) {
+        foreach (const NodePtr &node, d->m_document->nodes()) {
+            connectNode(node.data());
+        }
+    }
+    if (d->computeNodesRect()) {
+        emit nodesRectChanged();
+    }
+    emit nodesChanged();
+    update();
+}
+
+void NodeLayerItem::connectNode(Node *node)
+{
+    connect(node, &Node::positionChanged, this, &NodeLayerItem::updateNode, Qt::UniqueConnection);
+    connect(node, &Node::colorChanged, this, &NodeLayerItem::updateNode, Qt::UniqueConnection);
+    connect(node, &Node::styleChanged, this, &NodeLayerItem::updateNode, Qt::UniqueConnection);
+    connect(node, &Node::typeChanged, this, &NodeLayerItem::updateNode, Qt::UniqueConnection);
+}
+
+void NodeLayerItem::updateNode()
+{
+    Node *node = qobject_cast<Node *>(sender());
+    // removed nodes are not followed anymore
+    if (!node || node->documentIndex() < 0 || node->documentIndex() >= d->m_slots.count()) {
+        return;
+    }
+    if (d->unite(QPointF(node->x(), node->y()))) {
+        emit nodesRectChanged();
+    }
+    d->markDirty(node->documentIndex());
+    emit nodesChanged();
+    update();
+}
+
+void NodeLayerItem::onNodeAboutToBeAdded(NodePtr node, int index)
+{
+    d->m_slots.insert(index, NodeLayerItemPrivate::Slot());
+    connectNode(node.data());
+    if (d->unite(QPointF(node->x(), node->y()))) {
+        emit nodesRectChanged();
+    }
+    d->markDirty(index);
+    emit nodesChanged();
+    update();
+}
+
+void NodeLayerItem::onNodesAboutToBeRemoved(int first, int last)
+{
+    // removing nodes other than the last ones shifts the indices of all following nodes
+    if (last != d->m_slots.count() - 1) {
+        d->m_rebuild = true;
+    }
+    d->m_slots.remove(first, last - first + 1);
+    emit nodesChanged();
+    update();
+}
+
+void NodeLayerItem::onNodeMoved(int from, int to)
+{
+    // the node at index from replaces the one at index to, which is removed next
+    d->m_slots[to].highlighted = d->m_slots.at(from).highlighted;
+    d->markDirty(to);
+    update();
+}
+
+void NodeLayerItem::onNodePositionsChanged()
+{
+    d->m_rebuild = true;
+    if (d->computeNodesRect()) {
+        emit nodesRectChanged();
+    }
+    ++d->m_positionsRevision;
+    emit nodePositionsChanged();
+    emit nodesChanged();
+    update();
+}
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NODELAYERITEM_H
+#define NODELAYERITEM_H
+
+#include "graphtheory_export.h"
+#include "typenames.h"
+#include "node.h"
+#include <QQuickItem>
+
+class QSGNode;
+
+namespace GraphTheory
+{
+class NodeLayerItemPrivate;
+
+/**
+ * \class NodeLayerItem
+ *
+ * Item that draws all nodes of a graph document with a single scene graph node. Changes of
+ * single nodes only update the geometry of these nodes.
+ *
+ * The item does not handle any mouse input; nodes are identified by their document index,
+ * as provided by the SpatialIndex for points and rectangles of the scene.
+ */
+class NodeLayerItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QPointF origin READ origin WRITE setOrigin NOTIFY originChanged)
+    Q_PROPERTY(QRectF nodesRect READ nodesRect NOTIFY nodesRectChanged)
+    Q_PROPERTY(int positionsRevision READ positionsRevision NOTIFY nodePositionsChanged)
+
+public:
+    explicit NodeLayerItem(QQuickItem *parent = 0);
+    virtual ~NodeLayerItem();
+    void setDocument(GraphDocumentPtr document);
+    /** translation of global origin (0,0) into scene coordinates **/
+    QPointF origin() const;
+    /** set translation of global origin (0,0) into scene coordinates **/
+    void setOrigin(const QPointF &origin);
+    /**
+     * @return bounding rectangle of all drawn nodes in global coordinates
+     *
+     * The rectangle is only enlarged by moving nodes and computed anew if the whole document
+     * changes.
+     */
+    QRectF nodesRect() const;
+    /**
+     * @return number of times all node positions changed at once
+     *
+     * Bindings to node positions must depend on this property, because positions changed by
+     * GraphDocument::setNodePositions() are not announced by the nodes.
+     */
+    int positionsRevision() const;
+    /** @return node at document index @p index or null if there is none **/
+    Q_INVOKABLE GraphTheory::Node * node(int index) const;
+    Q_INVOKABLE bool isHighlighted(int index) const;
+    Q_INVOKABLE void setHighlighted(int index, bool highlighted);
+    /** highlight exactly the nodes with the given document @p indices **/
+    Q_INVOKABLE void setHighlightedNodes(const QList<int> &indices);
+    /** @return document indices of all highlighted nodes in ascending order **/
+    Q_INVOKABLE QList<int> highlightedNodes() const;
+
+protected:
+    virtual QSGNode * updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) Q_DECL_OVERRIDE;
+
+Q_SIGNALS:
+    void originChanged();
+    void nodesRectChanged();
+    /**
+     * Emitted when positions of all nodes changed at once by GraphDocument::setNodePositions(),
+     * for which no signals of single nodes are emitted.
+     */
+    void nodePositionsChanged();
+    /**
+     * Emitted when nodes were added, removed or changed, e.g. moved. Thus the document indices
+     * of nodes within any area of the scene may have changed.
+     */
+    void nodesChanged();
+
+private Q_SLOTS:
+    void reset();
+    void updateNode();
+    void onNodeAboutToBeAdded(NodePtr node, int index);
+    void onNodesAboutToBeRemoved(int first, int last);
+    void onNodeMoved(int from, int to);
+    void onNodePositionsChanged();
+
+private:
+    void connectNode(Node *node);
+    Q_DISABLE_COPY(NodeLayerItem)
+    const QScopedPointer<NodeLayerItemPrivate> d;
+};
+}
+
+#endif
@@ -0,0 +1,243 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "qsgcirclesnode.h"
+#include <QSGGeometry>
+#include <QSGMaterialShader>
+#include <QOpenGLShaderProgram>
+#include <QColor>
+#include <cstring>
+
+using namespace GraphTheory;
+
+namespace
+{
+// half size of a circle quad, the highlight radius of 16 plus half a pixel for antialiasing
+const float quadRadius = 17;
+
+struct CircleVertex
+{
+    float x, y;             // vertex position in global coordinates
+    float dx, dy;           // offset of vertex from the circle center
+    unsigned char fill[4];
+    unsigned char border[4];
+    unsigned char highlight[4];
+
+    void set(const QPointF &center, float offsetX, float offsetY,
+             const QColor &fillColor, const QColor &borderColor, const QColor &highlightColor)
+    {
+        x = center.x() + offsetX;
+        y = center.y() + offsetY;
+        dx = offsetX;
+        dy = offsetY;
+        setColor(fill, fillColor);
+        setColor(border, borderColor);
+        setColor(highlight, highlightColor);
+    }
+
+    static void setColor(unsigned char *target, const QColor &color)
+    {
+        target[0] = color.red();
+        target[1] = color.green();
+        target[2] = color.blue();
+        target[3] = color.alpha();
+    }
+};
+
+const QSGGeometry::AttributeSet & circleAttributes()
+{
+    static QSGGeometry::Attribute data[] = {
+        QSGGeometry::Attribute::create(0, 2, GL_FLOAT, true),
+        QSGGeometry::Attribute::create(1, 2, GL_FLOAT),
+        QSGGeometry::Attribute::create(2, 4, GL_UNSIGNED_BYTE),
+        QSGGeometry::Attribute::create(3, 4, GL_UNSIGNED_BYTE),
+        QSGGeometry::Attribute::create(4, 4, GL_UNSIGNED_BYTE)
+    };
+    static QSGGeometry::AttributeSet attributes = { 5, sizeof(CircleVertex), data };
+    return attributes;
+}
+
+class QSGCircleShader : public QSGMaterialShader
+{
+public:
+    QSGCircleShader()
+        : m_matrixId(-1)
+        , m_opacityId(-1)
+    {
+    }
+
+    const char * vertexShader() const Q_DECL_OVERRIDE
+    {
+        return
+            "uniform highp mat4 matrix;                                         \n"
+            "attribute highp vec4 vertexCoord;                                  \n"
+            "attribute highp vec2 offset;                                       \n"
+            "attribute lowp vec4 fillColor;                                     \n"
+            "attribute lowp vec4 borderColor;                                   \n"
+            "attribute lowp vec4 highlightColor;                                \n"
+            "varying highp vec2 vOffset;                                        \n"
+            "varying lowp vec4 vFill;                                           \n"
+            "varying lowp vec4 vBorder;                                         \n"
+            "varying lowp vec4 vHighlight;                                      \n"
+            "void main() {                                                      \n"
+            "    vOffset = offset;                                              \n"
+            "    vFill = fillColor;                                             \n"
+            "    vBorder = borderColor;                                         \n"
+            "    vHighlight = highlightColor;                                   \n"
+            "    gl_Position = matrix * vertexCoord;                            \n"
+            "}";
+    }
+
+    const char * fragmentShader() const Q_DECL_OVERRIDE
+    {
+        // node shape: a highlight disk of radius 16, a node disk of
+        // radius 12 and a border of width 2 on its boundary, each antialiased over one pixel
+        return
+            "uniform lowp float opacity;                                        \n"
+            "varying highp vec2 vOffset;                                        \n"
+            "varying lowp vec4 vFill;                                           \n"
+            "varying lowp vec4 vBorder;                                         \n"
+            "varying lowp vec4 vHighlight;                                      \n"
+            "lowp vec4 over(lowp vec4 color, lowp float coverage, lowp vec4 below) {\n"
+            "    lowp float alpha = color.a * coverage;                         \n"
+            "    return vec4(color.rgb * alpha, alpha) + below * (1.0 - alpha); \n"
+            "}                                                                  \n"
+            "void main() {                                                      \n"
+            "    highp float d = length(vOffset);                               \n"
+            "    lowp vec4 color = over(vHighlight, clamp(16.5 - d, 0.0, 1.0), vec4(0.0));\n"
+            "    color = over(vFill, clamp(12.5 - d, 0.0, 1.0), color);         \n"
+            "    color = over(vBorder, clamp(13.5 - d, 0.0, 1.0) - clamp(11.5 - d, 0.0, 1.0), color);\n"
+            "    gl_FragColor = color * opacity;                                \n"
+            "}";
+    }
+
+    char const * const * attributeNames() const Q_DECL_OVERRIDE
+    {
+        static char const * const names[] = {
+            "vertexCoord", "offset", "fillColor", "borderColor", "highlightColor", 0
+        };
+        return names;
+    }
+
+    void updateState(const RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) Q_DECL_OVERRIDE
+    {
+        Q_UNUSED(newMaterial);
+        Q_UNUSED(oldMaterial);
+        if (state.isMatrixDirty()) {
+            program()->setUniformValue(m_matrixId, state.combinedMatrix());
+        }
+        if (state.isOpacityDirty()) {
+            program()->setUniformValue(m_opacityId, state.opacity());
+        }
+    }
+
+protected:
+    void initialize() Q_DECL_OVERRIDE
+    {
+        m_matrixId = program()->uniformLocation("matrix");
+        m_opacityId = program()->uniformLocation("opacity");
+    }
+
+private:
+    int m_matrixId;
+    int m_opacityId;
+};
+}
+
+QSGCircleMaterial::QSGCircleMaterial()
+{
+    // the geometry is large and uses 32 bit indices, hence it must not be merged into batches
+    setFlag(QSGMaterial::Blending | QSGMaterial::RequiresFullMatrix);
+}
+
+QSGMaterialType * QSGCircleMaterial::type() const
+{
+    static QSGMaterialType type;
+    return &type;
+}
+
+QSGMaterialShader * QSGCircleMaterial::createShader() const
+{
+    return new QSGCircleShader;
+}
+
+QSGCirclesNode::QSGCirclesNode()
+    : m_geometry(circleAttributes(), 0, 0, GL_UNSIGNED_INT)
+{
+    setMaterial(&m_material);
+
+    setGeometry(&m_geometry);
+    m_geometry.setDrawingMode(GL_TRIANGLES);
+    m_geometry.setVertexDataPattern(QSGGeometry::DynamicPattern);
+    m_geometry.setIndexDataPattern(QSGGeometry::StaticPattern);
+}
+
+QSGCirclesNode::~QSGCirclesNode()
+{
+
+}
+
+int QSGCirclesNode::count() const
+{
+    return m_geometry.vertexCount() / 4;
+}
+
+void QSGCirclesNode::setCount(int count)
+{
+    m_geometry.allocate(4 * count, 6 * count);
+    std::memset(m_geometry.vertexData(), 0, 4 * count * sizeof(CircleVertex));
+
+    // two triangles per quad, vertices are ordered top-left, top-right, bottom-left, bottom-right
+    quint32 *indices = m_geometry.indexDataAsUInt();
+    for (int i = 0; i < count; ++i) {
+        const quint32 first = 4 * i;
+        indices[6 * i] = first;
+        indices[6 * i + 1] = first + 1;
+        indices[6 * i + 2] = first + 2;
+        indices[6 * i + 3] = first + 2;
+        indices[6 * i + 4] = first + 1;
+        indices[6 * i + 5] = first + 3;
+    }
+    m_geometry.markIndexDataDirty();
+    markCirclesDirty();
+}
+
+void QSGCirclesNode::setCircle(int index, const QPointF &center, const QColor &fill, const QColor &border, const QColor &highlight)
+{
+    Q_ASSERT(index >= 0 && index < count());
+    CircleVertex *vertices = static_cast<CircleVertex *>(m_geometry.vertexData()) + 4 * index;
+    vertices[0].set(center, -quadRadius, -quadRadius, fill, border, highlight);
+    vertices[1].set(center, quadRadius, -quadRadius, fill, border, highlight);
+    vertices[2].set(center, -quadRadius, quadRadius, fill, border, highlight);
+    vertices[3].set(center, quadRadius, quadRadius, fill, border, highlight);
+}
+
+void QSGCirclesNode::clearCircle(int index)
+{
+    Q_ASSERT(index >= 0 && index < count());
+    CircleVertex *vertices = static_cast<CircleVertex *>(m_geometry.vertexData()) + 4 * index;
+    std::memset(vertices, 0, 4 * sizeof(CircleVertex));
+}
+
+void QSGCirclesNode::markCirclesDirty()
+{
+    m_geometry.markVertexDataDirty();
+    markDirty(QSGNode::DirtyGeometry);
+}
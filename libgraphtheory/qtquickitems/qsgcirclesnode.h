@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QSGCIRCLESNODE_H
+#define QSGCIRCLESNODE_H
+
+#include "graphtheory_export.h"
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+
+class QColor;
+
+namespace GraphTheory
+{
+
+/**
+ * Material that draws every quad of a QSGCirclesNode as antialiased circle, which is computed
+ * in the fragment shader from the distance to the quad center.
+ */
+class QSGCircleMaterial : public QSGMaterial
+{
+public:
+    QSGCircleMaterial();
+    QSGMaterialType * type() const Q_DECL_OVERRIDE;
+    QSGMaterialShader * createShader() const Q_DECL_OVERRIDE;
+};
+
+/**
+ * Geometry node that draws an arbitrary number of node circles with one draw call. Every circle
+ * is a quad with its own center, fill color, border color, and highlight color.
+ *
+ * Circles are changed in place; call markCirclesDirty() once after changing any of them.
+ */
+class QSGCirclesNode : public QSGGeometryNode
+{
+
+public:
+    explicit QSGCirclesNode();
+    virtual ~QSGCirclesNode();
+    /** @return number of circles the geometry provides **/
+    int count() const;
+    /** resize geometry to @p count circles, all of them cleared **/
+    void setCount(int count);
+    void setCircle(int index, const QPointF &center, const QColor &fill, const QColor &border, const QColor &highlight);
+    /** remove circle at @p index from drawing by collapsing its quad **/
+    void clearCircle(int index);
+    void markCirclesDirty();
+
+private:
+    QSGGeometry m_geometry;
+    QSGCircleMaterial m_material;
+};
+}
+
+#endif
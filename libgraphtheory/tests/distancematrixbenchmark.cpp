@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "libgraphtheory/algorithms/graphalgorithms.h"
+#include "libgraphtheory/graphdocument.h"
+#include "libgraphtheory/graphsnapshot.h"
+#include "libgraphtheory/edgetype.h"
+#include "libgraphtheory/node.h"
+#include "libgraphtheory/edge.h"
+
+#include <QObject>
+#include <QTest>
+
+using namespace GraphTheory;
+
+/**
+ * Benchmark of all pairs shortest path computation for growing graphs. Sparse graphs are
+ * processed by Johnson's algorithm, dense graphs by the blocked Floyd-Warshall algorithm.
+ */
+class DistanceMatrixBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void distanceMatrix_data()
+    {
+        QTest::addColumn<int>("nodes");
+        QTest::addColumn<int>("edgesPerNode");
+        QTest::newRow("sparse n=1000") << 1000 << 4;
+        QTest::newRow("sparse n=2000") << 2000 << 4;
+        QTest::newRow("sparse n=4000") << 4000 << 4;
+        QTest::newRow("dense n=1000") << 1000 << 100;
+        QTest::newRow("dense n=2000") << 2000 << 200;
+        QTest::newRow("dense n=4000") << 4000 << 400;
+    }
+
+    void distanceMatrix()
+    {
+        QFETCH(int, nodes);
+        QFETCH(int, edgesPerNode);
+
+        qsrand(1);
+        GraphDocumentPtr document = GraphDocument::create();
+        document->edgeTypes().first()->setDirection(EdgeType::Unidirectional);
+        document->edgeTypes().first()->addDynamicProperty("length");
+        for (int i = 0; i < nodes; ++i) {
+            Node::create(document);
+        }
+        const NodeList nodeList = document->nodes();
+        for (int i = 0; i < nodes * edgesPerNode; ++i) {
+            Edge::create(nodeList.at(qrand() % nodes), nodeList.at(qrand() % nodes))
+                ->setDynamicProperty("length", qrand() % 100 + 1);
+        }
+        GraphSnapshotPtr graph = document->snapshot(EdgeTypePtr(), "length");
+
+        QVector<qreal> matrix;
+        QBENCHMARK {
+            matrix = GraphAlgorithms::distanceMatrix(graph);
+        }
+        QCOMPARE(matrix.count(), nodes * nodes);
+
+        document->destroy();
+    }
+};
+
+QTEST_MAIN(DistanceMatrixBenchmark)
+
+#include "distancematrixbenchmark.moc"
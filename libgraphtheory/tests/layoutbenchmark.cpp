@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) version 3, or any
+ *  later version accepted by the membership of KDE e.V. (or its
+ *  successor approved by the membership of KDE e.V.), which shall
+ *  act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "libgraphtheory/modifiers/forcedirectedlayout.h"
+#include "libgraphtheory/modifiers/multilevellayout.h"
+#include "libgraphtheory/modifiers/layeredlayout.h"
+
+#include <QDebug>
+#include <QObject>
+#include <QQueue>
+#include <QTest>
+#include <QtMath>
+
+using namespace GraphTheory;
+
+typedef QPair<int, int> IndexPair;
+
+namespace
+{
+/**
+ * Sampled stress of a layout: for a few pivot nodes, compare the Euclidean distances to all other
+ * nodes with their graph theoretic distances. The layout is scaled optimally beforehand, such that
+ * the result does not depend on the layout size; 0 means that all distances are reproduced.
+ */
+qreal sampledStress(const QVector<QPointF> &positions, const QVector<IndexPair> &edges, int pivots)
+{
+    const int n = positions.count();
+    QVector<int> offsets(n + 1, 0);
+    foreach (const IndexPair &edge, edges) {
+        ++offsets[edge.first + 1];
+        ++offsets[edge.second + 1];
+    }
+    for (int i = 0; i < n; ++i) {
+        offsets[i + 1] += offsets.at(i);
+    }
+    QVector<int> neighbors(offsets.at(n));
+    QVector<int> fill = offsets;
+    foreach (const IndexPair &edge, edges) {
+        neighbors[fill[edge.first]++] = edge.second;
+        neighbors[fill[edge.second]++] = edge.first;
+    }
+
+    // the stress sum of (scale * euclidean - distance)^2 / distance^2 is minimal for
+    // scale = s1 / s2 with s1 = sum of euclidean / distance and s2 = sum of (euclidean / distance)^2
+    qreal s1 = 0;
+    qreal s2 = 0;
+    qint64 pairs = 0;
+    for (int pivot = 0; pivot < pivots; ++pivot) {
+        const int source = qint64(pivot) * n / pivots;
+        QVector<int> distance(n, -1);
+        QQueue<int> queue;
+        distance[source] = 0;
+        queue.enqueue(source);
+        while (!queue.isEmpty()) {
+            const int node = queue.dequeue();
+            for (int arc = offsets.at(node); arc < offsets.at(node + 1); ++arc) {
+                if (distance.at(neighbors.at(arc)) < 0) {
+                    distance[neighbors.at(arc)] = distance.at(node) + 1;
+                    queue.enqueue(neighbors.at(arc));
+                }
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            if (distance.at(i) > 0) {
+                const QPointF delta = positions.at(i) - positions.at(source);
+                const qreal ratio = qSqrt(delta.x() * delta.x() + delta.y() * delta.y()) / distance.at(i);
+                s1 += ratio;
+                s2 += ratio * ratio;
+                ++pairs;
+            }
+        }
+    }
+    if (pairs == 0 || s2 <= 0) {
+        return 0;
+    }
+    return (pairs - s1 * s1 / s2) / pairs;
+}
+}
+
+/**
+ * Benchmark of force directed and layered layouts for growing graphs. Square grids have a known ideal layout,
+ * sparse graphs resemble imported dependency networks: a random tree with additional random edges.
+ * Besides the wall time, the sampled stress of the resulting layout is reported.
+ */
+class LayoutBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void layout_data()
+    {
+        QTest::addColumn<int>("nodes");
+        QTest::addColumn<bool>("grid");
+        QTest::addColumn<bool>("multilevel");
+        QTest::newRow("grid n=10k single level") << 10000 << true << false;
+        QTest::newRow("grid n=10k") << 10000 << true << true;
+        QTest::newRow("grid n=100k") << 100000 << true << true;
+        QTest::newRow("grid n=1M") << 1000000 << true << true;
+        QTest::newRow("sparse n=10k single level") << 10000 << false << false;
+        QTest::newRow("sparse n=10k") << 10000 << false << true;
+        QTest::newRow("sparse n=100k") << 100000 << false << true;
+        QTest::newRow("sparse n=1M") << 1000000 << false << true;
+    }
+
+    void layout()
+    {
+        QFETCH(int, nodes);
+        QFETCH(bool, grid);
+        QFETCH(bool, multilevel);
+
+        qsrand(1);
+        QVector<IndexPair> edges;
+        if (grid) {
+            const int width = qSqrt(nodes);
+            nodes = width * width;
+            for (int i = 0; i < nodes; ++i) {
+                if (i % width + 1 < width) {
+                    edges.append(qMakePair(i, i + 1));
+                }
+                if (i + width < nodes) {
+                    edges.append(qMakePair(i, i + width));
+                }
+            }
+        } else {
+            for (int i = 1; i < nodes; ++i) {
+                edges.append(qMakePair(i, qrand() % i));
+            }
+            for (int i = 0; i < nodes / 4; ++i) {
+                edges.append(qMakePair(qrand() % nodes, qrand() % nodes));
+            }
+        }
+        QVector<QPointF> start(nodes);
+        for (int i = 0; i < nodes; ++i) {
+            start[i] = QPointF(qrand() % 10000, qrand() % 10000);
+        }
+
+        QVector<QPointF> positions;
+        QBENCHMARK {
+            positions = start;
+            if (multilevel) {
+                MultilevelLayout().apply(positions, edges);
+            } else {
+                ForceDirectedLayout().apply(positions, edges);
+            }
+        }
+        QCOMPARE(positions.count(), nodes);
+        qDebug() << "sampled stress:" << sampledStress(positions, edges, 20);
+    }
+
+    void layered_data()
+    {
+        QTest::addColumn<int>("nodes");
+        QTest::newRow("dag n=1k") << 1000;
+        QTest::newRow("dag n=20k") << 20000;
+        QTest::newRow("dag n=100k") << 100000;
+    }
+
+    /**
+     * Layered layout of random DAGs, where each node has one or two random predecessors.
+     */
+    void layered()
+    {
+        QFETCH(int, nodes);
+
+        qsrand(1);
+        QVector<IndexPair> edges;
+        for (int i = 1; i < nodes; ++i) {
+            edges.append(qMakePair(qrand() % i, i));
+            if (qrand() % 2 == 0) {
+                edges.append(qMakePair(qrand() % i, i));
+            }
+        }
+
+        QVector<QPointF> positions;
+        int layers = 0;
+        QBENCHMARK {
+            positions = QVector<QPointF>(nodes);
+            layers = LayeredLayout().apply(positions, edges);
+        }
+        QCOMPARE(positions.count(), nodes);
+        qDebug() << "layers:" << layers;
+    }
+};
+
+QTEST_MAIN(LayoutBenchmark)
+
+#include "layoutbenchmark.moc"
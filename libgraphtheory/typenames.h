@@ -30,6 +30,7 @@ class NodeType;
 class EdgeType;
 class Node;
 class Edge;
+class GraphSnapshot;
 
 typedef QSharedPointer<GraphDocument> GraphDocumentPtr;
 typedef QSharedPointer<NodeType> NodeTypePtr;
@@ -38,6 +39,7 @@ typedef QSharedPointer<Node> NodePtr;
 typedef QVector< QSharedPointer<Node> > NodeList;
 typedef QSharedPointer<Edge> EdgePtr;
 typedef QVector< QSharedPointer<Edge> > EdgeList;
+typedef QSharedPointer<GraphSnapshot> GraphSnapshotPtr;
 }
 
 #endif
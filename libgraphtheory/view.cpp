@@ -22,13 +22,13 @@
 #include "edgetype.h"
 #include "nodetype.h"
 #include "edge.h"
-#include "models/nodemodel.h"
 #include "models/edgemodel.h"
 #include "models/nodepropertymodel.h"
 #include "models/edgepropertymodel.h"
 #include "models/nodetypemodel.h"
 #include "models/edgetypemodel.h"
-#include "qtquickitems/nodeitem.h"
+#include "models/spatialindex.h"
+#include "qtquickitems/nodelayeritem.h"
 #include "qtquickitems/edgeitem.h"
 #include "dialogs/nodeproperties.h"
 #include "dialogs/edgeproperties.h"
@@ -50,25 +50,26 @@ class GraphTheory::ViewPrivate {
 public:
     ViewPrivate()
         : m_edgeModel(new EdgeModel())
-        , m_nodeModel(new NodeModel())
         , m_edgeTypeModel(new EdgeTypeModel())
         , m_nodeTypeModel(new NodeTypeModel)
+        , m_spatialIndex(new SpatialIndex)
     {
     }
 
     ~ViewPrivate()
     {
         delete m_edgeModel;
-        delete m_nodeModel;
         delete m_edgeTypeModel;
         delete m_nodeTypeModel;
+        delete m_spatialIndex;
     }
 
     GraphDocumentPtr m_document;
     EdgeModel *m_edgeModel;
-    NodeModel *m_nodeModel;
     EdgeTypeModel *m_edgeTypeModel;
     NodeTypeModel *m_nodeTypeModel;
+    SpatialIndex *m_spatialIndex;
+    QPointer<NodeLayerItem> m_nodeLayer;
 };
 
 
@@ -91,9 +92,8 @@ View::View(QWidget *parent)
     qmlRegisterType<GraphTheory::Edge>("org.kde.rocs.graphtheory", 1, 0, "Edge");
     qmlRegisterType<GraphTheory::NodeType>("org.kde.rocs.graphtheory", 1, 0, "NodeType");
     qmlRegisterType<GraphTheory::EdgeType>("org.kde.rocs.graphtheory", 1, 0, "EdgeType");
-    qmlRegisterType<GraphTheory::NodeItem>("org.kde.rocs.graphtheory", 1, 0, "NodeItem");
     qmlRegisterType<GraphTheory::EdgeItem>("org.kde.rocs.graphtheory", 1, 0, "EdgeItem");
-    qmlRegisterType<GraphTheory::NodeModel>("org.kde.rocs.graphtheory", 1, 0, "NodeModel");
+    qmlRegisterType<GraphTheory::NodeLayerItem>("org.kde.rocs.graphtheory", 1, 0, "NodeLayer");
     qmlRegisterType<GraphTheory::EdgeModel>("org.kde.rocs.graphtheory", 1, 0, "EdgeModel");
     qmlRegisterType<GraphTheory::NodePropertyModel>("org.kde.rocs.graphtheory", 1, 0, "NodePropertyModel");
     qmlRegisterType<GraphTheory::EdgePropertyModel>("org.kde.rocs.graphtheory", 1, 0, "EdgePropertyModel");
@@ -109,13 +109,14 @@ View::View(QWidget *parent)
     }
 
     // register editor elements at context
-    engine()->rootContext()->setContextProperty("nodeModel", d->m_nodeModel);
     engine()->rootContext()->setContextProperty("edgeModel", d->m_edgeModel);
     engine()->rootContext()->setContextProperty("nodeTypeModel", d->m_nodeTypeModel);
     engine()->rootContext()->setContextProperty("edgeTypeModel", d->m_edgeTypeModel);
+    engine()->rootContext()->setContextProperty("spatialIndex", d->m_spatialIndex);
 
     // create rootObject after context is set up
     QObject *topLevel = component->create();
+    d->m_nodeLayer = topLevel->findChild<NodeLayerItem*>();
 
     // connections to QML signals
     connect(topLevel, SIGNAL(createNode(qreal,qreal,int)),
@@ -143,10 +144,13 @@ View::~View()
 void View::setGraphDocument(GraphDocumentPtr document)
 {
     d->m_document = document;
-    d->m_nodeModel->setDocument(d->m_document);
     d->m_edgeModel->setDocument(d->m_document);
     d->m_nodeTypeModel->setDocument(d->m_document);
     d->m_edgeTypeModel->setDocument(d->m_document);
+    d->m_spatialIndex->setDocument(d->m_document);
+    if (d->m_nodeLayer) {
+        d->m_nodeLayer->setDocument(d->m_document);
+    }
 }
 
 GraphDocumentPtr View::graphDocument() const
@@ -171,4 +171,23 @@ void TestProject::loadBrokenFilesWithoutCrashing01()
     QCOMPARE(project.graphDocuments().count(), 0);
 }
 
+void TestProject::importDottedFileName()
+{
+    GraphTheory::Editor *graphEditor = new GraphTheory::Editor;
+
+    QTemporaryFile graphFile;
+    graphFile.setFileTemplate("XXXXXXX.v2.tgf");
+    QVERIFY(graphFile.open());
+    graphFile.write("1 a\n2 b\n#\n1 2\n");
+    graphFile.close();
+
+    GraphTheory::GraphDocumentPtr graphDoc = graphEditor->openDocument(QUrl::fromLocalFile(graphFile.fileName()));
+    QVERIFY(graphDoc);
+    QCOMPARE(graphDoc->nodes().count(), 2);
+    QCOMPARE(graphDoc->edges().count(), 1);
+
+    graphDoc->destroy();
+    graphEditor->deleteLater();
+}
+
 QTEST_MAIN(TestProject)
@@ -34,6 +34,8 @@ private Q_SLOTS:
     void loadSaveMultipleScriptDocuments();
     /** no graph document exists in project **/
     void loadBrokenFilesWithoutCrashing01();
+    /** graph file names with more than one dot are loaded by their last extension **/
+    void importDottedFileName();
 };
 
 #endif
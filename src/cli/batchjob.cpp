@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 2 of
+ *  the License or (at your option) version 3 or any later version
+ *  accepted by the membership of KDE e.V. (or its successor approved
+ *  by the membership of KDE e.V.), which shall act as a proxy
+ *  defined in Section 14 of version 3 of the license.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "batchjob.h"
+#include "libgraphtheory/editor.h"
+#include "libgraphtheory/graphdocument.h"
+#include "libgraphtheory/kernel/kernel.h"
+#include "libgraphtheory/fileformats/fileformatinterface.h"
+#include <KLocalizedString>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QThreadStorage>
+#include <QUrl>
+#include <cstdio>
+
+using namespace GraphTheory;
+
+namespace
+{
+/**
+ * Editor that is created once per pool thread and whose file format backends are shared by all
+ * jobs of this thread, for import as well as for export.
+ */
+struct ThreadContext
+{
+    Editor editor;
+};
+
+QThreadStorage<ThreadContext *> threadContexts;
+QMutex outputMutex;
+
+ThreadContext * threadContext()
+{
+    if (!threadContexts.hasLocalData()) {
+        threadContexts.setLocalData(new ThreadContext);
+    }
+    return threadContexts.localData();
+}
+
+QString plainText(const QString &message)
+{
+    // kernel messages are formatted for the script output widget
+    return QString(message).remove(QRegularExpression(QStringLiteral("<[^>]*>")));
+}
+}
+
+BatchJob::BatchJob(const QString &file, const Options &options, QAtomicInt *failures)
+    : QRunnable()
+    , m_file(file)
+    , m_options(options)
+    , m_failures(failures)
+{
+}
+
+void BatchJob::run()
+{
+    QStringList output;
+    QStringList errors;
+    if (!process(output, errors)) {
+        m_failures->ref();
+    }
+
+    // print all messages of a job at once, such that output of parallel jobs is not interleaved
+    QMutexLocker locker(&outputMutex);
+    QTextStream out(stdout);
+    foreach (const QString &line, output) {
+        out << m_file << ": " << line << endl;
+    }
+    QTextStream err(stderr);
+    foreach (const QString &line, errors) {
+        err << m_file << ": " << line << endl;
+    }
+}
+
+QString BatchJob::outputPath(const QString &file, const Options &options)
+{
+    return QDir::cleanPath(options.outputDirectory.absoluteFilePath(QFileInfo(file).completeBaseName() + '.' + options.format));
+}
+
+bool BatchJob::process(QStringList &output, QStringList &errors)
+{
+    ThreadContext *context = threadContext();
+    const QFileInfo fileInfo(m_file);
+    GraphDocumentPtr document = context->editor.openDocument(QUrl::fromLocalFile(fileInfo.absoluteFilePath()));
+    if (!document) {
+        errors << i18nc("@info:shell", "Could not load graph file.");
+        return false;
+    }
+
+    bool success = true;
+    if (!m_options.script.isEmpty()) {
+        // the kernel executes synchronously in this thread, hence its messages are delivered directly
+        Kernel kernel;
+        kernel.setProfilingEnabled(m_options.profile);
+        QObject::connect(&kernel, &Kernel::message, [&](const QString &message, Kernel::MessageType type) {
+            switch (type) {
+            case Kernel::InfoMessage:
+                output << plainText(message);
+                break;
+            case Kernel::WarningMessage:
+                errors << plainText(message);
+                break;
+            case Kernel::ErrorMessage:
+                errors << plainText(message);
+                success = false;
+                break;
+            }
+        });
+        kernel.execute(document, m_options.script);
+    }
+
+    if (success && !m_options.format.isEmpty()) {
+        FileFormatInterface *exporter = context->editor.fileFormatBackend(m_options.format);
+        const QString path = outputPath(m_file, m_options);
+        exporter->setFile(QUrl::fromLocalFile(path));
+        exporter->writeFile(document);
+        if (exporter->hasError()) {
+            errors << i18nc("@info:shell", "Could not write file %1: %2", path, exporter->errorString());
+            success = false;
+        } else {
+            output << i18nc("@info:shell", "Written to %1", path);
+        }
+    }
+
+    document->destroy();
+    return success;
+}
@@ -0,0 +1,71 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 2 of
+ *  the License or (at your option) version 3 or any later version
+ *  accepted by the membership of KDE e.V. (or its successor approved
+ *  by the membership of KDE e.V.), which shall act as a proxy
+ *  defined in Section 14 of version 3 of the license.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BATCHJOB_H
+#define BATCHJOB_H
+
+#include <QAtomicInt>
+#include <QDir>
+#include <QRunnable>
+#include <QString>
+#include <QStringList>
+
+/**
+ * \class BatchJob
+ *
+ * Processes a single graph file in a thread of a QThreadPool: the file is loaded with the
+ * import backend matching its extension, the script (if any) is executed on the loaded
+ * document and the result is written with the export backend for the requested format.
+ *
+ * No View or QML engine is created. File format backends are loaded once per pool thread,
+ * while each job uses a fresh script engine such that scripts cannot influence each other.
+ * All output of a job is collected and printed at once after the job finished.
+ */
+class BatchJob : public QRunnable
+{
+public:
+    struct Options {
+        QString script;         //!< script code that is executed, may be empty
+        QString format;         //!< extension of the export format, empty if nothing is written
+        QDir outputDirectory;   //!< directory for exported files
+        bool profile;           //!< if true, the script execution is profiled
+    };
+
+    /**
+     * Create job for graph file @p file. If the job fails, @p failures is incremented.
+     */
+    BatchJob(const QString &file, const Options &options, QAtomicInt *failures);
+    void run() Q_DECL_OVERRIDE;
+
+    /**
+     * @return absolute path of the file that is exported for graph file @p file, which keeps all
+     * parts of the file name but the last extension
+     */
+    static QString outputPath(const QString &file, const Options &options);
+
+private:
+    bool process(QStringList &output, QStringList &errors);
+
+    const QString m_file;
+    const Options m_options;
+    QAtomicInt * const m_failures;
+};
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2026  agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 2 of
+ *  the License or (at your option) version 3 or any later version
+ *  accepted by the membership of KDE e.V. (or its successor approved
+ *  by the membership of KDE e.V.), which shall act as a proxy
+ *  defined in Section 14 of version 3 of the license.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "batchjob.h"
+#include "rocsversion.h"
+#include "libgraphtheory/fileformats/fileformatinterface.h"
+#include "libgraphtheory/fileformats/fileformatmanager.h"
+#include <KAboutData>
+#include <KLocalizedString>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <cstdio>
+
+using namespace GraphTheory;
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    KLocalizedString::setApplicationDomain("rocs");
+
+    KAboutData aboutData("rocs-batch",
+                         ki18nc("@title Displayed program name", "Rocs Batch Runner").toString(),
+                         ROCS_VERSION_STRING);
+    aboutData.addLicense(KAboutLicense::GPL_V2);
+    aboutData.setShortDescription(ki18nc("@title Short program description",
+                                         "Runs scripts on graph files and converts graph files without user interface").toString());
+    KAboutData::setApplicationData(aboutData);
+
+    QCommandLineParser parser;
+    aboutData.setupCommandLine(&parser);
+    parser.setApplicationDescription(aboutData.shortDescription());
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    parser.addPositionalArgument(QStringLiteral("files"), i18n("Graph files to process."), QStringLiteral("file..."));
+    QCommandLineOption scriptOption(QStringList() << QStringLiteral("s") << QStringLiteral("script"),
+        i18n("Execute the script <file> on every graph. A graph fails if the script reports an error."),
+        QStringLiteral("file"));
+    QCommandLineOption formatOption(QStringList() << QStringLiteral("f") << QStringLiteral("format"),
+        i18n("Write every graph in the file format with extension <extension>."),
+        QStringLiteral("extension"));
+    QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output-directory"),
+        i18n("Write files to <directory> instead of the current directory."),
+        QStringLiteral("directory"));
+    QCommandLineOption jobsOption(QStringList() << QStringLiteral("j") << QStringLiteral("jobs"),
+        i18n("Process up to <number> files in parallel, by default one per processor core."),
+        QStringLiteral("number"), QString::number(QThread::idealThreadCount()));
+    QCommandLineOption profileOption(QStringLiteral("profile"),
+        i18n("Print the time spent per script line and per script API call."));
+    parser.addOption(scriptOption);
+    parser.addOption(formatOption);
+    parser.addOption(outputOption);
+    parser.addOption(jobsOption);
+    parser.addOption(profileOption);
+
+    parser.process(app);
+    aboutData.processCommandLine(&parser);
+
+    QTextStream err(stderr);
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty() || (!parser.isSet(scriptOption) && !parser.isSet(formatOption))) {
+        err << i18nc("@info:shell", "Specify graph files and a script or an export format.") << endl;
+        parser.showHelp(1);
+    }
+
+    BatchJob::Options options;
+    options.profile = parser.isSet(profileOption);
+    if (parser.isSet(scriptOption)) {
+        QFile scriptFile(parser.value(scriptOption));
+        if (!scriptFile.open(QIODevice::ReadOnly)) {
+            err << i18nc("@info:shell", "Could not open script file %1.", scriptFile.fileName()) << endl;
+            return 1;
+        }
+        options.script = QString::fromUtf8(scriptFile.readAll());
+    }
+    if (parser.isSet(formatOption)) {
+        // validate the export backend once, instead of failing for every file
+        FileFormatManager manager;
+        const QString format = parser.value(formatOption);
+        FileFormatInterface *exporter = manager.backendByExtension(format);
+        if (!exporter || exporter->pluginCapability() == FileFormatInterface::ImportOnly) {
+            err << i18nc("@info:shell", "No file format backend can write files with extension %1.", format) << endl;
+            return 1;
+        }
+        options.format = format;
+    }
+    options.outputDirectory = QDir(parser.value(outputOption));
+    if (!options.outputDirectory.exists() && !options.outputDirectory.mkpath(QStringLiteral("."))) {
+        err << i18nc("@info:shell", "Could not create output directory %1.", options.outputDirectory.path()) << endl;
+        return 1;
+    }
+    if (!options.format.isEmpty()) {
+        // jobs run in parallel, hence two of them must never write the same file
+        QHash<QString, QString> outputFiles;
+        foreach (const QString &file, files) {
+            const QString path = BatchJob::outputPath(file, options);
+            if (outputFiles.contains(path)) {
+                err << i18nc("@info:shell", "Files %1 and %2 would both be written to %3.", outputFiles.value(path), file, path) << endl;
+                return 1;
+            }
+            outputFiles.insert(path, file);
+        }
+    }
+    bool ok = false;
+    const int jobs = parser.value(jobsOption).toInt(&ok);
+    if (!ok || jobs < 1) {
+        err << i18nc("@info:shell", "Invalid number of jobs: %1", parser.value(jobsOption)) << endl;
+        return 1;
+    }
+
+    QAtomicInt failures;
+    {
+        // every pool thread loads its own backends and releases them when the pool is destroyed
+        QThreadPool pool;
+        pool.setMaxThreadCount(jobs);
+        foreach (const QString &file, files) {
+            pool.start(new BatchJob(file, options, &failures));
+        }
+        pool.waitForDone();
+    }
+
+    return failures.load() > 0 ? 1 : 0;
+}
@@ -23,6 +23,7 @@
 #include <KTextEditor/View>
 #include <KTextEditor/Editor>
 #include <KTextEditor/Document>
+#include <KTextEditor/MarkInterface>
 #include <KLocalizedString>
 #include <QInputDialog>
 #include <QLineEdit>
@@ -46,6 +47,11 @@ CodeEditorWidget::CodeEditorWidget(QWidget *parent)
     setLayout(layout);
 
     connect(m_viewWidgets, &QTabWidget::tabBarDoubleClicked, this, &CodeEditorWidget::showDocumentNameDialog);
+
+    m_editingTimer.setSingleShot(true);
+    m_editingTimer.setInterval(750);
+    connect(m_viewWidgets, &QTabWidget::currentChanged, &m_editingTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(&m_editingTimer, &QTimer::timeout, this, &CodeEditorWidget::editingPaused);
 }
 
 void CodeEditorWidget::setProject(Project *project)
@@ -65,6 +71,7 @@ void CodeEditorWidget::setProject(Project *project)
     for (int index = 0; index < m_project->codeDocuments().count(); ++index) {
         KTextEditor::Document *document = m_project->codeDocuments().at(index);
         m_viewWidgets->insertTab(index, document->createView(this), project->documentName(document));
+        connect(document, &KTextEditor::Document::textChanged, &m_editingTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
     }
 }
 
@@ -73,9 +80,36 @@ KTextEditor::Document * CodeEditorWidget::activeDocument() const
     return m_project->codeDocuments().at(m_viewWidgets->currentIndex());
 }
 
+void CodeEditorWidget::showSyntaxCheckResult(bool valid, int errorLine, const QString &errorMessage)
+{
+    if (!m_project || m_viewWidgets->currentIndex() < 0) {
+        return;
+    }
+    KTextEditor::MarkInterface *marks = qobject_cast<KTextEditor::MarkInterface*>(activeDocument());
+    if (!marks) {
+        return;
+    }
+    QList<int> markedLines;
+    foreach (KTextEditor::Mark *mark, marks->marks()) {
+        if (mark->type & KTextEditor::MarkInterface::Error) {
+            markedLines.append(mark->line);
+        }
+    }
+    foreach (int line, markedLines) {
+        marks->removeMark(line, KTextEditor::MarkInterface::Error);
+    }
+    if (valid || errorLine < 1) {
+        return;
+    }
+    marks->setMarkDescription(KTextEditor::MarkInterface::Error, i18nc("@info:tooltip", "Syntax error: %1", errorMessage));
+    // mark lines are zero based, script lines start at one
+    marks->addMark(errorLine - 1, KTextEditor::MarkInterface::Error);
+}
+
 void CodeEditorWidget::onCodeDocumentAboutToBeAdded(KTextEditor::Document* document, int index)
 {
     m_viewWidgets->insertTab(index, document->createView(this), m_project->documentName(document));
+    connect(document, &KTextEditor::Document::textChanged, &m_editingTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
 }
 
 void CodeEditorWidget::onCodeDocumentAboutToBeRemoved(int start, int end)
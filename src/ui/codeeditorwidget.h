@@ -21,6 +21,7 @@
 #ifndef CODEEDITORWIDGET_H
 #define CODEEDITORWIDGET_H
 
+#include <QTimer>
 #include <QWidget>
 #include "project/project.h"
 
@@ -40,8 +41,20 @@ public:
     void setProject(Project *project);
     KTextEditor::Document *activeDocument() const;
 
+public Q_SLOTS:
+    /**
+     * Mark line @p errorLine of the active document as erroneous, described by @p errorMessage.
+     * If @p valid is true, previous marks are removed.
+     */
+    void showSyntaxCheckResult(bool valid, int errorLine, const QString &errorMessage);
+
 Q_SIGNALS:
     void activeDocumentChanged(int index);
+    /**
+     * The active document was changed or another document was activated, and no further
+     * changes followed for a moment.
+     */
+    void editingPaused();
 
 private Q_SLOTS:
     void onCodeDocumentAboutToBeAdded(KTextEditor::Document *document, int index);
@@ -52,6 +65,7 @@ private:
     QTabWidget *m_viewWidgets;
     KTextEditor::Editor *m_editor;
     Project *m_project; //!< current project
+    QTimer m_editingTimer; //!< restarted with every change of the code documents
 };
 
 #endif
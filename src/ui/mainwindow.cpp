@@ -89,6 +89,13 @@ MainWindow::MainWindow()
 
     // setup kernel
     connect(m_kernel, &Kernel::message, m_outputWidget, &ScriptOutputWidget::processMessage);
+    connect(m_kernel, &Kernel::executionFinished, this, &MainWindow::disableStopAction);
+
+    // check scripts for syntax errors while the user pauses typing
+    connect(m_codeEditorWidget, &CodeEditorWidget::editingPaused, this, [=]() {
+        m_kernel->checkSyntax(m_codeEditorWidget->activeDocument()->text());
+    });
+    connect(m_kernel, &Kernel::syntaxChecked, m_codeEditorWidget, &CodeEditorWidget::showSyntaxCheckResult);
 
     // TODO: use welcome widget instead of creating default empty project
     createProject();
@@ -184,14 +191,20 @@ QWidget* MainWindow::setupScriptPanel()
     m_stopScript = new QAction(QIcon::fromTheme("process-stop"), i18nc("@action:intoolbar Script Execution", "Stop"), this);
     m_stopScript->setToolTip(i18nc("@info:tooltip", "Stop script execution."));
     m_stopScript->setEnabled(false);
+    m_profileScript = new QAction(QIcon::fromTheme("chronometer"), i18nc("@action:intoolbar Script Execution", "Profile"), this);
+    m_profileScript->setToolTip(i18nc("@info:tooltip", "Report the time spent per script line and per script API call after script execution."));
+    m_profileScript->setCheckable(true);
     executeCommands->addAction(m_runScript);
     executeCommands->addAction(m_stopScript);
+    executeCommands->addAction(m_profileScript);
     // add actions to action collection to be able to set shortcuts on them in the ui
     actionCollection()->addAction("_runScript", m_runScript);
     actionCollection()->addAction("_stopScript", m_stopScript);
+    actionCollection()->addAction("_profileScript", m_profileScript);
 
     connect(m_runScript, &QAction::triggered, this, &MainWindow::executeScript);
     connect(m_stopScript, &QAction::triggered, this, &MainWindow::stopScript);
+    connect(m_profileScript, &QAction::toggled, m_kernel, &Kernel::setProfilingEnabled);
 
     m_hScriptSplitter->addWidget(m_codeEditorWidget);
     m_hScriptSplitter->addWidget(m_outputWidget);
@@ -559,12 +572,16 @@ void MainWindow::showEditorPluginDialog()
 
 void MainWindow::executeScript()
 {
+    // the output of a running script must be kept
+    if (m_kernel->isRunning()) {
+        return;
+    }
     if (m_outputWidget->isOutputClearEnabled()) {
         m_outputWidget->clear();
     }
     QString script = m_codeEditorWidget->activeDocument()->text();
     enableStopAction();
-    m_kernel->execute(m_currentProject->activeGraphDocument(), script);
+    m_kernel->start(m_currentProject->activeGraphDocument(), script);
 }
 
 void MainWindow::stopScript()
@@ -155,6 +155,7 @@ private:
     // Other Bunch of stuff.
     QAction *m_runScript;
     QAction *m_stopScript;
+    QAction *m_profileScript;
 
     ///Store the recent files.
     KRecentFilesAction *m_recentProjects;